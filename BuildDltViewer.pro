@@ -1,5 +1,5 @@
 #
 TEMPLATE = subdirs
 CONFIG   += ordered
-SUBDIRS  += qdlt src plugin
+SUBDIRS  += qdlt src plugin bench cli
 CONFIG += c++11
@@ -0,0 +1,346 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file dltbenchgenerator.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <cstring>
+
+#include <QFile>
+#include <QStringList>
+#include <QtEndian>
+
+#include "dltbenchgenerator.h"
+#include "qdlt.h"
+#include "dlt_common.h"
+
+static const char *const apids[] = { "APP1", "NAV", "HMI", "DIAG" };
+static const char *const ctids[] = { "CON1", "MAIN", "NET", "GPS" };
+static const char *const words[] = { "init", "request", "received", "timeout", "value", "state", "changed",
+                                     "connection", "buffer", "update", "error", "position", "speed", "done" };
+
+DltBenchGenerator::DltBenchGenerator(quint32 seed)
+{
+    this->seed = seed;
+    state = seed;
+    setMix(70, 20, 5, 5);
+    num = 0;
+    handle = 0;
+    countVerbose = 0;
+    countNonVerbose = 0;
+    countControl = 0;
+    countSegmented = 0;
+}
+
+void DltBenchGenerator::setMix(int verbose, int nonVerbose, int control, int segmented)
+{
+    mixVerbose = qMax(verbose, 0);
+    mixNonVerbose = qMax(nonVerbose, 0);
+    mixControl = qMax(control, 0);
+    mixSegmented = qMax(segmented, 0);
+
+    if(mixVerbose + mixNonVerbose + mixControl + mixSegmented == 0)
+        mixVerbose = 1;
+}
+
+bool DltBenchGenerator::setMix(const QString &mix)
+{
+    int verbose = 0, nonVerbose = 0, control = 0, segmented = 0;
+
+    QStringList parts = mix.split(',', QString::SkipEmptyParts);
+    for(int i = 0; i < parts.size(); i++)
+    {
+        QStringList pair = parts[i].split('=');
+        bool ok = false;
+        int value = pair.size() == 2 ? pair[1].toInt(&ok) : 0;
+        if(!ok || value < 0)
+            return false;
+
+        if(pair[0] == "verbose")
+            verbose = value;
+        else if(pair[0] == "nonverbose")
+            nonVerbose = value;
+        else if(pair[0] == "control")
+            control = value;
+        else if(pair[0] == "segmented")
+            segmented = value;
+        else
+            return false;
+    }
+
+    setMix(verbose, nonVerbose, control, segmented);
+    return true;
+}
+
+QString DltBenchGenerator::getMix() const
+{
+    return QString("verbose=%1,nonverbose=%2,control=%3,segmented=%4").arg(mixVerbose).arg(mixNonVerbose).arg(mixControl).arg(mixSegmented);
+}
+
+QByteArray DltBenchGenerator::generate(qint64 size)
+{
+    QByteArray trace;
+    trace.reserve(size + 64 * 1024);
+
+    state = seed;
+    num = 0;
+    handle = 0;
+    countVerbose = 0;
+    countNonVerbose = 0;
+    countControl = 0;
+    countSegmented = 0;
+
+    int total = mixVerbose + mixNonVerbose + mixControl + mixSegmented;
+    while(trace.size() < size)
+    {
+        int kind = random() % total;
+        if(kind < mixVerbose)
+            appendVerbose(trace);
+        else if((kind -= mixVerbose) < mixNonVerbose)
+            appendNonVerbose(trace);
+        else if((kind -= mixNonVerbose) < mixControl)
+            appendControl(trace);
+        else
+            appendSegmented(trace);
+    }
+
+    return trace;
+}
+
+bool DltBenchGenerator::writeFile(const QString &fileName, qint64 size)
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    QByteArray trace = generate(size);
+    return file.write(trace) == trace.size();
+}
+
+quint32 DltBenchGenerator::random()
+{
+    /* linear congruential generator, the same on all platforms */
+    state = state * 1103515245u + 12345u;
+    return (state >> 16) & 0x7fff;
+}
+
+/* The time advances with the message number, so traces do not depend on the current time */
+static void setMsgTime(QDltMsg &msg, int num)
+{
+    msg.setTime(1500000000 + num / 1000);
+    msg.setMicroseconds((num % 1000) * 1000);
+    msg.setTimestamp(num * 10);
+    msg.setMessageCounter(num % 256);
+    msg.setEcuid("ECU1");
+}
+
+static void addArgument(QDltMsg &msg, QDltArgument::DltTypeInfoDef typeInfo, const QByteArray &data)
+{
+    QDltArgument argument;
+
+    argument.setEndianness(QDltArgument::DltEndiannessLittleEndian);
+    argument.setTypeInfo(typeInfo);
+    argument.setData(data);
+    msg.addArgument(argument);
+}
+
+void DltBenchGenerator::appendVerbose(QByteArray &trace)
+{
+    QDltMsg msg;
+    QByteArray buf;
+
+    setMsgTime(msg, num++);
+    msg.setApid(apids[random() % 4]);
+    msg.setCtid(ctids[random() % 4]);
+    msg.setSessionid(1234);
+    msg.setType(QDltMsg::DltTypeLog);
+    msg.setSubtype(1 + random() % 6);
+    msg.setMode(QDltMsg::DltModeVerbose);
+    msg.setEndianness(QDltMsg::DltEndiannessLittleEndian);
+
+    /* text with a varying number of words */
+    QByteArray text;
+    int count = 2 + random() % 10;
+    for(int i = 0; i < count; i++)
+    {
+        if(i)
+            text += ' ';
+        text += words[random() % 14];
+    }
+    addArgument(msg, QDltArgument::DltTypeInfoStrg, text);
+
+    /* numeric arguments */
+    int args = random() % 4;
+    for(int i = 0; i < args; i++)
+    {
+        switch(random() % 3)
+        {
+        case 0:
+        {
+            qint32 value = (qint32) random() - 16384;
+            addArgument(msg, QDltArgument::DltTypeInfoSInt, QByteArray((const char*) &value, sizeof(value)));
+            break;
+        }
+        case 1:
+        {
+            quint64 value = ((quint64) random() << 32) | random();
+            addArgument(msg, QDltArgument::DltTypeInfoUInt, QByteArray((const char*) &value, sizeof(value)));
+            break;
+        }
+        default:
+        {
+            double value = random() / 3.0;
+            addArgument(msg, QDltArgument::DltTypeInfoFloa, QByteArray((const char*) &value, sizeof(value)));
+            break;
+        }
+        }
+    }
+    msg.setNumberOfArguments(msg.sizeArguments());
+
+    msg.getMsg(buf, true);
+    trace += buf;
+    countVerbose++;
+}
+
+void DltBenchGenerator::appendNonVerbose(QByteArray &trace)
+{
+    QDltMsg msg;
+    QByteArray buf;
+
+    setMsgTime(msg, num++);
+    msg.setMode(QDltMsg::DltModeNonVerbose);
+    msg.setEndianness(QDltMsg::DltEndiannessLittleEndian);
+
+    /* message id followed by the static data of the message */
+    quint32 messageId = 1000 + random() % 200;
+    addArgument(msg, QDltArgument::DltTypeInfoUInt, QByteArray((const char*) &messageId, sizeof(messageId)));
+    QByteArray data(4 + random() % 60, 0);
+    for(int i = 0; i < data.size(); i++)
+        data[i] = (char) random();
+    addArgument(msg, QDltArgument::DltTypeInfoRawd, data);
+    msg.setNumberOfArguments(msg.sizeArguments());
+
+    msg.getMsg(buf, true);
+    trace += buf;
+    countNonVerbose++;
+}
+
+void DltBenchGenerator::appendStorageHeader(QByteArray &trace)
+{
+    DltStorageHeader storageheader;
+    int msgNum = num++;
+
+    storageheader.pattern[0] = 'D';
+    storageheader.pattern[1] = 'L';
+    storageheader.pattern[2] = 'T';
+    storageheader.pattern[3] = 0x01;
+    storageheader.seconds = 1500000000 + msgNum / 1000;
+    storageheader.microseconds = (msgNum % 1000) * 1000;
+    memcpy(storageheader.ecu, "ECU1", DLT_ID_SIZE);
+    trace.append((const char *) &storageheader, sizeof(storageheader));
+}
+
+void DltBenchGenerator::appendControl(QByteArray &trace)
+{
+    /* get software version response, QDltMsg::getMsg() writes no extended header for non-verbose messages */
+    static const char version[] = "Benchmark ECU Software Version 1.0";
+    QByteArray payload;
+    quint32 serviceId = qToLittleEndian<quint32>(DLT_SERVICE_ID_GET_SOFTWARE_VERSION);
+    quint32 length = qToLittleEndian<quint32>(sizeof(version) - 1);
+    payload.append((const char *) &serviceId, sizeof(serviceId));
+    payload.append((char) 0); /* status ok */
+    payload.append((const char *) &length, sizeof(length));
+    payload.append(version, sizeof(version) - 1);
+
+    int msgNum = num;
+    appendStorageHeader(trace);
+
+    DltStandardHeader standardheader;
+    standardheader.htyp = DLT_HTYP_PROTOCOL_VERSION1 | DLT_HTYP_UEH | DLT_HTYP_WEID | DLT_HTYP_WTMS;
+    standardheader.mcnt = msgNum % 256;
+    standardheader.len = qToBigEndian<quint16>(sizeof(DltStandardHeader) + DLT_ID_SIZE + sizeof(quint32) + sizeof(DltExtendedHeader) + payload.size());
+    trace.append((const char *) &standardheader, sizeof(standardheader));
+
+    trace.append("ECU1", DLT_ID_SIZE);
+    quint32 timestamp = qToBigEndian<quint32>(msgNum * 10);
+    trace.append((const char *) &timestamp, sizeof(timestamp));
+
+    DltExtendedHeader extendedheader;
+    extendedheader.msin = (DLT_TYPE_CONTROL << DLT_MSIN_MSTP_SHIFT) | (DLT_CONTROL_RESPONSE << DLT_MSIN_MTIN_SHIFT);
+    extendedheader.noar = 0;
+    memcpy(extendedheader.apid, "DA1\0", DLT_ID_SIZE);
+    memcpy(extendedheader.ctid, "DC1\0", DLT_ID_SIZE);
+    trace.append((const char *) &extendedheader, sizeof(extendedheader));
+
+    trace += payload;
+    countControl++;
+}
+
+void DltBenchGenerator::appendSegmented(QByteArray &trace)
+{
+    QDltMsg msg;
+    QByteArray buf;
+    const quint32 chunkSize = 1024;
+    quint32 chunks = 1 + random() % 4;
+    quint32 size = chunks * chunkSize;
+    handle++;
+
+    /* start message: handle, header, size, number of chunks, chunk size */
+    setMsgTime(msg, num++);
+    msg.setApid("DBUS");
+    msg.setCtid("DBUS");
+    msg.setSessionid(1234);
+    msg.setType(QDltMsg::DltTypeNwTrace);
+    msg.setSubtype(QDltMsg::DltNetworkTraceIpc);
+    msg.setMode(QDltMsg::DltModeVerbose);
+    msg.setEndianness(QDltMsg::DltEndiannessLittleEndian);
+    addArgument(msg, QDltArgument::DltTypeInfoStrg, "NWST");
+    addArgument(msg, QDltArgument::DltTypeInfoUInt, QByteArray((const char*) &handle, sizeof(handle)));
+    addArgument(msg, QDltArgument::DltTypeInfoRawd, QByteArray(16, 0x11));
+    addArgument(msg, QDltArgument::DltTypeInfoUInt, QByteArray((const char*) &size, sizeof(size)));
+    addArgument(msg, QDltArgument::DltTypeInfoUInt, QByteArray((const char*) &chunks, sizeof(chunks)));
+    addArgument(msg, QDltArgument::DltTypeInfoUInt, QByteArray((const char*) &chunkSize, sizeof(chunkSize)));
+    msg.setNumberOfArguments(msg.sizeArguments());
+    msg.getMsg(buf, true);
+    trace += buf;
+
+    /* chunk messages: handle, sequence, data */
+    for(quint32 sequence = 0; sequence < chunks; sequence++)
+    {
+        msg.clearArguments();
+        setMsgTime(msg, num++);
+        addArgument(msg, QDltArgument::DltTypeInfoStrg, "NWCH");
+        addArgument(msg, QDltArgument::DltTypeInfoUInt, QByteArray((const char*) &handle, sizeof(handle)));
+        addArgument(msg, QDltArgument::DltTypeInfoUInt, QByteArray((const char*) &sequence, sizeof(sequence)));
+        addArgument(msg, QDltArgument::DltTypeInfoRawd, QByteArray(chunkSize, (char) random()));
+        msg.setNumberOfArguments(msg.sizeArguments());
+        msg.getMsg(buf, true);
+        trace += buf;
+    }
+
+    /* end message: handle */
+    msg.clearArguments();
+    setMsgTime(msg, num++);
+    addArgument(msg, QDltArgument::DltTypeInfoStrg, "NWEN");
+    addArgument(msg, QDltArgument::DltTypeInfoUInt, QByteArray((const char*) &handle, sizeof(handle)));
+    msg.setNumberOfArguments(msg.sizeArguments());
+    msg.getMsg(buf, true);
+    trace += buf;
+
+    countSegmented += chunks + 2;
+}
@@ -0,0 +1,86 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file dltbenchgenerator.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef DLTBENCHGENERATOR_H
+#define DLTBENCHGENERATOR_H
+
+#include <QByteArray>
+#include <QString>
+
+/* Deterministic generator of DLT traces with storage headers.
+ * The same seed, mix and size always create the same trace, so benchmark
+ * results of different builds can be compared. The mix is given in parts of
+ * verbose log messages, non-verbose messages, control responses and
+ * segmented network trace messages (NWST, NWCH..., NWEN as used by the DBus plugin).
+ */
+class DltBenchGenerator
+{
+public:
+    DltBenchGenerator(quint32 seed = 1);
+
+    /* set the parts of the message kinds, e.g. 70, 20, 5, 5 */
+    void setMix(int verbose, int nonVerbose, int control, int segmented);
+
+    /* set the mix from a string like "verbose=70,nonverbose=20,control=5,segmented=5" */
+    bool setMix(const QString &mix);
+
+    /* get the mix as string in the format accepted by setMix() */
+    QString getMix() const;
+
+    /* create a trace of at least size bytes */
+    QByteArray generate(qint64 size);
+
+    /* write a trace of at least size bytes to a file */
+    bool writeFile(const QString &fileName, qint64 size);
+
+    /* number of messages of each kind created by the last call */
+    int getVerbose() const { return countVerbose; }
+    int getNonVerbose() const { return countNonVerbose; }
+    int getControl() const { return countControl; }
+    int getSegmented() const { return countSegmented; }
+    int getMessages() const { return countVerbose + countNonVerbose + countControl + countSegmented; }
+
+private:
+    quint32 random();
+
+    void appendVerbose(QByteArray &trace);
+    void appendNonVerbose(QByteArray &trace);
+    void appendControl(QByteArray &trace);
+    void appendSegmented(QByteArray &trace);
+    void appendStorageHeader(QByteArray &trace);
+
+    quint32 seed;
+    quint32 state;
+    int mixVerbose;
+    int mixNonVerbose;
+    int mixControl;
+    int mixSegmented;
+
+    int num;
+    quint32 handle;
+
+    int countVerbose;
+    int countNonVerbose;
+    int countControl;
+    int countSegmented;
+};
+
+#endif // DLTBENCHGENERATOR_H
@@ -0,0 +1,747 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file main.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QApplication>
+#include <QStringList>
+#include <QElapsedTimer>
+#include <QTextStream>
+#include <QVector>
+#include <QFile>
+#include <QScopedPointer>
+#include <QAbstractTableModel>
+#include <QTableView>
+#include <QTemporaryFile>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <ctime>
+
+#include "qdlt.h"
+#include "dlt_common.h"
+#include "dltbenchgenerator.h"
+
+static QTextStream out(stdout);
+
+/* results of all benchmarks, written as JSON at the end */
+static QJsonArray results;
+
+/* no text output, if the JSON result is written to stdout */
+static bool quiet = false;
+
+static void report(const QString &name, int count, qint64 nsecs, qint64 bytes = 0)
+{
+    double msecs = nsecs / 1000000.0;
+    double rate = nsecs > 0 ? count * 1000000000.0 / nsecs : 0;
+    double bytesRate = nsecs > 0 ? bytes * 1000000000.0 / nsecs : 0;
+
+    QJsonObject result;
+    result["name"] = name;
+    result["count"] = count;
+    result["nsecs"] = nsecs;
+    result["msgsPerSecond"] = rate;
+    if(bytes > 0)
+    {
+        result["bytes"] = bytes;
+        result["bytesPerSecond"] = bytesRate;
+    }
+    results.append(result);
+
+    if(quiet)
+        return;
+
+    out << name << ": " << count << " msgs in " << QString::number(msecs, 'f', 1) << " ms, "
+        << QString::number(rate, 'f', 0) << " msgs/s";
+    if(bytes > 0)
+        out << ", " << QString::number(bytesRate / 1000000.0, 'f', 1) << " MB/s";
+    out << endl;
+}
+
+/* Add a value to the result of the last benchmark */
+static void reportValue(const QString &key, double value)
+{
+    QJsonObject result = results.last().toObject();
+    result[key] = value;
+    results.replace(results.size() - 1, result);
+}
+
+/* Find the messages by the DLT markers as QDltFile does when a log file is opened */
+static void benchIndex(QDltFile &file, const QString &fileName, qint64 fileSize, int rounds)
+{
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+
+    for(int round = 0; round < rounds; round++)
+    {
+        file.open(fileName);
+        timer.start();
+        file.createIndex();
+        nsecs += timer.nsecsElapsed();
+    }
+
+    report("index", file.size() * rounds, nsecs, fileSize * rounds);
+}
+
+/* Parse the headers and arguments of the raw messages */
+static void benchSetMsg(const QVector<QByteArray> &bufs, int rounds)
+{
+    QElapsedTimer timer;
+    QDltMsg msg;
+    qint64 bytes = 0;
+    int valid = 0;
+
+    for(int num = 0; num < bufs.size(); num++)
+        bytes += bufs[num].size();
+
+    timer.start();
+    for(int round = 0; round < rounds; round++)
+        for(int num = 0; num < bufs.size(); num++)
+            if(msg.setMsg(bufs[num]))
+                valid++;
+    report("setmsg", bufs.size() * rounds, timer.nsecsElapsed(), bytes * rounds);
+
+    if(valid == 0)
+        out << "no valid message" << endl;
+}
+
+/* Access and convert the arguments of the messages as the table and the search do */
+static void benchArguments(const QVector<QDltMsg> &msgs, int rounds)
+{
+    QElapsedTimer timer;
+    QDltArgument argument;
+    qint64 length = 0;
+
+    timer.start();
+    for(int round = 0; round < rounds; round++)
+        for(int num = 0; num < msgs.size(); num++)
+            for(int arg = 0; arg < msgs[num].sizeArguments(); arg++)
+                if(msgs[num].getArgument(arg, argument))
+                    length += argument.toString().size();
+    report("arguments", msgs.size() * rounds, timer.nsecsElapsed());
+
+    if(length == 0)
+        out << "no output" << endl;
+}
+
+/* Check the messages against a typical set of filters and markers */
+static void benchFilter(const QVector<QDltMsg> &msgs, int rounds)
+{
+    QElapsedTimer timer;
+    QDltFilterList filterList;
+    QDltFilter *filter;
+    int matches = 0;
+
+    filter = new QDltFilter();
+    filter->type = QDltFilter::positive;
+    filter->enableFilter = true;
+    filter->enableApid = true;
+    filter->apid = "APP1";
+    filterList.addFilter(filter);
+
+    filter = new QDltFilter();
+    filter->type = QDltFilter::positive;
+    filter->enableFilter = true;
+    filter->enableApid = true;
+    filter->apid = "NAV";
+    filter->enableCtid = true;
+    filter->ctid = "GPS";
+    filterList.addFilter(filter);
+
+    filter = new QDltFilter();
+    filter->type = QDltFilter::negative;
+    filter->enableFilter = true;
+    filter->enablePayload = true;
+    filter->enableRegexp_Payload = true;
+    filter->payload = "timeout|error";
+    filter->compileRegexps();
+    filterList.addFilter(filter);
+
+    filter = new QDltFilter();
+    filter->type = QDltFilter::marker;
+    filter->enableFilter = true;
+    filter->enablePayload = true;
+    filter->payload = "state changed";
+    filter->filterColour = "#00ff00";
+    filterList.addFilter(filter);
+
+    filterList.updateSortedFilter();
+
+    /* checkFilter() needs a non const message */
+    QVector<QDltMsg> work = msgs;
+    work.detach();
+
+    timer.start();
+    for(int round = 0; round < rounds; round++)
+        for(int num = 0; num < work.size(); num++)
+            if(filterList.checkFilter(work[num]))
+                matches++;
+    report("filter", work.size() * rounds, timer.nsecsElapsed());
+
+    if(matches == 0)
+        out << "no message matches" << endl;
+}
+
+/* Decode the messages with the enabled decoder plugins */
+static void benchDecoders(const QVector<QDltMsg> &msgs, QDltPluginManager &pluginManager, int rounds)
+{
+    QElapsedTimer timer;
+    QDltMsg msg;
+    int decoded = 0;
+
+    timer.start();
+    for(int round = 0; round < rounds; round++)
+        for(int num = 0; num < msgs.size(); num++)
+        {
+            msg = msgs[num];
+            if(pluginManager.decodeMsg(msg, 0))
+                decoded++;
+        }
+    report("decode", msgs.size() * rounds, timer.nsecsElapsed());
+
+    if(!quiet)
+        out << "decode: " << decoded / qMax(rounds, 1) << " msgs decoded" << endl;
+    reportValue("decoded", decoded / qMax(rounds, 1));
+}
+
+/* Format the messages as the ASCII and CSV export do */
+static void benchExport(const QVector<QDltMsg> &msgs, const QVector<QByteArray> &bufs, QDltExportFormatter::Format format, const QString &name, int rounds)
+{
+    QElapsedTimer timer;
+    QDltExportFormatter formatter(format);
+    QByteArray output;
+    qint64 bytes = 0;
+
+    QVector<QDltMsg> work = msgs;
+    work.detach();
+    QVector<QByteArray> workBufs = bufs;
+
+    timer.start();
+    for(int round = 0; round < rounds; round++)
+        for(int num = 0; num < work.size(); num++)
+        {
+            output.resize(0);
+            formatter.formatMsg(num, work[num], workBufs[num], output);
+            bytes += output.size();
+        }
+    report(name, work.size() * rounds, timer.nsecsElapsed(), bytes);
+}
+
+/* Format header and payload of messages as the ASCII export does */
+static void benchFormat(const QVector<QDltMsg> &msgs, int rounds)
+{
+    QElapsedTimer timer;
+    qint64 length = 0;
+
+    /* string API, one new string per call */
+    timer.start();
+    for(int round = 0; round < rounds; round++)
+        for(int num = 0; num < msgs.size(); num++)
+        {
+            QString text = QString("%1 ").arg(num) + msgs[num].toStringHeader() + " " + msgs[num].toStringPayload().simplified() + "\n";
+            length += text.size();
+        }
+    report("format-string", msgs.size() * rounds, timer.nsecsElapsed());
+
+    /* buffer API, the buffers are reused for all messages */
+    QString text;
+    QString payload;
+    timer.start();
+    for(int round = 0; round < rounds; round++)
+        for(int num = 0; num < msgs.size(); num++)
+        {
+            text.resize(0);
+            QDltTextWriter::appendInt(text, num);
+            text += QLatin1Char(' ');
+            msgs[num].toStringHeader(text);
+            text += QLatin1Char(' ');
+            payload.resize(0);
+            msgs[num].toStringPayload(payload);
+            QDltTextWriter::appendSimplified(text, payload);
+            text += QLatin1Char('\n');
+            length += text.size();
+        }
+    report("format-buffer", msgs.size() * rounds, timer.nsecsElapsed());
+
+    /* payload as CSV value */
+    timer.start();
+    for(int round = 0; round < rounds; round++)
+        for(int num = 0; num < msgs.size(); num++)
+        {
+            text.resize(0);
+            payload.resize(0);
+            msgs[num].toStringPayload(payload);
+            QDltTextWriter::appendCSVValue(text, payload, true);
+            length += text.size();
+        }
+    report("format-csv-payload", msgs.size() * rounds, timer.nsecsElapsed());
+
+    /* use the result, so the compiler cannot remove the loops */
+    if(length == 0)
+        out << "no output" << endl;
+}
+
+/* Convert the storage header time as the table and the exporter do */
+static void benchTime(const QVector<QDltMsg> &msgs, int rounds)
+{
+    QElapsedTimer timer;
+    qint64 length = 0;
+
+    timer.start();
+    for(int round = 0; round < rounds; round++)
+        for(int num = 0; num < msgs.size(); num++)
+            length += msgs[num].getTimeString().size();
+    report("time-local", msgs.size() * rounds, timer.nsecsElapsed());
+
+    timer.start();
+    for(int round = 0; round < rounds; round++)
+        for(int num = 0; num < msgs.size(); num++)
+            length += QDltTimeCache::gmTimeWithOffsetString(msgs[num].getTime(), 3600, true).size();
+    report("time-utc-offset", msgs.size() * rounds, timer.nsecsElapsed());
+
+    if(length == 0)
+        out << "no output" << endl;
+}
+
+/* Compress the trace in blocks as the compressed recording does, the CPU time includes all threads */
+static void benchCompress(const QByteArray &data, int count, int rounds)
+{
+    QElapsedTimer timer;
+    const int levels[] = { 1, 6, 9 };
+
+    for(unsigned int level = 0; level < sizeof(levels) / sizeof(levels[0]); level++)
+    {
+        QByteArray member;
+        qint64 compressed = 0;
+
+        std::clock_t cpu = std::clock();
+        timer.start();
+        for(int round = 0; round < rounds; round++)
+            for(int pos = 0; pos < data.size(); pos += QDLT_COMPRESSED_WRITER_BLOCK_SIZE)
+            {
+                QByteArray block = QByteArray::fromRawData(data.constData() + pos, qMin(QDLT_COMPRESSED_WRITER_BLOCK_SIZE, data.size() - pos));
+                if(!QDltCompressedWriter::compressBlock(block, member, levels[level]))
+                {
+                    if(!quiet)
+                        out << "compress: not supported by this build" << endl;
+                    return;
+                }
+                compressed += member.size();
+            }
+        qint64 nsecs = timer.nsecsElapsed();
+        double cpuNsecs = (std::clock() - cpu) * 1000000000.0 / CLOCKS_PER_SEC;
+
+        report(QString("compress-level%1").arg(levels[level]), count * rounds, nsecs, data.size() * (qint64) rounds);
+        reportValue("ratio", compressed > 0 ? (double) data.size() * rounds / compressed : 0);
+        reportValue("cpuPercent", nsecs > 0 ? cpuNsecs * 100.0 / nsecs : 0);
+    }
+
+    /* complete recording through the writer thread in messages of about 1 kB */
+    QTemporaryFile file;
+    if(!file.open())
+        return;
+    QString fileName = file.fileName();
+    file.close();
+
+    QDltCompressedWriter writer;
+    std::clock_t cpu = std::clock();
+    timer.start();
+    if(!writer.open(fileName))
+        return;
+    for(int pos = 0; pos < data.size(); pos += 1024)
+        writer.write(data.constData() + pos, qMin(1024, data.size() - pos));
+    writer.close();
+    qint64 nsecs = timer.nsecsElapsed();
+    double cpuNsecs = (std::clock() - cpu) * 1000000000.0 / CLOCKS_PER_SEC;
+
+    report("compress-writer", count, nsecs, data.size());
+    reportValue("ratio", writer.getBytesOut() > 0 ? (double) writer.getBytesIn() / writer.getBytesOut() : 0);
+    reportValue("cpuPercent", nsecs > 0 ? cpuNsecs * 100.0 / nsecs : 0);
+
+    /* read the recording again as the viewer does when opening it */
+    QFile compressedFile(fileName);
+    if(!compressedFile.open(QIODevice::ReadOnly))
+        return;
+    QDltCompressedFile reader(&compressedFile);
+    if(!reader.open(QIODevice::ReadOnly))
+        return;
+    QByteArray buf(QDLT_COMPRESSED_WRITER_BLOCK_SIZE, 0);
+    qint64 bytes = 0, length;
+    timer.start();
+    while((length = reader.read(buf.data(), buf.size())) > 0)
+        bytes += length;
+    report("decompress", count, timer.nsecsElapsed(), bytes);
+}
+
+/* Create the byte stream an ECU sends over TCP, each message with serial header instead of storage header */
+static QByteArray createTcpStream(const QVector<QByteArray> &bufs)
+{
+    QByteArray stream;
+
+    for(int num = 0; num < bufs.size(); num++)
+    {
+        stream.append("DLS\x01", 4);
+        stream.append(bufs[num].constData() + sizeof(DltStorageHeader), bufs[num].size() - sizeof(DltStorageHeader));
+    }
+
+    return stream;
+}
+
+/* Feed a TCP byte stream in segments through the connection parser as the viewer does on each socket read */
+static void benchConnection(const QString &name, const QByteArray &stream, int segmentSize, bool syncSerialHeader, int rounds)
+{
+    QElapsedTimer timer;
+    QDltTCPConnection connection;
+    QDltMsg msg;
+    int count = 0;
+
+    connection.setSyncSerialHeader(syncSerialHeader);
+
+    timer.start();
+    for(int round = 0; round < rounds; round++)
+    {
+        connection.clear();
+        for(int pos = 0; pos < stream.size(); pos += segmentSize)
+        {
+            connection.add(QByteArray::fromRawData(stream.constData() + pos, qMin(segmentSize, stream.size() - pos)));
+            while(connection.parse(msg))
+                count++;
+        }
+    }
+    report(name, count, timer.nsecsElapsed(), stream.size() * (qint64) rounds);
+}
+
+/* Table model showing the columns of the viewer table for a growing number of received messages */
+class BenchTableModel : public QAbstractTableModel
+{
+public:
+    BenchTableModel(const QVector<QDltMsg> &msgs) : msgs(msgs), rows(0), publishedRows(0) {}
+
+    int rowCount(const QModelIndex & /*parent*/ = QModelIndex()) const { return publishedRows; }
+    int columnCount(const QModelIndex & /*parent*/ = QModelIndex()) const { return 8; }
+
+    QVariant data(const QModelIndex &index, int role) const
+    {
+        if(role != Qt::DisplayRole || !index.isValid())
+            return QVariant();
+
+        const QDltMsg &msg = msgs[index.row() % msgs.size()];
+        switch(index.column())
+        {
+        case 0: return index.row();
+        case 1: return msg.getTimeString();
+        case 2: return QString::number(msg.getTimestamp());
+        case 3: return msg.getEcuid();
+        case 4: return msg.getApid();
+        case 5: return msg.getCtid();
+        case 6: return msg.getTypeString();
+        default: return msg.toStringPayload();
+        }
+    }
+
+    /* messages received in the background, not yet published to the view */
+    void receive(int count) { rows += count; }
+
+    /* publish all received rows with a complete layout change */
+    void publishLayoutChanged()
+    {
+        publishedRows = rows;
+        emit layoutChanged();
+    }
+
+    /* publish only the appended rows */
+    void publishInsertRows()
+    {
+        if(rows == publishedRows)
+            return;
+        beginInsertRows(QModelIndex(), publishedRows, rows - 1);
+        publishedRows = rows;
+        endInsertRows();
+    }
+
+private:
+    const QVector<QDltMsg> &msgs;
+    int rows;
+    int publishedRows;
+};
+
+/* Update and repaint the table on each draw timer tick while messages are received at a fixed rate */
+static void benchView(const QVector<QDltMsg> &msgs, int rate, int seconds, bool insertRows)
+{
+    const int drawInterval = 50; /* default refresh rate of 20 updates per second */
+    const int ticks = seconds * 1000 / drawInterval;
+
+    BenchTableModel model(msgs);
+    QTableView view;
+    view.setModel(&model);
+    view.resize(1280, 800);
+    view.show();
+    QCoreApplication::processEvents();
+
+    QElapsedTimer timer;
+    qint64 nsecs = 0;
+    for(int tick = 0; tick < ticks; tick++)
+    {
+        model.receive(rate * drawInterval / 1000);
+
+        timer.start();
+        if(insertRows)
+            model.publishInsertRows();
+        else
+            model.publishLayoutChanged();
+        view.scrollToBottom();
+        view.viewport()->repaint();
+        QCoreApplication::processEvents();
+        nsecs += timer.nsecsElapsed();
+    }
+
+    QString name = insertRows ? "view-insert-rows" : "view-layout-changed";
+    report(name, model.rowCount(), nsecs);
+    reportValue("msecsPerUpdate", nsecs / 1000000.0 / ticks);
+    reportValue("guiLoadPercent", nsecs / 10000000.0 / seconds);
+    if(!quiet)
+        out << name << ": " << QString::number(nsecs / 1000000.0 / ticks, 'f', 2) << " ms per update, "
+            << QString::number(nsecs / 10000000.0 / seconds, 'f', 1) << " % of GUI thread time at " << rate << " msgs/s" << endl;
+}
+
+static void usage()
+{
+    out << "Usage: dlt-bench [options]" << endl;
+    out << "Options:" << endl;
+    out << " -s size \t Size of the generated trace in MB (default 16)" << endl;
+    out << " -mix mix \t Message mix of the generated trace (default verbose=70,nonverbose=20,control=5,segmented=5)" << endl;
+    out << " -seed n \t Seed of the generated trace (default 1)" << endl;
+    out << " -g file \t Only write the generated trace to a DLT file" << endl;
+    out << " -f file \t Use a DLT file instead of a generated trace" << endl;
+    out << " -r rounds \t Number of rounds of each benchmark (default 5)" << endl;
+    out << " -p dir \t Load the decoder plugins from a directory and enable them" << endl;
+    out << " -tcp file \t Use a recorded TCP stream with serial headers for the connection benchmark" << endl;
+    out << " -json file \t Write the results as JSON, - for stdout" << endl;
+    out << " -view \t Only run the table view benchmark, seconds are given by -r" << endl;
+    out << " -rate n \t Received messages per second of the table view benchmark (default 50000)" << endl;
+}
+
+static bool writeJson(const QString &fileName, const QJsonObject &trace, int rounds)
+{
+    QJsonObject root;
+    root["benchmark"] = QString("dlt-bench");
+    root["rounds"] = rounds;
+    root["trace"] = trace;
+    root["results"] = results;
+    QByteArray json = QJsonDocument(root).toJson();
+
+    if(fileName == "-")
+    {
+        out << json;
+        out.flush();
+        return true;
+    }
+
+    QFile file(fileName);
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    return file.write(json) == json.size();
+}
+
+int main(int argc, char *argv[])
+{
+    /* the view benchmark needs a GUI, all other benchmarks run without */
+    bool view = false;
+    for(int num = 1; num < argc; num++)
+        if(QString(argv[num]) == "-view")
+            view = true;
+
+    QScopedPointer<QCoreApplication> app(view ? new QApplication(argc, argv) : new QCoreApplication(argc, argv));
+    QStringList args = app->arguments();
+
+    qint64 size = 16;
+    QString mix;
+    quint32 seed = 1;
+    QString generateFile;
+    QString traceFile;
+    int rounds = 5;
+    QString pluginDir;
+    QString tcpFile;
+    QString jsonFile;
+    int viewRate = 50000;
+
+    for(int num = 1; num < args.size(); num++)
+    {
+        if(args[num] == "-s" && num + 1 < args.size())
+            size = args[++num].toLongLong();
+        else if(args[num] == "-mix" && num + 1 < args.size())
+            mix = args[++num];
+        else if(args[num] == "-seed" && num + 1 < args.size())
+            seed = args[++num].toUInt();
+        else if(args[num] == "-g" && num + 1 < args.size())
+            generateFile = args[++num];
+        else if(args[num] == "-f" && num + 1 < args.size())
+            traceFile = args[++num];
+        else if(args[num] == "-r" && num + 1 < args.size())
+            rounds = args[++num].toInt();
+        else if(args[num] == "-p" && num + 1 < args.size())
+            pluginDir = args[++num];
+        else if(args[num] == "-tcp" && num + 1 < args.size())
+            tcpFile = args[++num];
+        else if(args[num] == "-json" && num + 1 < args.size())
+            jsonFile = args[++num];
+        else if(args[num] == "-view")
+            ;
+        else if(args[num] == "-rate" && num + 1 < args.size())
+            viewRate = args[++num].toInt();
+        else
+        {
+            usage();
+            return 1;
+        }
+    }
+    quiet = (jsonFile == "-");
+
+    DltBenchGenerator generator(seed);
+    if(!mix.isEmpty() && !generator.setMix(mix))
+    {
+        usage();
+        return 1;
+    }
+
+    if(!generateFile.isEmpty())
+    {
+        if(!generator.writeFile(generateFile, size * 1024 * 1024))
+        {
+            out << "Cannot write " << generateFile << endl;
+            return 1;
+        }
+        out << generateFile << ": " << generator.getMessages() << " msgs, verbose " << generator.getVerbose()
+            << ", non-verbose " << generator.getNonVerbose() << ", control " << generator.getControl()
+            << ", segmented " << generator.getSegmented() << endl;
+        return 0;
+    }
+
+    /* the generated trace is benchmarked from a temporary file like a log file */
+    QJsonObject trace;
+    QTemporaryFile tempFile;
+    if(traceFile.isEmpty())
+    {
+        QByteArray data = generator.generate(size * 1024 * 1024);
+        if(!tempFile.open() || tempFile.write(data) != data.size())
+        {
+            out << "Cannot write temporary file" << endl;
+            return 1;
+        }
+        tempFile.flush();
+        traceFile = tempFile.fileName();
+        trace["generated"] = true;
+        trace["seed"] = (qint64) seed;
+        trace["mix"] = generator.getMix();
+    }
+    else
+    {
+        trace["generated"] = false;
+        trace["file"] = traceFile;
+    }
+
+    QDltFile file;
+    if(!file.open(traceFile))
+    {
+        out << "Cannot open " << traceFile << endl;
+        return 1;
+    }
+    qint64 fileSize = file.fileSize();
+
+    benchIndex(file, traceFile, fileSize, rounds);
+
+    QVector<QByteArray> bufs;
+    QVector<QDltMsg> msgs;
+    bufs.reserve(file.size());
+    msgs.reserve(file.size());
+    for(int num = 0; num < file.size(); num++)
+    {
+        QDltMsg msg;
+        bufs.append(file.getMsg(num));
+        msg.setMsg(bufs.last());
+        msgs.append(msg);
+    }
+    trace["bytes"] = fileSize;
+    trace["messages"] = msgs.size();
+
+    if(!quiet)
+        out << "Trace: " << msgs.size() << " msgs, " << QString::number(fileSize / 1048576.0, 'f', 1) << " MB" << endl;
+
+    if(view)
+    {
+        benchView(msgs, viewRate, rounds, false);
+        benchView(msgs, viewRate, rounds, true);
+    }
+    else
+    {
+        benchSetMsg(bufs, rounds);
+        benchArguments(msgs, rounds);
+        benchFilter(msgs, rounds);
+
+        /* decoder plugins are only benchmarked if a plugin directory is given */
+        QDltPluginManager pluginManager;
+        if(!pluginDir.isEmpty())
+        {
+            pluginManager.loadPlugins(pluginDir);
+            QList<QDltPlugin*> plugins = pluginManager.getPlugins();
+            for(int num = 0; num < plugins.size(); num++)
+                plugins[num]->setMode(QDltPlugin::ModeEnable);
+            if(!pluginManager.getDecoderPlugins().isEmpty())
+                benchDecoders(msgs, pluginManager, rounds);
+            else if(!quiet)
+                out << "No decoder plugins found in " << pluginDir << endl;
+        }
+
+        benchExport(msgs, bufs, QDltExportFormatter::FormatAscii, "export-ascii", rounds);
+        benchExport(msgs, bufs, QDltExportFormatter::FormatCsv, "export-csv", rounds);
+        benchFormat(msgs, rounds);
+        benchTime(msgs, rounds);
+
+        /* compressed recording of the trace */
+        QFile traceData(traceFile);
+        if(traceData.open(QIODevice::ReadOnly))
+            benchCompress(traceData.readAll(), msgs.size(), rounds);
+
+        /* a recorded TCP stream with serial headers replaces the stream created from the trace */
+        QByteArray stream;
+        if(tcpFile.isEmpty())
+            stream = createTcpStream(bufs);
+        else
+        {
+            QFile tcp(tcpFile);
+            if(!tcp.open(QIODevice::ReadOnly))
+            {
+                out << "Cannot open " << tcpFile << endl;
+                return 1;
+            }
+            stream = tcp.readAll();
+        }
+
+        benchConnection("tcp-parse-1460", stream, 1460, true, rounds);
+        benchConnection("tcp-parse-64k", stream, 64 * 1024, true, rounds);
+    }
+
+    if(!jsonFile.isEmpty() && !writeJson(jsonFile, trace, rounds))
+    {
+        out << "Cannot write " << jsonFile << endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,41 @@
+TARGET   = dlt-viewer-cli
+TEMPLATE = app
+
+CONFIG += c++11 console
+CONFIG -= app_bundle
+
+*-g++* {
+    QMAKE_CXXFLAGS += -std=gnu++0x
+    QMAKE_CXXFLAGS += -Wall
+    QMAKE_CXXFLAGS += -Wextra
+}
+
+unix:DEFINES += BYTE_ORDER=LITTLE_ENDIAN _TTY_POSIX_ QT_VIEWER
+win32:DEFINES += BYTE_ORDER=LITTLE_ENDIAN QT_VIEWER
+DEFINES += QT5
+
+QT += core network serialport
+QT -= gui
+
+INCLUDEPATH = . ../qdlt
+
+# Put intermediate files in the build directory
+MOC_DIR     = build/moc
+OBJECTS_DIR = build/obj
+
+# Library definitions for debug and release builds
+CONFIG(debug, debug|release) {
+    DESTDIR = ../debug
+    QMAKE_LIBDIR += ../debug
+    LIBS += -lqdltd
+} else {
+    DESTDIR = ../release
+    QMAKE_LIBDIR += ../release
+    LIBS += -lqdlt
+    QMAKE_RPATHDIR += ../build/release
+}
+
+SOURCES += main.cpp \
+    dltcliconverter.cpp
+
+HEADERS += dltcliconverter.h
@@ -0,0 +1,383 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file dltcliconverter.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QElapsedTimer>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include "dltcliconverter.h"
+
+DltCliWorker::DltCliWorker(DltCliConverter *converter)
+    : converter(converter)
+{
+}
+
+void DltCliWorker::run()
+{
+    /* each worker needs its own copy, the regular expressions of the filters are not thread safe */
+    QDltFilterList filters(converter->filterList);
+    QDltExportFormatter formatter(converter->format);
+
+    DltCliBatch *batch;
+    while((batch = converter->takeBatch()) != NULL)
+    {
+        converter->processBatch(*batch,filters,formatter);
+        converter->completeBatch(batch);
+    }
+}
+
+DltCliConverter::DltCliConverter()
+{
+    format = QDltExportFormatter::FormatAscii;
+    threads = 0;
+    pluginManager = NULL;
+    decode = false;
+    nextSequence = 0;
+    nextWriteSequence = 0;
+    stop = false;
+    messages = 0;
+    exported = 0;
+    filtered = 0;
+    errors = 0;
+    bytesIn = 0;
+    bytesOut = 0;
+    elapsed = 0;
+    usedThreads = 0;
+}
+
+DltCliConverter::~DltCliConverter()
+{
+    qDeleteAll(pendingBatches);
+    qDeleteAll(completedBatches);
+}
+
+bool DltCliConverter::convert(const QString &input, const QString &output)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    inputName = input;
+    outputName = output;
+    nextSequence = 0;
+    nextWriteSequence = 0;
+    stop = false;
+    messages = 0;
+    exported = 0;
+    filtered = 0;
+    errors = 0;
+    bytesIn = 0;
+    bytesOut = 0;
+
+    /* open the input file, compressed files are decompressed on the fly */
+    QFile inputFile(input);
+    if(!inputFile.open(QIODevice::ReadOnly))
+    {
+        error = QString("Cannot open the input file %1").arg(input);
+        return false;
+    }
+
+    QIODevice *device = &inputFile;
+    QDltCompressedFile compressedFile(&inputFile);
+    if(QDltCompressedFile::detectFormat(&inputFile) != QDltCompressedFile::FormatNone)
+    {
+        if(!compressedFile.open(QIODevice::ReadOnly))
+        {
+            error = QString("Cannot decompress the input file %1").arg(input);
+            return false;
+        }
+        device = &compressedFile;
+    }
+
+    /* open the output file */
+    QDltExportFormatter formatter(format);
+    outputFile.setFileName(output);
+    if(!outputFile.open(formatter.isText() ? QIODevice::WriteOnly | QIODevice::Text : QIODevice::WriteOnly))
+    {
+        error = QString("Cannot open the output file %1").arg(output);
+        return false;
+    }
+
+    if(format == QDltExportFormatter::FormatCsv)
+    {
+        QByteArray header = QDltExportFormatter::csvHeader().toLatin1();
+        if(outputFile.write(header) < 0)
+        {
+            error = QString("Cannot write the output file %1").arg(output);
+            outputFile.close();
+            return false;
+        }
+        bytesOut += header.size();
+    }
+
+    decode = pluginManager && !pluginManager->getDecoderPlugins().isEmpty();
+
+    /* start the workers */
+    usedThreads = threads > 0 ? threads : QThread::idealThreadCount();
+    if(usedThreads < 1)
+        usedThreads = 1;
+
+    QVector<DltCliWorker*> workers;
+    for(int num=0;num<usedThreads;num++)
+    {
+        DltCliWorker *worker = new DltCliWorker(this);
+        workers.append(worker);
+        worker->start();
+    }
+
+    bool ok = readMessages(device);
+
+    /* write all remaining batches and stop the workers */
+    if(ok)
+        ok = writeBatches(0);
+
+    mutex.lock();
+    stop = true;
+    batchQueued.wakeAll();
+    mutex.unlock();
+
+    for(int num=0;num<workers.size();num++)
+    {
+        workers[num]->wait();
+        delete workers[num];
+    }
+
+    qDeleteAll(pendingBatches);
+    pendingBatches.clear();
+    qDeleteAll(completedBatches);
+    completedBatches.clear();
+
+    outputFile.close();
+    elapsed = timer.elapsed();
+
+    return ok;
+}
+
+bool DltCliConverter::readMessages(QIODevice *device)
+{
+    static const QByteArray marker("DLT\x01",4);
+
+    QByteArray data;
+    int msgStart = -1;
+    int index = 0;
+    DltCliBatch *batch = new DltCliBatch();
+    qint64 length;
+
+    do
+    {
+        /* only the begin of the current message is kept from the last chunk */
+        int searchPos = data.size() >= marker.size() ? data.size() - marker.size() + 1 : 0;
+        data.resize(data.size() + DLT_CLI_READ_SIZE);
+        length = device->read(data.data() + data.size() - DLT_CLI_READ_SIZE, DLT_CLI_READ_SIZE);
+        data.resize(data.size() - DLT_CLI_READ_SIZE + (length > 0 ? length : 0));
+        if(length > 0)
+            bytesIn += length;
+
+        /* a message reaches from one marker to the next marker or to the end of the file */
+        int pos;
+        while((pos = data.indexOf(marker,searchPos)) >= 0 || (length <= 0 && msgStart >= 0))
+        {
+            if(msgStart >= 0)
+            {
+                batch->indexes.append(index++);
+                batch->bufs.append(data.mid(msgStart,(pos >= 0 ? pos : data.size()) - msgStart));
+
+                if(batch->bufs.size() >= DLT_CLI_BATCH_SIZE)
+                {
+                    if(!queueBatch(batch))
+                        return false;
+                    batch = new DltCliBatch();
+                }
+            }
+
+            if(pos < 0)
+            {
+                msgStart = -1;
+                break;
+            }
+            msgStart = pos;
+            searchPos = pos + marker.size();
+        }
+
+        if(msgStart > 0)
+        {
+            data.remove(0,msgStart);
+            msgStart = 0;
+        }
+        else if(msgStart < 0 && data.size() >= marker.size())
+        {
+            /* no message started yet, keep only a possible partial marker */
+            data.remove(0,data.size() - marker.size() + 1);
+        }
+    }
+    while(length > 0);
+
+    if(length < 0)
+    {
+        error = QString("Cannot read the input file %1").arg(inputName);
+        delete batch;
+        return false;
+    }
+
+    if(batch->bufs.isEmpty())
+    {
+        delete batch;
+        return true;
+    }
+
+    return queueBatch(batch);
+}
+
+bool DltCliConverter::queueBatch(DltCliBatch *batch)
+{
+    messages += batch->bufs.size();
+
+    if(decode)
+        decodeBatch(*batch);
+
+    mutex.lock();
+    batch->sequence = nextSequence++;
+    pendingBatches.enqueue(batch);
+    batchQueued.wakeOne();
+    mutex.unlock();
+
+    /* limit the memory used by the pipeline */
+    return writeBatches(usedThreads * 4);
+}
+
+void DltCliConverter::decodeBatch(DltCliBatch &batch)
+{
+    batch.msgs.resize(batch.bufs.size());
+    batch.valid.resize(batch.bufs.size());
+
+    for(int num=0;num<batch.bufs.size();num++)
+    {
+        batch.valid[num] = batch.msgs[num].setMsg(batch.bufs[num]);
+        if(batch.valid[num])
+            pluginManager->decodeMsg(batch.msgs[num],0);
+    }
+}
+
+DltCliBatch *DltCliConverter::takeBatch()
+{
+    QMutexLocker locker(&mutex);
+
+    while(pendingBatches.isEmpty() && !stop)
+        batchQueued.wait(&mutex);
+
+    if(pendingBatches.isEmpty())
+        return NULL;
+
+    return pendingBatches.dequeue();
+}
+
+void DltCliConverter::processBatch(DltCliBatch &batch, QDltFilterList &filters, QDltExportFormatter &formatter)
+{
+    QDltMsg parsed;
+
+    for(int num=0;num<batch.bufs.size();num++)
+    {
+        /* if decoders are enabled, the messages were already parsed and decoded by the reading thread */
+        QDltMsg &msg = batch.msgs.isEmpty() ? parsed : batch.msgs[num];
+        bool valid = batch.msgs.isEmpty() ? msg.setMsg(batch.bufs[num]) : batch.valid[num];
+
+        if(!valid)
+        {
+            batch.errors++;
+            continue;
+        }
+
+        if(!filters.checkFilter(msg))
+        {
+            batch.filtered++;
+            continue;
+        }
+
+        formatter.formatMsg(batch.indexes[num],msg,batch.bufs[num],batch.output);
+        batch.exported++;
+    }
+
+    /* free the messages early, only the output is needed by the writer */
+    batch.msgs.clear();
+    batch.valid.clear();
+    batch.bufs.clear();
+}
+
+void DltCliConverter::completeBatch(DltCliBatch *batch)
+{
+    QMutexLocker locker(&mutex);
+
+    completedBatches.insert(batch->sequence,batch);
+    batchCompleted.wakeAll();
+}
+
+bool DltCliConverter::writeBatches(int maxPending)
+{
+    bool ok = true;
+
+    mutex.lock();
+    while(nextSequence - nextWriteSequence > maxPending)
+    {
+        DltCliBatch *batch = completedBatches.take(nextWriteSequence);
+        if(!batch)
+        {
+            batchCompleted.wait(&mutex);
+            continue;
+        }
+        nextWriteSequence++;
+
+        /* write without holding the lock, so the workers can continue */
+        mutex.unlock();
+        if(ok && outputFile.write(batch->output) < 0)
+        {
+            error = QString("Cannot write the output file %1").arg(outputName);
+            ok = false;
+        }
+        bytesOut += batch->output.size();
+        exported += batch->exported;
+        filtered += batch->filtered;
+        errors += batch->errors;
+        delete batch;
+        mutex.lock();
+    }
+    mutex.unlock();
+
+    return ok;
+}
+
+QByteArray DltCliConverter::statsJson() const
+{
+    QJsonObject stats;
+
+    stats.insert("input",inputName);
+    stats.insert("output",outputName);
+    stats.insert("threads",usedThreads);
+    stats.insert("decoding",decode);
+    stats.insert("messages",messages);
+    stats.insert("exported",exported);
+    stats.insert("filtered",filtered);
+    stats.insert("errors",errors);
+    stats.insert("bytesIn",bytesIn);
+    stats.insert("bytesOut",bytesOut);
+    stats.insert("elapsedMs",elapsed);
+    stats.insert("messagesPerSecond",elapsed > 0 ? messages * 1000.0 / elapsed : 0.0);
+
+    return QJsonDocument(stats).toJson();
+}
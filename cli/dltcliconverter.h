@@ -0,0 +1,179 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file dltcliconverter.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef DLTCLICONVERTER_H
+#define DLTCLICONVERTER_H
+
+#include <QThread>
+#include <QFile>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QMap>
+#include <QVector>
+
+#include "qdlt.h"
+
+//! Number of messages parsed, filtered and formatted together by one worker thread.
+#define DLT_CLI_BATCH_SIZE 1000
+
+//! Size of the chunks read from the input file.
+#define DLT_CLI_READ_SIZE (1024*1024)
+
+class DltCliConverter;
+
+//! A batch of messages passed from the reader to a worker and from the worker to the writer.
+class DltCliBatch
+{
+public:
+    DltCliBatch() : sequence(0), exported(0), filtered(0), errors(0) {}
+
+    //! Order of the batch in the input file.
+    int sequence;
+
+    //! Index of each message in the input file.
+    QVector<int> indexes;
+
+    //! The binary messages.
+    QVector<QByteArray> bufs;
+
+    //! Messages parsed and decoded by the reader, empty if the worker parses the messages.
+    QVector<QDltMsg> msgs;
+
+    //! Result of parsing the messages by the reader.
+    QVector<bool> valid;
+
+    //! The formatted messages.
+    QByteArray output;
+
+    int exported;
+    int filtered;
+    int errors;
+};
+
+//! Worker thread parsing, filtering and formatting batches of messages.
+class DltCliWorker : public QThread
+{
+public:
+    DltCliWorker(DltCliConverter *converter);
+
+protected:
+    void run();
+
+private:
+    DltCliConverter *converter;
+};
+
+//! Convert a DLT file into the export formats of the viewer without a GUI.
+/*!
+  The input file is read in chunks and split into messages at the DLT storage
+  header markers, so memory usage only depends on the number of batches in flight.
+  Messages are parsed, filtered and formatted by one worker thread per core
+  and written in the original order.
+  If decoders are enabled, the messages are parsed and decoded sequentially
+  by the reading thread, because the decoder plugins are not thread safe;
+  the workers filter and format the previous batches meanwhile.
+*/
+class DltCliConverter
+{
+public:
+    DltCliConverter();
+    ~DltCliConverter();
+
+    //! Set the output format.
+    void setFormat(QDltExportFormatter::Format format) { this->format = format; }
+
+    //! Set the number of worker threads, 0 uses the number of cores.
+    void setThreads(int threads) { this->threads = threads; }
+
+    //! Set the filters, only matching messages are exported.
+    void setFilterList(const QDltFilterList &filterList) { this->filterList = filterList; }
+
+    //! Set the plugin manager used to decode the messages, 0 to disable decoding.
+    void setPluginManager(QDltPluginManager *pluginManager) { this->pluginManager = pluginManager; }
+
+    //! Convert the input file and write the output file.
+    /*!
+      \param input Name of the DLT file, may be compressed
+      \param output Name of the output file
+      \return true if the conversion was successful, false if an error occurred.
+    */
+    bool convert(const QString &input, const QString &output);
+
+    //! Get the description of the last error.
+    QString errorString() const { return error; }
+
+    //! Get the statistics of the last conversion as JSON document.
+    QByteArray statsJson() const;
+
+private:
+    friend class DltCliWorker;
+
+    //! Functions called by the DltCliWorker.
+    DltCliBatch *takeBatch();
+    void processBatch(DltCliBatch &batch, QDltFilterList &filters, QDltExportFormatter &formatter);
+    void completeBatch(DltCliBatch *batch);
+
+    //! Parse and decode the messages of a batch in the reading thread, if decoders are enabled.
+    void decodeBatch(DltCliBatch &batch);
+
+    //! Pass a filled batch to the workers and write completed batches.
+    bool queueBatch(DltCliBatch *batch);
+
+    //! Write completed batches in order until not more than maxPending batches are pending.
+    bool writeBatches(int maxPending);
+
+    //! Read the input device and split it into batches.
+    bool readMessages(QIODevice *device);
+
+    QDltExportFormatter::Format format;
+    int threads;
+    QDltFilterList filterList;
+    QDltPluginManager *pluginManager;
+    bool decode;
+
+    QString inputName;
+    QString outputName;
+    QFile outputFile;
+    QString error;
+
+    /* state of the pipeline */
+    QMutex mutex;
+    QWaitCondition batchQueued;
+    QWaitCondition batchCompleted;
+    QQueue<DltCliBatch*> pendingBatches;
+    QMap<int,DltCliBatch*> completedBatches;
+    int nextSequence;
+    int nextWriteSequence;
+    bool stop;
+
+    /* statistics */
+    qint64 messages;
+    qint64 exported;
+    qint64 filtered;
+    qint64 errors;
+    qint64 bytesIn;
+    qint64 bytesOut;
+    qint64 elapsed;
+    int usedThreads;
+};
+
+#endif // DLTCLICONVERTER_H
@@ -0,0 +1,279 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file main.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QCoreApplication>
+#include <QStringList>
+#include <QTextStream>
+#include <QSettings>
+#include <QDir>
+#include <QFile>
+#include <QXmlStreamReader>
+
+#include "qdlt.h"
+#include "dltcliconverter.h"
+
+static QTextStream err(stderr);
+
+static void printUsage()
+{
+    err << "Usage: dlt-viewer-cli [OPTIONS] -c logfile outputfile" << endl;
+    err << "       dlt-viewer-cli [OPTIONS] -e \"plugin|command|param1|..|param<n>\"" << endl;
+    err << "Options:" << endl;
+    err << " -h Print usage" << endl;
+    err << " -c logfile outputfile \t Convert logfile to outputfile, default format is ASCII" << endl;
+    err << " -u Conversion will be done in UTF8 instead of ASCII" << endl;
+    err << " -csv Conversion will be done in CSV format" << endl;
+    err << " -d Conversion will NOT be done, save in dlt file format again instead" << endl;
+    err << " -dd Conversion will NOT be done, save as decoded messages in dlt format" << endl;
+    err << " -f filterfile \t Only export messages matching the filters (must end with .dlf)" << endl;
+    err << " -p projectfile \t Use the plugin configuration of the project file (must end with .dlp)" << endl;
+    err << " -np Do not load any plugins" << endl;
+    err << " -t threads \t Number of worker threads, default is the number of cores" << endl;
+    err << " -stats file \t Write statistics as JSON to file, - writes to stdout" << endl;
+    err << " -e \"plugin|command|param1|..|param<n>\" \t Execute a plugin command with the given parameters, after the conversion if any" << endl;
+    err << " -s or --silent \t Do not print progress information" << endl;
+    err << "Examples:" << endl;
+    err << "  dlt-viewer-cli -c ./trace/trace.dlt ./trace.txt" << endl;
+    err << "  dlt-viewer-cli -csv -f ./filter/filter.dlf -c ./trace/trace.dlt.gz ./trace.csv" << endl;
+    err << "  dlt-viewer-cli -p ./proj/decoded.dlp -dd -stats - -c ./trace/trace.dlt ./trace.dlt" << endl;
+    err << "  dlt-viewer-cli -e \"Dummy Command Plugin|append|first line|second line\"" << endl;
+}
+
+/* Set the plugin modes and configurations stored in a project file */
+static bool loadProjectPlugins(const QString &filename, QDltPluginManager &pluginManager)
+{
+    QFile file(filename);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+
+    /* all plugins not mentioned in the project and all plugins not decoding messages are disabled */
+    QList<QDltPlugin*> plugins = pluginManager.getPlugins();
+    for(int num=0;num<plugins.size();num++)
+        plugins[num]->setMode(QDltPlugin::ModeDisable);
+
+    QXmlStreamReader xml(&file);
+    bool inPlugin = false;
+    QString name, configFile;
+    int mode = QDltPlugin::ModeDisable;
+
+    while(!xml.atEnd())
+    {
+        xml.readNext();
+
+        if(xml.isStartElement())
+        {
+            if(xml.name() == QString("plugin"))
+            {
+                inPlugin = true;
+                name.clear();
+                configFile.clear();
+                mode = QDltPlugin::ModeDisable;
+            }
+            else if(inPlugin && xml.name() == QString("name"))
+                name = xml.readElementText();
+            else if(inPlugin && xml.name() == QString("filename"))
+                configFile = xml.readElementText();
+            else if(inPlugin && xml.name() == QString("mode"))
+                mode = xml.readElementText().toInt();
+        }
+        else if(xml.isEndElement() && xml.name() == QString("plugin"))
+        {
+            inPlugin = false;
+            QDltPlugin *plugin = pluginManager.findPlugin(name);
+            if(plugin && plugin->isDecoder())
+            {
+                plugin->setMode((QDltPlugin::Mode) mode);
+                if(mode != QDltPlugin::ModeDisable && !configFile.isEmpty())
+                    plugin->loadConfig(configFile);
+            }
+        }
+    }
+
+    return !xml.hasError();
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QStringList args = app.arguments();
+
+    QString source, destination, filterFile, projectFile, statsFile;
+    QString pluginName, commandName;
+    QStringList commandParams;
+    QDltExportFormatter::Format format = QDltExportFormatter::FormatAscii;
+    int threads = 0;
+    bool silent = false;
+    bool plugins = true;
+
+    for(int num=1;num<args.size();num++)
+    {
+        const QString &arg = args[num];
+
+        if(arg == "-h" || arg == "--help")
+        {
+            printUsage();
+            return 0;
+        }
+        else if(arg == "-s" || arg == "--silent")
+            silent = true;
+        else if(arg == "-u")
+            format = QDltExportFormatter::FormatUTF8;
+        else if(arg == "-csv")
+            format = QDltExportFormatter::FormatCsv;
+        else if(arg == "-d")
+            format = QDltExportFormatter::FormatDlt;
+        else if(arg == "-dd")
+            format = QDltExportFormatter::FormatDltDecoded;
+        else if(arg == "-np")
+            plugins = false;
+        else if(arg == "-c" && num + 2 < args.size())
+        {
+            source = args[++num];
+            destination = args[++num];
+        }
+        else if(arg == "-f" && num + 1 < args.size())
+            filterFile = args[++num];
+        else if(arg == "-p" && num + 1 < args.size())
+            projectFile = args[++num];
+        else if(arg == "-t" && num + 1 < args.size())
+            threads = args[++num].toInt();
+        else if(arg == "-stats" && num + 1 < args.size())
+            statsFile = args[++num];
+        else if(arg == "-e" && num + 1 < args.size() && args[num + 1].split("|").size() > 1)
+        {
+            commandParams = args[++num].split("|");
+            pluginName = commandParams.takeFirst();
+            commandName = commandParams.takeFirst();
+        }
+        else
+        {
+            err << "Error: unknown or incomplete option " << arg << endl;
+            printUsage();
+            return -1;
+        }
+    }
+
+    if((source.isEmpty() && pluginName.isEmpty()) || (!plugins && !pluginName.isEmpty()))
+    {
+        printUsage();
+        return -1;
+    }
+
+    DltCliConverter converter;
+    converter.setFormat(format);
+    converter.setThreads(threads);
+
+    if(!filterFile.isEmpty())
+    {
+        QDltFilterList filterList;
+        if(!filterList.LoadFilter(filterFile,true))
+        {
+            err << "Error: cannot load filter file " << filterFile << endl;
+            return -1;
+        }
+        converter.setFilterList(filterList);
+    }
+
+    /* only decoder plugins are used, they are configured like in the viewer */
+    QDltPluginManager pluginManager;
+    if(plugins)
+    {
+        QSettings settings(QDir::homePath()+"/.dlt/config/config.ini", QSettings::IniFormat);
+        bool pluginsPath = settings.value("startup/pluginsPath",0).toInt();
+        QString pluginsPathName = settings.value("startup/pluginsPathName",QString("")).toString();
+
+        QStringList errList = pluginManager.loadPlugins(pluginsPath ? pluginsPathName : QString());
+        for(int num=0;num<errList.size();num++)
+            err << "Warning: " << errList[num] << endl;
+
+        /* viewer, control and command plugins stay disabled, so plugins with metadata are not even loaded */
+        QList<QDltPlugin*> list = pluginManager.getPlugins();
+        for(int num=0;num<list.size();num++)
+        {
+            if(list[num]->isDecoder())
+                list[num]->setMode((QDltPlugin::Mode) settings.value("plugin/pluginmodefor"+list[num]->getName(),QVariant(QDltPlugin::ModeDisable)).toInt());
+            else
+                list[num]->setMode(QDltPlugin::ModeDisable);
+        }
+
+        if(!projectFile.isEmpty() && !loadProjectPlugins(projectFile,pluginManager))
+        {
+            err << "Error: cannot load project file " << projectFile << endl;
+            return -1;
+        }
+
+        converter.setPluginManager(&pluginManager);
+    }
+
+    bool ok = true;
+    if(!source.isEmpty())
+    {
+        if(!silent)
+            err << "Converting " << source << " to " << destination << endl;
+
+        ok = converter.convert(source,destination);
+        if(!ok)
+            err << "Error: " << converter.errorString() << endl;
+    }
+
+    /* command plugins are executed like with the -e option of the viewer */
+    if(ok && !pluginName.isEmpty())
+    {
+        QDltPlugin *plugin = pluginManager.findPlugin(pluginName);
+        if(!plugin)
+        {
+            err << "Error: plugin " << pluginName << " not found" << endl;
+            ok = false;
+        }
+        else if(!plugin->isCommand())
+        {
+            err << "Error: " << pluginName << " is not a command plugin" << endl;
+            ok = false;
+        }
+        else
+        {
+            if(!silent)
+                err << "Executing " << commandName << " of " << pluginName << endl;
+
+            ok = plugin->command(commandName,commandParams);
+            if(!ok)
+                err << "Error: " << pluginName << " " << plugin->error() << endl;
+        }
+    }
+
+    if(!source.isEmpty() && !statsFile.isEmpty())
+    {
+        QFile stats(statsFile);
+        bool opened;
+        if(statsFile == "-")
+            opened = stats.open(stdout,QIODevice::WriteOnly);
+        else
+            opened = stats.open(QIODevice::WriteOnly | QIODevice::Truncate);
+
+        if(!opened || stats.write(converter.statsJson()) < 0)
+        {
+            err << "Error: cannot write statistics file " << statsFile << endl;
+            ok = false;
+        }
+    }
+
+    return ok ? 0 : -1;
+}
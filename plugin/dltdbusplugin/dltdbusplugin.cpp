@@ -40,7 +40,7 @@ int DltDBusPlugin::check_logid( QString &tocheck, int index )
 {
    if ( tocheck.size() > LOGIDMAXCHAR )
    {
-       if ( dltControl->silentmode == true )
+       if ( !dltControl || dltControl->silentmode == true )
         {
          qDebug() << plugin_name_displayed << QString("XML file - LOGID error %1 with index %2 exceeds maximum of %3 characters !\nExit parsing file ...").arg(tocheck).arg(index).arg(LOGIDMAXCHAR);
         }
@@ -62,6 +62,7 @@ int DltDBusPlugin::check_logid( QString &tocheck, int index )
 DltDBusPlugin::DltDBusPlugin()
 {
     dltFile = 0;
+    dltControl = 0;
 }
 
 DltDBusPlugin::~DltDBusPlugin() {
@@ -169,7 +170,7 @@ bool DltDBusPlugin::loadConfig(QString filename)
            }
            if (xml.hasError())
             {
-               if ( dltControl->silentmode == true )
+               if ( !dltControl || dltControl->silentmode == true )
                 {
                  qDebug() << plugin_name_displayed  << "XML Parser error" << xml.errorString() << "at" << xml.lineNumber();
                 }
@@ -185,7 +186,7 @@ bool DltDBusPlugin::loadConfig(QString filename)
        if (i >= MAX_LOGIDS)
        {
         i--;
-        if ( dltControl->silentmode == true )
+        if ( !dltControl || dltControl->silentmode == true )
          {
           qDebug() << plugin_name_displayed << "Maximum number of logids exceeded in xml file ! Limiting logid list entries:" << MAX_LOGIDS;
          }
@@ -203,7 +204,7 @@ file.close();
 
  if (xml.hasError())
  {
-    if ( dltControl->silentmode == true )
+    if ( !dltControl || dltControl->silentmode == true )
      {
      qDebug() << plugin_name_displayed << QString("XML Parser error %1 at line %2").arg(xml.errorString()).arg(xml.lineNumber());
      }
@@ -352,18 +353,24 @@ void DltDBusPlugin::initFileStart(QDltFile *file)
    if (plugin_is_active == false )
    {
     plugin_is_active = true;
-    dltFile = file;
-    methods.clear();
     qDebug() << "Activate plugin" << plugin_name_displayed <<  DLT_DBUS_PLUGIN_VERSION;
-    // clear old map
-    QMapIterator<uint32_t, QDltSegmentedMsg*> i(segmentedMessages);
-    while (i.hasNext())
-     {
-        i.next();
-        delete i.value();
-     }
-    segmentedMessages.clear();
    }
+   dltFile = file;
+
+   // the segments of a reloaded file are skipped by the reassembler,
+   // the state is only cleared if other files are loaded or the file was truncated
+   QStringList files;
+   for(int num = 0; num < file->getNumberOfFiles(); num++)
+   {
+       files.append(file->getFileName(num));
+   }
+   if(files != segmentedFiles || file->fileSize() < segmentedFileSize)
+   {
+       methods.clear();
+       segmentedMessages.clear();
+       segmentedFiles = files;
+   }
+   segmentedFileSize = file->fileSize();
 }
 
 void DltDBusPlugin::methodsAddMsg(QDltMsg &msg)
@@ -396,101 +403,33 @@ void DltDBusPlugin::methodsAddMsg(QDltMsg &msg)
     }
 }
 
-void DltDBusPlugin::segmentedMsg(QDltMsg &msg)
+void DltDBusPlugin::segmentedMsg(int index, QDltMsg &msg)
 {
-    QDltArgument argument1,argument2;
-    uint32_t handle;
+    QDltSegmentReassembler::SegmentResult result = segmentedMessages.add(index,msg);
 
-    msg.getArgument(0,argument1);
-    msg.getArgument(1,argument2);
-
-    // get handle
-    if(argument2.getTypeInfo()!=QDltArgument::DltTypeInfoUInt)
+    if(result == QDltSegmentReassembler::SegmentError)
     {
-         return;
+        // something went wrong
+        qDebug() << plugin_name_displayed << segmentedMessages.getError();
     }
-    handle = argument2.getValue().toUInt();
-
-    // check if this is a segmented network message
-    if(argument1.getTypeInfo()!=QDltArgument::DltTypeInfoStrg)
+    else if(result == QDltSegmentReassembler::SegmentComplete)
     {
-        return;
-    }
-
-    if(argument1.getValue().toString()=="NWST")
-    {
-      if(segmentedMessages.contains(handle))
-      {
-          // message already exists, this should not happen
-          return;
-      }
-
-      // add new segmented message
-      QDltSegmentedMsg *seg = new QDltSegmentedMsg();
-      segmentedMessages[handle] = seg;
-
-      if(seg->add(msg))
-      {
-          // something went wrong
-          qDebug() << plugin_name_displayed << seg->getError();
-          return;
-      }
-    } // NWST
-    else if(argument1.getValue().toString()=="NWCH")
-    {
-        if(segmentedMessages.contains(handle))
+        // decode message and add method call to list
+        QDltArgument argument2;
+        msg.getArgument(1,argument2);
+        QByteArray data = segmentedMessages.getMessage(argument2.getValue().toUInt());
+        DltDBusDecoder dbusMsg;
+        if(dbusMsg.decode(data))
         {
-            if(segmentedMessages[handle]->add(msg))
+            if(dbusMsg.getMessageType()==DBUS_MESSAGE_TYPE_METHOD_CALL)
             {
-                // something went wrong
-                qDebug() << plugin_name_displayed << segmentedMessages[handle]->getError();
-                return;
+                methods[DltDbusMethodKey(dbusMsg.getSender(),dbusMsg.getSerial())] = dbusMsg.getInterface() + "." + dbusMsg.getMember();
             }
         }
-    } // NWCH
-    else if(argument1.getValue().toString()=="NWEN")
-    {
-       if(segmentedMessages.contains(handle))
-       {
-           if(segmentedMessages[handle]->add(msg))
-           {
-               // something went wrong
-               qDebug() << plugin_name_displayed << segmentedMessages[handle]->getError();
-               return;
-           }
-           if(segmentedMessages[handle]->complete())
-           {
-               if(argument2.getTypeInfo()==QDltArgument::DltTypeInfoUInt)
-               {
-                   // decode message and add method call to list
-                   uint32_t handle = argument2.getValue().toUInt();
-                   if(segmentedMessages.contains(handle))
-                   {
-                       if(segmentedMessages[handle]->complete())
-                       {
-                           QByteArray data = segmentedMessages[handle]->getHeader() + segmentedMessages[handle]->getPayload() ;
-                           DltDBusDecoder dbusMsg;
-                           if(dbusMsg.decode(data))
-                           {
-                               if(dbusMsg.getMessageType()==DBUS_MESSAGE_TYPE_METHOD_CALL)
-                               {
-                                   methods[DltDbusMethodKey(dbusMsg.getSender(),dbusMsg.getSerial())] = dbusMsg.getInterface() + "." + dbusMsg.getMember();
-                               }
-                           }
-                       }
-                   }
-               }
-               //qDebug() << "Complete segemented message" << segmentedMessages[handle]->getPayload().size();
-           }
-           else
-           {
-                qDebug() << plugin_name_displayed <<"Incomplete segemented message" << handle;
-           }
-       }
-    } // NWCN
+    }
 }
 
-void DltDBusPlugin::initMsg(int /*index*/, QDltMsg &msg)
+void DltDBusPlugin::initMsg(int index, QDltMsg &msg)
 {
 
     if(!checkIfDBusMsg(msg))
@@ -500,7 +439,7 @@ void DltDBusPlugin::initMsg(int /*index*/, QDltMsg &msg)
     methodsAddMsg(msg);
 
     // add segment
-    segmentedMsg(msg);
+    segmentedMsg(index,msg);
 
 }
 
@@ -518,7 +457,7 @@ void DltDBusPlugin::updateFileStart()
 //empty. Implemented because derived plugin interface functions are virtual.
 }
 
-void DltDBusPlugin::updateMsg(int /*index*/, QDltMsg &msg)
+void DltDBusPlugin::updateMsg(int index, QDltMsg &msg)
 {
    //  qDebug () << "Activate plugin" << plugin_name_displayed << "Version" << DLT_DBUS_PLUGIN_VERSION;
     if(!checkIfDBusMsg(msg))
@@ -528,7 +467,7 @@ void DltDBusPlugin::updateMsg(int /*index*/, QDltMsg &msg)
     methodsAddMsg(msg);
 
     // add segment
-    segmentedMsg(msg);
+    segmentedMsg(index,msg);
 }
 
 void DltDBusPlugin::updateMsgDecoded(int , QDltMsg &){
@@ -540,6 +479,39 @@ void DltDBusPlugin::updateFileFinish()
 
 }
 
+void DltDBusPlugin::initMsgs(const QDltMsgBatch &batch)
+{
+    for(int num = 0; num < batch.size(); num++)
+    {
+        QDltMsg &msg = *batch[num].second;
+
+        if(!checkIfDBusMsg(msg))
+            continue;
+
+        // add method call
+        methodsAddMsg(msg);
+
+        // add segment
+        segmentedMsg(batch[num].first,msg);
+    }
+}
+
+void DltDBusPlugin::initMsgsDecoded(const QDltMsgBatch &)
+{
+//empty. Implemented because derived plugin interface functions are virtual.
+}
+
+void DltDBusPlugin::updateMsgs(const QDltMsgBatch &batch)
+{
+    // received messages are handled like messages of a loaded file
+    initMsgs(batch);
+}
+
+void DltDBusPlugin::updateMsgsDecoded(const QDltMsgBatch &)
+{
+//empty. Implemented because derived plugin interface functions are virtual.
+}
+
 bool DltDBusPlugin::isMsg(QDltMsg & msg, int triggeredByUser)
 {
     Q_UNUSED(triggeredByUser);
@@ -547,6 +519,24 @@ bool DltDBusPlugin::isMsg(QDltMsg & msg, int triggeredByUser)
     return checkIfDBusMsg(msg);
 }
 
+bool DltDBusPlugin::decoderInterest(QDltDecoderInterest &interest)
+{
+    /* DBus messages are verbose network trace messages of the configured APID/CTID pairs */
+    interest.nonVerbose = false;
+    interest.types.append(QDltMsg::DltTypeNwTrace);
+
+    if ( config_is_loaded == true )
+    {
+        for ( int i = 0; i <= numberof_valid_logids && i < MAX_LOGIDS; i++ )
+        {
+            interest.apids.append(logid[i].apid);
+            interest.ctids.append(logid[i].ctid);
+        }
+    }
+
+    return true;
+}
+
 bool DltDBusPlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
 {
     QDltArgument argument1,argument2,argument;
@@ -608,10 +598,10 @@ bool DltDBusPlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
             uint32_t handle = argument2.getValue().toUInt();
             if(segmentedMessages.contains(handle))
             {
-                if(segmentedMessages[handle]->complete())
+                if(segmentedMessages.isComplete(handle))
                 {
                     // show decoded message
-                    QByteArray data = segmentedMessages[handle]->getHeader() + segmentedMessages[handle]->getPayload() ;
+                    QByteArray data = segmentedMessages.getMessage(handle);
                     DltDBusDecoder dbusMsg;
                     if(dbusMsg.decode(data))
                     {
@@ -779,7 +769,8 @@ QString DltDBusPlugin::decodeMessageToString(DltDBusDecoder &dbusMsg,bool header
 /* Control Plugin methods */
 
 // these are only needed to get information about silent mode via
-// dltcontrol
+// dltcontrol, without control (e.g. in the command line converter)
+// the plugin behaves like in silent mode
 bool DltDBusPlugin::initControl(QDltControl *control)
 {
     dltControl = control;
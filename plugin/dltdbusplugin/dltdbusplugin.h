@@ -27,7 +27,7 @@
 #include "dbus.h"
 
 #include "plugininterface.h"
-#include "qdltsegmentedmsg.h"
+#include "qdltsegmentreassembler.h"
 #include "form.h"
 
 #define DLT_DBUS_PLUGIN_VERSION "2.0.0"
@@ -71,15 +71,17 @@ inline uint qHash(const DltDbusMethodKey &key)
     return qHash(key.getSender()) ^ key.getSerial();
 }
 
-class DltDBusPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerInterface, QDLTPluginDecoderInterface,  QDltPluginControlInterface
+class DltDBusPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerInterface, QDLTPluginDecoderInterface,  QDltPluginControlInterface, QDltPluginDecoderInterestInterface, QDltPluginViewerBatchInterface
 {
     Q_OBJECT
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDltPluginViewerInterface)
     Q_INTERFACES(QDltPluginControlInterface)
     Q_INTERFACES(QDLTPluginDecoderInterface)
+    Q_INTERFACES(QDltPluginDecoderInterestInterface)
+    Q_INTERFACES(QDltPluginViewerBatchInterface)
 #ifdef QT5
-    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DltDbusPlugin")
+    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DltDbusPlugin" FILE "dltdbusplugin.json")
 #endif
 
 public:
@@ -109,6 +111,12 @@ public:
     void selectedIdxMsg(int index, QDltMsg &msg);
     void selectedIdxMsgDecoded(int index, QDltMsg &msg);
 
+    /* QDltPluginViewerBatchInterface */
+    void initMsgs(const QDltMsgBatch &batch);
+    void initMsgsDecoded(const QDltMsgBatch &batch);
+    void updateMsgs(const QDltMsgBatch &batch);
+    void updateMsgsDecoded(const QDltMsgBatch &batch);
+
     /* QDltPluginControlInterface */
     bool initControl(QDltControl *control);
     bool initConnections(QStringList list);
@@ -121,13 +129,16 @@ public:
     bool isMsg(QDltMsg &msg, int triggeredByUser);
     bool decodeMsg(QDltMsg &msg, int triggeredByUser);
 
+    /* QDltPluginDecoderInterestInterface */
+    bool decoderInterest(QDltDecoderInterest &interest);
+
     /* internal variables */
     DltDbus::Form *form;
 
 private:
 
     void methodsAddMsg(QDltMsg &msg);
-    void segmentedMsg(QDltMsg &msg);
+    void segmentedMsg(int index, QDltMsg &msg);
     int check_logid( QString &tocheck, int index );
     bool plugin_is_active = false;
 
@@ -151,7 +162,11 @@ private:
 
     QString plugin_name_displayed = QString("DLT DBus Plugin");
     QHash<DltDbusMethodKey,QString> methods;
-    QMap<uint32_t,QDltSegmentedMsg*> segmentedMessages;
+    QDltSegmentReassembler segmentedMessages;
+
+    // log files and size of the reassembled segmented messages, kept when the same files are loaded again
+    QStringList segmentedFiles;
+    qint64 segmentedFileSize = 0;
 
 };
 
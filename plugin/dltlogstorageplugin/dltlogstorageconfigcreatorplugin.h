@@ -35,7 +35,7 @@ class DltLogstorageConfigCreatorPlugin : public QObject, QDLTPluginInterface, QD
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDltPluginViewerInterface)
 #ifdef QT5
-    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DltLogstorageConfigCreatorPlugin")
+    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DltLogstorageConfigCreatorPlugin" FILE "dltlogstorageconfigcreatorplugin.json")
 #endif
 
 public:
@@ -83,6 +83,10 @@ QStringList DltSystemViewerPlugin::infoConfig()
 QWidget* DltSystemViewerPlugin::initViewer()
 {
     form = new DltSystemViewer::Form();
+    connect(this, SIGNAL(processStat(int,int,QString,uint)), form, SLOT(addProcesses(int,int,QString,uint)));
+    connect(this, SIGNAL(cpuUser(int,QString)), form, SLOT(setUser(int,QString)));
+    connect(this, SIGNAL(cpuNice(int,QString)), form, SLOT(setNice(int,QString)));
+    connect(this, SIGNAL(cpuSystem(int,QString)), form, SLOT(setSystem(int,QString)));
     return form;
 }
 
@@ -99,8 +103,11 @@ void DltSystemViewerPlugin::initFileStart(QDltFile *file){
 
     dltFile = file;
 
+    /* the size is only read here in the GUI thread, the worker thread counts the messages */
     counterMessages = dltFile->size();
 
+    /* the workers are idle here, results of the last file still queued to the form are dropped */
+    form->setGeneration(generation.fetchAndAddOrdered(1) + 1);
     form->deleteAllProccesses();
 
 }
@@ -135,6 +142,41 @@ void DltSystemViewerPlugin::updateMsg(int index, QDltMsg &msg){
 void DltSystemViewerPlugin::updateMsgDecoded(int , QDltMsg &){
 //empty. Implemented because derived plugin interface functions are virtual.
 }
+
+void DltSystemViewerPlugin::initMsgs(const QDltMsgBatch &batch){
+
+    for(int num = 0; num < batch.size(); num++)
+        updateProcesses(batch[num].first, *batch[num].second);
+
+}
+
+void DltSystemViewerPlugin::initMsgsDecoded(const QDltMsgBatch &){
+//empty. Implemented because derived plugin interface functions are virtual.
+}
+
+void DltSystemViewerPlugin::updateMsgs(const QDltMsgBatch &batch){
+
+    if(!dltFile)
+        return;
+
+    for(int num = 0; num < batch.size(); num++)
+        updateProcesses(batch[num].first, *batch[num].second);
+
+    /* called in the worker thread, the file must not be accessed while the GUI thread is adding messages */
+    if(!batch.isEmpty())
+        counterMessages = batch.last().first + 1;
+
+}
+
+void DltSystemViewerPlugin::updateMsgsDecoded(const QDltMsgBatch &){
+//empty. Implemented because derived plugin interface functions are virtual.
+}
+
+bool DltSystemViewerPlugin::runInWorkerThread(){
+
+    return true;
+
+}
 void DltSystemViewerPlugin::updateFileFinish(){
 
 
@@ -167,7 +209,7 @@ void DltSystemViewerPlugin::updateProcesses(int , QDltMsg &msg)
             msg.getArgument(1,arg);
             if(arg.toString()=="stat") {
                 msg.getArgument(2,arg);
-                form->addProcesses(pid,arg.toString(),msg);
+                emit processStat(generation.load(),pid,arg.toString(),msg.getTimestamp());
             }
         }        
         if(msg.getApid()=="SYS" && msg.getCtid()=="STAT") {
@@ -176,9 +218,9 @@ void DltSystemViewerPlugin::updateProcesses(int , QDltMsg &msg)
             if( seq == PROC_STAT_NODE_1 || seq == PROC_STAT_NODE_UNDEFINE ) {
                 msg.getArgument(1,arg);
                 datalist = arg.toString().split(" ");
-                form->setUser(QString("%1").arg(((datalist.at(2).toInt())-lastValueUser)*10000/(msg.getTimestamp()-lastTimeStamp)));
-                form->setNice(QString("%1").arg(((datalist.at(3).toInt())-lastValueNice)*10000/(msg.getTimestamp()-lastTimeStamp)));
-                form->setSystem(QString("%1").arg(((datalist.at(4).toInt())-lastValueKernel)*10000/(msg.getTimestamp()-lastTimeStamp)));
+                emit cpuUser(generation.load(),QString("%1").arg(((datalist.at(2).toInt())-lastValueUser)*10000/(msg.getTimestamp()-lastTimeStamp)));
+                emit cpuNice(generation.load(),QString("%1").arg(((datalist.at(3).toInt())-lastValueNice)*10000/(msg.getTimestamp()-lastTimeStamp)));
+                emit cpuSystem(generation.load(),QString("%1").arg(((datalist.at(4).toInt())-lastValueKernel)*10000/(msg.getTimestamp()-lastTimeStamp)));
                 lastValueUser = datalist.at(2).toInt();
                 lastValueNice = datalist.at(3).toInt();;
                 lastValueKernel = datalist.at(4).toInt();;
@@ -21,18 +21,21 @@
 #define DLTSYSTEMVIEWERPLUGIN_H
 
 #include <QObject>
+#include <QAtomicInt>
 #include "plugininterface.h"
 #include "form.h"
 
 #define DLT_SYSTEM_VIEWER_PLUGIN_VERSION "1.0.0"
 
-class DltSystemViewerPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerInterface
+class DltSystemViewerPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerInterface, QDltPluginViewerBatchInterface, QDltPluginViewerWorkerInterface
 {
     Q_OBJECT
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDltPluginViewerInterface)
+    Q_INTERFACES(QDltPluginViewerBatchInterface)
+    Q_INTERFACES(QDltPluginViewerWorkerInterface)
 #ifdef QT5
-    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DltSystemViewerPlugin")
+    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DltSystemViewerPlugin" FILE "dltsystemviewerplugin.json")
 #endif
 
 public:
@@ -62,6 +65,15 @@ public:
     void selectedIdxMsg(int index, QDltMsg &msg);
     void selectedIdxMsgDecoded(int index, QDltMsg &msg);
 
+    /* QDltPluginViewerBatchInterface */
+    void initMsgs(const QDltMsgBatch &batch);
+    void initMsgsDecoded(const QDltMsgBatch &batch);
+    void updateMsgs(const QDltMsgBatch &batch);
+    void updateMsgsDecoded(const QDltMsgBatch &batch);
+
+    /* QDltPluginViewerWorkerInterface */
+    bool runInWorkerThread();
+
     /* internal variables */
     DltSystemViewer::Form *form;
     int counterMessages;
@@ -77,8 +89,19 @@ public:
 
     void updateProcesses(int index, QDltMsg &msg);
 
+signals:
+    /* the form is updated by queued signals, the messages are processed in a worker thread,
+       signals still queued from the last file are dropped by the form by the generation */
+    void processStat(int generation, int pid, QString data, unsigned int timestamp);
+    void cpuUser(int generation, QString text);
+    void cpuNice(int generation, QString text);
+    void cpuSystem(int generation, QString text);
+
 private:
     QDltFile *dltFile;
+
+    /* increased in the GUI thread with each new file, read by the worker thread */
+    QAtomicInt generation;
     QString errorText;
 };
 
@@ -39,6 +39,7 @@ Form::Form(QWidget *parent) :
     ui(new Ui::Form)
 {
     ui->setupUi(this);
+    generation = 0;
 }
 
 Form::~Form()
@@ -46,13 +47,16 @@ Form::~Form()
     delete ui;
 }
 
-void Form::addProcesses(int pid, QString data,QDltMsg &msg)
+void Form::addProcesses(int generation, int pid, QString data, unsigned int timestamp)
 {
     QStringList datalist;
     ProcessItem *widget;
     int found = 0;
     int procent = 0;
 
+    if(generation != this->generation)
+        return;
+
     datalist = data.split(" ");
 
     for(int num=0;num<ui->treeWidget->topLevelItemCount();num++) {
@@ -60,11 +64,11 @@ void Form::addProcesses(int pid, QString data,QDltMsg &msg)
         if(widget->text(0).toInt()==pid) {
             found = 1;
             //procent = datalist.at(13).toInt()-widget->text(2).toInt()+datalist.at(14).toInt()-widget->text(3).toInt();
-            procent = ((datalist.at(13).toInt())-widget->text(2).toInt()+datalist.at(14).toInt()-widget->text(3).toInt())*10000/(msg.getTimestamp()-widget->lastTimestamp);///4;
+            procent = ((datalist.at(13).toInt())-widget->text(2).toInt()+datalist.at(14).toInt()-widget->text(3).toInt())*10000/(timestamp-widget->lastTimestamp);///4;
             widget->setText(2,datalist.at(13));
             widget->setText(3,datalist.at(14));
             widget->setText(4,QString("%1").arg(procent));
-            widget->lastTimestamp = msg.getTimestamp();
+            widget->lastTimestamp = timestamp;
             break;
         }
     }
@@ -91,17 +95,26 @@ void Form::on_pushButtonClear_clicked()
     ui->treeWidget->clear();
 }
 
-void Form::setUser(QString text)
+void Form::setUser(int generation, QString text)
 {
+    if(generation != this->generation)
+        return;
+
     ui->lineEditUser->setText(text);
 }
 
-void Form::setNice(QString text)
+void Form::setNice(int generation, QString text)
 {
+    if(generation != this->generation)
+        return;
+
     ui->lineEditNice->setText(text);
 }
 
-void Form::setSystem(QString text)
+void Form::setSystem(int generation, QString text)
 {
+    if(generation != this->generation)
+        return;
+
     ui->lineEditSystem->setText(text);
 }
@@ -47,19 +47,24 @@ public:
     explicit Form(QWidget *parent = 0);
     ~Form();
 
-    void addProcesses(int pid, QString data,QDltMsg &msg);
+    void deleteAllProccesses();
 
-    void setUser(QString text);
-    void setNice(QString text);
-    void setSystem(QString text);
+    /* only results of this generation of the plugin are shown */
+    void setGeneration(int generation) { this->generation = generation; }
 
-    void deleteAllProccesses();
+public slots:
+    void addProcesses(int generation, int pid, QString data, unsigned int timestamp);
+
+    void setUser(int generation, QString text);
+    void setNice(int generation, QString text);
+    void setSystem(int generation, QString text);
 
 private slots:
     void on_pushButtonClear_clicked();
 
 private:
     Ui::Form *ui;
+    int generation;
 
 };
 
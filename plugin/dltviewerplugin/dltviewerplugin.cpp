@@ -194,6 +194,19 @@ void DltViewerPlugin::updateMsgDecoded(int , QDltMsg &){
 void DltViewerPlugin::updateFileFinish(){
 }
 
+/* the plugin only shows the selected message, batches avoid one call per received message */
+void DltViewerPlugin::initMsgs(const QDltMsgBatch &){
+}
+
+void DltViewerPlugin::initMsgsDecoded(const QDltMsgBatch &){
+}
+
+void DltViewerPlugin::updateMsgs(const QDltMsgBatch &){
+}
+
+void DltViewerPlugin::updateMsgsDecoded(const QDltMsgBatch &){
+}
+
 QString DltViewerPlugin::stringToHtml(QString str)
 {
     str = str.replace("<","&#60;");
@@ -26,13 +26,14 @@
 
 #define DLT_VIEWER_PLUGIN_VERSION "1.0.1"
 
-class DltViewerPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerInterface
+class DltViewerPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerInterface, QDltPluginViewerBatchInterface
 {
     Q_OBJECT
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDltPluginViewerInterface)
+    Q_INTERFACES(QDltPluginViewerBatchInterface)
 #ifdef QT5
-    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DltViewerPlugin")
+    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DltViewerPlugin" FILE "dltviewerplugin.json")
 #endif
 
 public:
@@ -62,6 +63,12 @@ public:
     void selectedIdxMsg(int index, QDltMsg &msg);
     void selectedIdxMsgDecoded(int index, QDltMsg &msg);
 
+    /* QDltPluginViewerBatchInterface */
+    void initMsgs(const QDltMsgBatch &batch);
+    void initMsgsDecoded(const QDltMsgBatch &batch);
+    void updateMsgs(const QDltMsgBatch &batch);
+    void updateMsgsDecoded(const QDltMsgBatch &batch);
+
     /* internal variables */
     DltViewer::Form *form;
 
@@ -31,7 +31,7 @@ class DummyCommandPlugin : public QObject, QDLTPluginInterface, QDltPluginComman
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDltPluginCommandInterface)
 #ifdef QT5
-    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DummyCommandPlugin")
+    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DummyCommandPlugin" FILE "dummycommandplugin.json")
 #endif
 
 public:
@@ -33,7 +33,7 @@ class DummyControlPlugin : public QObject, QDLTPluginInterface, QDltPluginViewer
     Q_INTERFACES(QDltPluginViewerInterface)
     Q_INTERFACES(QDltPluginControlInterface)
 #ifdef QT5
-    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DummyControlPlugin")
+    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DummyControlPlugin" FILE "dummycontrolplugin.json")
 #endif
 
 public:
@@ -31,7 +31,7 @@ class DummyDecoderPlugin : public QObject, QDLTPluginInterface, QDLTPluginDecode
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDLTPluginDecoderInterface)
 #ifdef QT5
-    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DummyDecoderPlugin")
+    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DummyDecoderPlugin" FILE "dummydecoderplugin.json")
 #endif
 
 public:
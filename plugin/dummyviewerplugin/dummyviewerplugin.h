@@ -32,7 +32,7 @@ class DummyViewerPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerI
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDltPluginViewerInterface)
 #ifdef QT5
-    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DummyViewerPlugin")
+    Q_PLUGIN_METADATA(IID "org.genivi.DLT.DummyViewerPlugin" FILE "dummyviewerplugin.json")
 #endif
 
 public:
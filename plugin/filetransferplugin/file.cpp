@@ -21,8 +21,37 @@
 #include <iostream>
 #include <fstream>
 #include <QDebug>
+#include <QMap>
+#include <QThreadPool>
+#include <QRunnable>
+#include <QApplication>
+#include <QProgressDialog>
+#include <QAtomicInt>
 using namespace std;
 
+// saves the files with the same path in a thread of the pool,
+// the task works on copies, so the file items may change while it is running
+class FileSaveTask : public QRunnable
+{
+public:
+    FileSaveTask(QDltFile *dltFile, const QList<FileSaveJob> &jobs, bool *results, QAtomicInt *saved)
+        : dltFile(dltFile), jobs(jobs), results(results), saved(saved) {}
+
+    void run()
+    {
+        for(int num = 0; num < jobs.size(); num++){
+            results[jobs[num].result] = File::savePackages(dltFile, jobs[num].packages, jobs[num].sizeInBytes, jobs[num].path);
+            saved->ref();
+        }
+    }
+
+private:
+    QDltFile *dltFile;
+    QList<FileSaveJob> jobs;
+    bool *results;
+    QAtomicInt *saved;
+};
+
 
 File::File():QTreeWidgetItem()
 {
@@ -31,7 +60,6 @@ File::File():QTreeWidgetItem()
     receivedPackages = 0;
     sizeInBytes = 0;
     buffer = 0;
-    dltFileIndex = NULL;
     dltFile = NULL;
     fileData = NULL;
 }
@@ -44,7 +72,6 @@ File::File(QDltFile *qfile,QTreeWidgetItem *parent):QTreeWidgetItem(parent)
     receivedPackages = 0;
     sizeInBytes = 0;
     buffer = 0;
-    dltFileIndex = NULL;
     dltFile = qfile;
     fileData = NULL;
 
@@ -109,7 +136,7 @@ void File::setFileSerialNumber(QString s)
 
 void File::setPackages(QString p){
     packages = p.toUInt();
-    dltFileIndex = new QList<int>[packages];
+    dltFilePackages.fill(FilePackage(), packages);
     this->setText(COLUMN_PACKAGES, p);
 }
 void File::increaseReceivedPackages(){
@@ -159,16 +186,25 @@ bool File::isComplete(){
     return receivedPackages == packages;
 }
 
-void File::setQFileIndexForPackage(QString packageNumber, int index){
+void File::setQFileIndexForPackage(QString packageNumber, int index, int offset, int size){
     int i = packageNumber.toInt();
-    dltFileIndex->insert(i-1,index);
+    if(i < 1 || i > dltFilePackages.size() || dltFilePackages[i-1].index >= 0){
+        // invalid or repeated package
+        return;
+    }
+    FilePackage &package = dltFilePackages[i-1];
+    package.index = index;
+    package.offset = offset;
+    package.size = size;
     increaseReceivedPackages();
 }
 
 
 bool File::saveFile(QString newFile){
+    return savePackages(dltFile, dltFilePackages, sizeInBytes, newFile);
+}
 
-    //QString newFile = directory.append("/").append(getFilename());
+bool File::savePackages(QDltFile *dltFile, const QVector<FilePackage> &packages, qint64 sizeInBytes, const QString &newFile){
 
     if(QFile::exists(newFile)){
         if(!QFile::remove(newFile)){
@@ -176,45 +212,94 @@ bool File::saveFile(QString newFile){
         }
     }
 
-    QByteArray *completeFileData = getFileData();
-
     QFile file(newFile);
     if (!file.open(QIODevice::WriteOnly)){
-        freeFile();
         return false;
     }
 
-    QDataStream stream( &file );
-    int writtenBytes = stream.writeRawData(*completeFileData,completeFileData->size());
+    // the data of each package is copied from the dlt file to the new file in package order,
+    // the messages are not read and parsed again
+    qint64 writtenBytes = 0;
+    for(int i = 0; i < packages.size(); i++){
+        const FilePackage &package = packages[i];
+        int num;
+        qint64 pos,length;
+        if(package.index < 0 || !dltFile->getMsgRange(package.index,num,pos,length) || package.offset+package.size > length){
+            break;
+        }
+        if(!dltFile->copyRange(num,pos+package.offset,package.size,file)){
+            break;
+        }
+        writtenBytes += package.size;
+    }
 
     file.close();
 
-    freeFile();
-
-    if((unsigned int)writtenBytes != sizeInBytes){
+    if(writtenBytes != sizeInBytes){
         return false;
     }
 
     return true;
 }
 
+QVector<bool> File::saveFiles(const QList<File*> &files, const QStringList &paths, QWidget *parent){
+    static bool saving = false;
+    QVector<bool> results(files.size(), false);
+    QMap<QString,QList<FileSaveJob> > jobsByPath;
+
+    // the progress dialog processes events, a second save must not start meanwhile
+    if(saving || files.isEmpty()){
+        return results;
+    }
+
+    // copy everything the tasks need, the items are not accessed after the tasks started
+    for(int num = 0; num < files.size(); num++){
+        FileSaveJob job;
+        job.result = num;
+        job.path = paths[num];
+        job.packages = files[num]->dltFilePackages;
+        job.sizeInBytes = files[num]->sizeInBytes;
+        jobsByPath[paths[num]].append(job);
+    }
+    QDltFile *dltFile = files[0]->dltFile;
+
+    saving = true;
+
+    QAtomicInt saved;
+    QThreadPool pool;
+    for(QMap<QString,QList<FileSaveJob> >::const_iterator it = jobsByPath.constBegin(); it != jobsByPath.constEnd(); ++it){
+        pool.start(new FileSaveTask(dltFile,it.value(),results.data(),&saved));
+    }
+
+    // the modal dialog blocks the user interface while the files are written
+    QProgressDialog progress("Saving files...", QString(), 0, files.size(), parent);
+    progress.setWindowTitle("Filetransfer Plugin");
+    progress.setWindowModality(Qt::ApplicationModal);
+    progress.setMinimumDuration(500);
+    while(!pool.waitForDone(50)){
+        progress.setValue(saved.load());
+        QApplication::processEvents();
+    }
+    progress.setValue(files.size());
+
+    saving = false;
+
+    return results;
+}
+
 void File::freeFile(){
     delete fileData;
+    fileData = NULL;
 }
 
 QByteArray* File::getFileData(){
-   QDltMsg msg;
-   QByteArray msgBuffer;
-   QDltArgument data;
-
-   fileData = new QByteArray();
-
-    for(unsigned int i=0; i<packages;i++){
-       int qfileIdx = dltFileIndex->value(i);
-       msgBuffer =  dltFile->getMsg(qfileIdx);
-       msg.setMsg(msgBuffer);
-       msg.getArgument(PROTOCOL_FLDA_DATA,data);
-       fileData->append(data.getData());
+    delete fileData;
+    fileData = new QByteArray();
+    fileData->reserve(sizeInBytes);
+
+    for(int i=0; i<dltFilePackages.size();i++){
+       const FilePackage &package = dltFilePackages[i];
+       fileData->append(dltFile->getMsg(package.index).mid(package.offset,package.size));
     }
 
     return fileData;
@@ -25,9 +25,31 @@
 #include <QFile>
 #include <QDir>
 #include <QList>
+#include <QVector>
 #include "globals.h"
 #include "qdlt.h"
 
+// location of the data of one package in the dlt file, recorded when the FLDA message is processed
+class FilePackage
+{
+public:
+    FilePackage() : index(-1), offset(0), size(0) {}
+
+    int index;      // index of the FLDA message in the dlt file, -1 if not received
+    int offset;     // offset of the data in the message including the storage header
+    int size;       // size of the data in bytes
+};
+
+// copy of the data needed to save one file in a worker thread
+class FileSaveJob
+{
+public:
+    int result;     // index of the file in the list passed to File::saveFiles()
+    QString path;
+    QVector<FilePackage> packages;
+    qint64 sizeInBytes;
+};
+
 class File : public QTreeWidgetItem
 {
 
@@ -60,10 +82,17 @@ public:
      void errorHappens(QString filename, QString errorCode1, QString errorCode2, QString time);
 
      bool isComplete();
-     void setQFileIndexForPackage(QString packageNumber, int index);
+     void setQFileIndexForPackage(QString packageNumber, int index, int offset, int size);
 
      bool saveFile(QString newFile);
 
+     // write the data of the packages, used for saving in a worker thread
+     static bool savePackages(QDltFile *dltFile, const QVector<FilePackage> &packages, qint64 sizeInBytes, const QString &newFile);
+
+     // save several files in parallel behind a modal progress dialog, files with the same path are saved one after the other,
+     // all results are false if a save is already running
+     static QVector<bool> saveFiles(const QList<File*> &files, const QStringList &paths, QWidget *parent = 0);
+
      QByteArray* getFileData();
 
 private:
@@ -75,7 +104,7 @@ private:
     unsigned int sizeInBytes;
     unsigned int buffer;
 
-    QList<int> *dltFileIndex;
+    QVector<FilePackage> dltFilePackages;
     QDltFile *dltFile;
     QByteArray *fileData;
 };
@@ -30,6 +30,7 @@ FiletransferPlugin::FiletransferPlugin()
 {
     form = NULL;
     dltFile = NULL;
+    dltControl = NULL;
 }
 
 FiletransferPlugin::~FiletransferPlugin()
@@ -118,7 +119,7 @@ bool FiletransferPlugin::loadConfig(QString filename)
     }
     if (xml.hasError())
     {
-      if ( dltControl->silentmode == true )
+      if ( !dltControl || dltControl->silentmode == true )
       {
        qDebug() << plugin_name_displayed << QString("XML Parser error %1 at line %2").arg(xml.errorString()).arg(xml.lineNumber());
       }
@@ -218,6 +219,50 @@ void FiletransferPlugin::updateFileFinish(){
 
 }
 
+void FiletransferPlugin::initMsgs(const QDltMsgBatch &batch)
+{
+    updateFiletransferBatch(batch);
+}
+
+void FiletransferPlugin::initMsgsDecoded(const QDltMsgBatch &)
+{
+//empty. Implemented because derived plugin interface functions are virtual.
+}
+
+void FiletransferPlugin::updateMsgs(const QDltMsgBatch &batch)
+{
+    updateFiletransferBatch(batch);
+}
+
+void FiletransferPlugin::updateMsgsDecoded(const QDltMsgBatch &)
+{
+//empty. Implemented because derived plugin interface functions are virtual.
+}
+
+void FiletransferPlugin::updateFiletransferBatch(const QDltMsgBatch &batch)
+{
+    if(!dltFile)
+    {
+        return;
+    }
+
+    // the ids are looked up once per batch, only file transfer messages are parsed
+    QString apid = config.getFlAppIdTag();
+    QString ctid = config.getFlCtIdTag();
+
+    for(int num = 0; num < batch.size(); num++)
+    {
+        QDltMsg &msg = *batch[num].second;
+
+        if(msg.getType() != QDltMsg::DltTypeLog || msg.getApid() != apid || msg.getCtid() != ctid)
+        {
+            continue;
+        }
+
+        updateFiletransfer(batch[num].first, msg);
+    }
+}
+
 void FiletransferPlugin::updateFiletransfer(int index, QDltMsg &msg)
 {
 
@@ -256,7 +301,7 @@ void FiletransferPlugin::updateFiletransfer(int index, QDltMsg &msg)
             msg.getArgument(PROTOCOL_FLDA_ENDFLAG,msgLastArgument);
             if(msgLastArgument.toString().compare(config.getFldaTag()) == 0)
             {
-                doFLDA(index,&msg);
+                doFLDA(index,&msg,msgLastArgument);
             }
             return;
      }
@@ -354,7 +399,7 @@ void FiletransferPlugin::doFLST(QDltMsg *msg)
   return;
 }
 
-void FiletransferPlugin::doFLDA(int index,QDltMsg *msg)
+void FiletransferPlugin::doFLDA(int index,QDltMsg *msg,const QDltArgument &endFlag)
 {
     QDltArgument argument;
     msg->getArgument(PROTOCOL_FLDA_FILEID,argument);
@@ -374,7 +419,13 @@ void FiletransferPlugin::doFLDA(int index,QDltMsg *msg)
             QDltArgument packageNumber;
             msg->getArgument(PROTOCOL_FLDA_PACKAGENR,packageNumber);
 
-            file->setQFileIndexForPackage(packageNumber.toString(),index);
+            // the data is stored at the end of the argument before the end flag
+            QDltArgument data;
+            msg->getArgument(PROTOCOL_FLDA_DATA,data);
+            int size = data.getDataSize();
+            int offset = msg->getHeaderSize() + endFlag.getOffsetPayload() - size;
+
+            file->setQFileIndexForPackage(packageNumber.toString(),index,offset,size);
         }
     }
   return;
@@ -489,26 +540,36 @@ bool FiletransferPlugin::exportAll(QDir extract_dir)
         errorText = " - No filetransfer files in the loaded DLT file.";
         return false;
     }
+    QList<File*> files;
+    QStringList paths;
+    QStringList targets;
     while (*it)
     {
         File *tmp = dynamic_cast<File*>(*it);
         if (tmp != NULL && tmp->isComplete())
         {
-
-            QString absolutePath = extract_dir.filePath(tmp->getFilename());
-
-            if(!tmp->saveFile(absolutePath) )
-            {
-                ret = false;
-                errorText += ", " + tmp->getFilenameOnTarget();
-            }
-            else
-            {
-                qDebug() << "Exported: " << absolutePath;
-            }
+            files.append(tmp);
+            paths.append(extract_dir.filePath(tmp->getFilename()));
+            targets.append(tmp->getFilenameOnTarget());
         }
         ++it;
-        QApplication::processEvents();
+    }
+
+    // independent files are extracted in parallel
+    form->setEnabled(false);
+    QVector<bool> results = File::saveFiles(files,paths,form);
+    form->setEnabled(true);
+    for(int num = 0; num < targets.size(); num++)
+    {
+        if(!results[num])
+        {
+            ret = false;
+            errorText += ", " + targets[num];
+        }
+        else
+        {
+            qDebug() << "Exported: " << paths[num];
+        }
     }
     return ret;
 }
@@ -28,15 +28,16 @@
 
 #define FILETRANSFER_PLUGIN_VERSION "1.2.1"
 
-class FiletransferPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerInterface, QDltPluginCommandInterface, QDltPluginControlInterface
+class FiletransferPlugin : public QObject, QDLTPluginInterface, QDltPluginViewerInterface, QDltPluginCommandInterface, QDltPluginControlInterface, QDltPluginViewerBatchInterface
 {
     Q_OBJECT
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDltPluginViewerInterface)
     Q_INTERFACES(QDltPluginCommandInterface)
     Q_INTERFACES(QDltPluginControlInterface)
+    Q_INTERFACES(QDltPluginViewerBatchInterface)
 #ifdef QT5
-    Q_PLUGIN_METADATA(IID "org.genivi.DLT.FileTransferPlugin")
+    Q_PLUGIN_METADATA(IID "org.genivi.DLT.FileTransferPlugin" FILE "filetransferplugin.json")
 #endif
 
 public:
@@ -66,6 +67,13 @@ public:
     void selectedIdxMsg(int index, QDltMsg &msg);
     void selectedIdxMsgDecoded(int index, QDltMsg &msg);
 
+    /* QDltPluginViewerBatchInterface */
+    void initMsgs(const QDltMsgBatch &batch);
+    void initMsgsDecoded(const QDltMsgBatch &batch);
+    void updateMsgs(const QDltMsgBatch &batch);
+    void updateMsgsDecoded(const QDltMsgBatch &batch);
+    void updateFiletransferBatch(const QDltMsgBatch &batch);
+
     void updateFiletransfer(int index, QDltMsg &msg);
     void show(bool value);
 
@@ -90,7 +98,7 @@ private:
     bool plugin_is_active = false;
 
     void doFLST(QDltMsg *msg);
-    void doFLDA(int index, QDltMsg *msg);
+    void doFLDA(int index, QDltMsg *msg, const QDltArgument &endFlag);
     void doFLFI(QDltMsg *msg);
     void doFLIF(QDltMsg *msg);
     void doFLER(QDltMsg *msg);
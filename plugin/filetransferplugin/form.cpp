@@ -172,6 +172,10 @@ void Form::savetofile()
         QString absolutePath;
         QString FiletoSave;
         File *tmpfile;
+        QList<File*> filesToSave;
+        QStringList pathsToSave;
+        QStringList namesToSave;
+        QStringList targetsToSave;
         unsigned int number_of_saved_files=0;
         msgBox.setWindowTitle("Filetransfer Plugin");
         bool errorOccured = true;
@@ -206,26 +210,10 @@ void Form::savetofile()
             {
                 FiletoSave = tmpfile->getFilename();
                 absolutePath = path+"//"+FiletoSave;
-                if(!tmpfile->saveFile(absolutePath) )
-                {
-                    qDebug()<< "File save incomplete: " <<  FiletoSave;
-                    text = ("File save incomplete");
-                    infoText ="The selected file "+FiletoSave+ " was not saved to "+path+".\n";
-                    detailedText = tmpfile->getFilenameOnTarget() + "\n";
-                    msgBox.setIcon(QMessageBox::Critical);
-                    msgBox.setText(text);
-                    msgBox.setInformativeText(infoText);
-                    msgBox.setDetailedText(detailedText);
-                    msgBox.setStandardButtons(QMessageBox::Ok);
-                    msgBox.setDefaultButton(QMessageBox::Ok);
-                    msgBox.exec();
-                }
-                else
-                {
-                    qDebug()<< "Successfully saved " <<  FiletoSave;
-                    number_of_saved_files++;
-                    errorOccured = false; // we indicate that at least one file save was successful
-                }
+                filesToSave.append(tmpfile);
+                pathsToSave.append(absolutePath);
+                namesToSave.append(FiletoSave);
+                targetsToSave.append(tmpfile->getFilenameOnTarget());
             }
             else // file is not marked
             {
@@ -235,6 +223,36 @@ void Form::savetofile()
             ++it;
         } // while
 
+        // the selected files are saved in parallel, the items must not be used afterwards,
+        // they may have been replaced while the progress dialog was shown
+        setEnabled(false);
+        QVector<bool> results = File::saveFiles(filesToSave,pathsToSave,this);
+        setEnabled(true);
+        for (int num = 0; num < namesToSave.size(); num++)
+        {
+            FiletoSave = namesToSave[num];
+            if(!results[num])
+            {
+                qDebug()<< "File save incomplete: " <<  FiletoSave;
+                text = ("File save incomplete");
+                infoText ="The selected file "+FiletoSave+ " was not saved to "+path+".\n";
+                detailedText = targetsToSave[num] + "\n";
+                msgBox.setIcon(QMessageBox::Critical);
+                msgBox.setText(text);
+                msgBox.setInformativeText(infoText);
+                msgBox.setDetailedText(detailedText);
+                msgBox.setStandardButtons(QMessageBox::Ok);
+                msgBox.setDefaultButton(QMessageBox::Ok);
+                msgBox.exec();
+            }
+            else
+            {
+                qDebug()<< "Successfully saved " <<  FiletoSave;
+                number_of_saved_files++;
+                errorOccured = false; // we indicate that at least one file save was successful
+            }
+        }
+
        if(false == errorOccured ) // no error
         {
             msgBox.setIcon(QMessageBox::Information);
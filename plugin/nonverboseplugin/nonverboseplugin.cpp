@@ -21,6 +21,8 @@
 #include <QMessageBox>
 #include <QDir>
 
+#include <algorithm>
+
 #include "nonverboseplugin.h"
 #include "dlt_protocol.h"
 #include "dlt_user.h"
@@ -99,9 +101,14 @@ void NonverbosePlugin::clear()
     pdumap.clear();
 
     foreach(DltFibexFrame *frame, framemapwithkey)
+    {
+        qDeleteAll(frame->pdureflist);
         delete frame;
+    }
     framemapwithkey.clear();
     framemap.clear();
+    framemapbyid.clear();
+    framemapbyidkey.clear();
 }
 
 bool NonverbosePlugin::parseFile(QString filename)
@@ -435,23 +442,103 @@ bool NonverbosePlugin::parseFile(QString filename)
         ret = true;//it is not breaking the plugin functionality, but could cause wrong decoding.
     }
 
-    /* create PDU Ref links */
-    foreach(DltFibexFrame *frame, framemap)
+    /* create PDU Ref links and decode steps */
+    compileFrames();
+
+    return ret;
+}
+
+bool NonverbosePlugin::packIds(const QString &appid, const QString &ctid, uint64_t &packed)
+{
+    if(appid.size() > 4 || ctid.size() > 4)
+        return false;
+
+    packed = 0;
+    for(int num=0;num<appid.size();num++)
+        packed |= ((uint64_t)(appid[num].unicode() & 0xff)) << (56-num*8);
+    for(int num=0;num<ctid.size();num++)
+        packed |= ((uint64_t)(ctid[num].unicode() & 0xff)) << (24-num*8);
+
+    return true;
+}
+
+void NonverbosePlugin::compileFrames()
+{
+    framemapbyid.clear();
+    framemapbyidkey.clear();
+
+    foreach(DltFibexFrame *frame, framemapwithkey)
     {
+        /* link PDUs */
+        frame->decodeSteps.clear();
         foreach(DltFibexPduRef *ref, frame->pdureflist)
         {
-            foreach(DltFibexPdu *pdu, pdumap)
+            ref->ref = pdumap.value(ref->id);
+
+            DltFibexPdu *pdu = ref->ref;
+            if(!pdu)
+                continue;
+
+            /* precompute how the argument is created */
+            DltFibexDecodeStep step;
+            if(!pdu->description.isEmpty())
             {
-                if(pdu->id == ref->id)
-                {
-                    ref->ref = pdu;
-                    break;
-                }
+                step.step = DltFibexDecodeStep::StepDescription;
+                step.typeInfo = QDltArgument::DltTypeInfoStrg;
+                step.description.append(pdu->description);
             }
+            else
+            {
+                step.typeInfo = (QDltArgument::DltTypeInfoDef)(pdu->typeInfo);
+                step.byteLength = pdu->byteLength;
+                if( (pdu->typeInfo == QDltArgument::DltTypeInfoStrg) || (pdu->typeInfo == QDltArgument::DltTypeInfoRawd) || (pdu->typeInfo == QDltArgument::DltTypeInfoUtf8))
+                    step.step = DltFibexDecodeStep::StepLengthPrefixed;
+                else
+                    step.step = DltFibexDecodeStep::StepFixedLength;
+            }
+            frame->decodeSteps.append(step);
         }
+
+        /* frames are found by the message id "ID_<number>" */
+        bool ok = false;
+        frame->hasMessageId = false;
+        if(frame->id.startsWith("ID_"))
+            frame->messageId = frame->id.mid(3).toUInt(&ok);
+        if(!ok)
+            continue;
+        frame->hasMessageId = true;
+
+        uint64_t appctid;
+        if(packIds(frame->appid,frame->ctid,appctid))
+            framemapbyidkey[DltFibexIdKey(frame->messageId,appctid)] = frame;
     }
 
-    return ret;
+    /* lookup by message id only uses the first frame of each id */
+    foreach(DltFibexFrame *frame, framemap)
+    {
+        if(frame->hasMessageId)
+            framemapbyid[frame->messageId] = frame;
+    }
+}
+
+DltFibexFrame *NonverbosePlugin::findFrame(const QDltMsg &msg)
+{
+    QString apid = msg.getApid();
+    QString ctid = msg.getCtid();
+
+    if(apid.isEmpty() || ctid.isEmpty())
+    {
+        // search only for id
+        return framemapbyid.value(msg.getMessageId());
+    }
+
+    // search in full key, if msg already contains AppId and CtId
+    uint64_t appctid;
+    if(packIds(apid,ctid,appctid))
+        return framemapbyidkey.value(DltFibexIdKey(msg.getMessageId(),appctid));
+
+    // ids longer than four characters are not packed
+    return framemapwithkey.value(DltFibexKey(QString("ID_%1").arg(msg.getMessageId()),apid,ctid));
 }
 
 bool NonverbosePlugin::saveConfig(QString /*filename*/)
@@ -500,14 +587,31 @@ bool NonverbosePlugin::isMsg(QDltMsg &msg, int triggeredByUser)
         return false;
     }
 
-    QString idtext = QString("ID_%1").arg(msg.getMessageId());
+    return findFrame(msg) != 0;
+}
 
-    if(!msg.getApid().isEmpty() && !msg.getCtid().isEmpty())
-        // search in full key, if msg already contains AppId and CtId
-        return framemapwithkey.contains(DltFibexKey(idtext,msg.getApid(),msg.getCtid()));
-    else
-        // search only for id
-        return framemap.contains(idtext);
+bool NonverbosePlugin::decoderInterest(QDltDecoderInterest &interest)
+{
+    /* only non-verbose messages with a message id of a frame */
+    interest.verbose = false;
+
+    QList<uint32_t> ids;
+    foreach(DltFibexFrame *frame, framemapwithkey)
+    {
+        if(frame->hasMessageId)
+            ids.append(frame->messageId);
+    }
+    std::sort(ids.begin(),ids.end());
+
+    for(int num=0;num<ids.size();num++)
+    {
+        if(!interest.messageIdRanges.isEmpty() && ids[num] <= interest.messageIdRanges.last().second + 1)
+            interest.messageIdRanges.last().second = ids[num];
+        else
+            interest.messageIdRanges.append(qMakePair((unsigned int)ids[num],(unsigned int)ids[num]));
+    }
+
+    return true;
 }
 
 bool NonverbosePlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
@@ -526,18 +630,7 @@ bool NonverbosePlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
         return false;
     }
 
-    QString idtext = QString("ID_%1").arg(msg.getMessageId());
-    DltFibexFrame *frame;
-    if(!msg.getApid().isEmpty() && !msg.getCtid().isEmpty())
-    {
-        // search in full key, if msg already contains AppId and CtId
-        frame = framemapwithkey[DltFibexKey(idtext,msg.getApid(),msg.getCtid())];
-    }
-    else
-    {
-        // search only for id
-        frame = framemap[idtext];
-    }
+    DltFibexFrame *frame = findFrame(msg);
     if(!frame)
             return false;
 
@@ -555,50 +648,42 @@ bool NonverbosePlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
     msg.setType((QDltMsg::DltTypeDef)(frame->messageType));
     msg.setSubtype(frame->messageInfo);
     QByteArray payload = msg.getPayload();
+    QDltMsg::DltEndiannessDef endianness = msg.getEndianness();
 
-    /* Look for all PDUs for this message */
-    for (int i=0;i < frame->pdureflist.size();i++)
+    /* Run the precompiled decode steps of this message */
+    for (int i=0;i < frame->decodeSteps.size();i++)
     {
+        const DltFibexDecodeStep &step = frame->decodeSteps[i];
         QDltArgument argument;
-        QByteArray data;
         unsigned short length;
-        DltFibexPdu *pdu = frame->pdureflist[i]->ref;
-        if(pdu)
-        {
-            if(!pdu->description.isEmpty()) {
-                argument.setTypeInfo(QDltArgument::DltTypeInfoStrg);
-                argument.setEndianness(msg.getEndianness());
-                argument.setOffsetPayload(offset);
-                data.append(pdu->description);
-                argument.setData(data);
-            }
-            else {
-                argument.setTypeInfo((QDltArgument::DltTypeInfoDef)(pdu->typeInfo));
-                argument.setEndianness(msg.getEndianness());
-                argument.setOffsetPayload(offset);
-
-                if( (pdu->typeInfo == QDltArgument::DltTypeInfoStrg) || (pdu->typeInfo == QDltArgument::DltTypeInfoRawd) || (pdu->typeInfo == QDltArgument::DltTypeInfoUtf8))
-                {
-                    if((unsigned int)payload.size()<(offset+sizeof(unsigned short)))
-                        break;
-                    if(argument.getEndianness() == QDltMsg::DltEndiannessLittleEndian)
-                        length = *((unsigned short*) (payload.constData()+offset));
-                    else
-                        length = DLT_SWAP_16(*((unsigned short*) (payload.constData()+offset)));
-                    offset += sizeof(unsigned short);
-                    argument.setData(payload.mid(offset,length));
-                    offset += length;
-                }
-                else
-                {
-                    argument.setData(payload.mid(offset,pdu->byteLength));
-                    offset += pdu->byteLength;
-                }
 
-            }
+        argument.setTypeInfo(step.typeInfo);
+        argument.setEndianness(endianness);
+        argument.setOffsetPayload(offset);
 
-            msg.addArgument(argument);
+        switch(step.step)
+        {
+        case DltFibexDecodeStep::StepDescription:
+            argument.setData(step.description);
+            break;
+        case DltFibexDecodeStep::StepLengthPrefixed:
+            if((unsigned int)payload.size()<(offset+sizeof(unsigned short)))
+                return true;
+            if(endianness == QDltMsg::DltEndiannessLittleEndian)
+                length = *((unsigned short*) (payload.constData()+offset));
+            else
+                length = DLT_SWAP_16(*((unsigned short*) (payload.constData()+offset)));
+            offset += sizeof(unsigned short);
+            argument.setData(payload.mid(offset,length));
+            offset += length;
+            break;
+        case DltFibexDecodeStep::StepFixedLength:
+            argument.setData(payload.mid(offset,step.byteLength));
+            offset += step.byteLength;
+            break;
         }
+
+        msg.addArgument(argument);
     }
 
     return true;
@@ -22,6 +22,7 @@
 
 #include <QObject>
 #include <QHash>
+#include <QVector>
 #include "plugininterface.h"
 
 #if defined(_MSC_VER)
@@ -61,6 +62,32 @@ inline uint qHash(const DltFibexKey &key)
     return qHash(key.id) ^ qHash(key.appid) ^ qHash(key.ctid);
 }
 
+/**
+ * Integer key of a Fibex Frame, message id and the packed AppId and CtId.
+ */
+class DltFibexIdKey
+{
+public:
+    DltFibexIdKey(uint32_t id,uint64_t appctid)
+    {
+        this->id = id;
+        this->appctid = appctid;
+    }
+
+    uint32_t id;
+    uint64_t appctid;
+};
+
+inline bool operator==(const DltFibexIdKey &e1, const DltFibexIdKey &e2)
+{
+    return (e1.id == e2.id) && (e1.appctid == e2.appctid);
+}
+
+inline uint qHash(const DltFibexIdKey &key)
+{
+    return qHash(key.appctid) ^ (key.id * 0x9E3779B1u);
+}
+
 /**
  * The structure of a Fibex PDU information.
  */
@@ -84,13 +111,29 @@ public:
         DltFibexPdu *ref;
  };
 
+ /**
+ * One precompiled step to decode an argument of a Fibex Frame.
+ */
+class DltFibexDecodeStep
+{
+public:
+    typedef enum { StepDescription, StepFixedLength, StepLengthPrefixed } StepDef;
+
+    DltFibexDecodeStep() { step=StepFixedLength;typeInfo=QDltArgument::DltTypeInfoUnknown;byteLength=0; }
+
+        StepDef step;
+        QDltArgument::DltTypeInfoDef typeInfo;
+        int32_t byteLength;
+        QByteArray description;
+};
+
  /**
  * The structure of a Fibex Frame information.
  */
 class DltFibexFrame
 {
 public:
-    DltFibexFrame() { byteLength=0;messageType=0;messageInfo=0;pduRefCounter=0; }
+    DltFibexFrame() { byteLength=0;messageType=0;messageInfo=0;pduRefCounter=0;messageId=0;hasMessageId=false; }
 
         QString id;
         int32_t byteLength;
@@ -101,15 +144,21 @@ public:
 
         QList<DltFibexPduRef*> pdureflist;
         uint32_t pduRefCounter;
+
+        /* created by compileFrames() */
+        uint32_t messageId;
+        bool hasMessageId;
+        QVector<DltFibexDecodeStep> decodeSteps;
 };
 
-class NonverbosePlugin : public QObject, QDLTPluginInterface, QDLTPluginDecoderInterface
+class NonverbosePlugin : public QObject, QDLTPluginInterface, QDLTPluginDecoderInterface, QDltPluginDecoderInterestInterface
 {
     Q_OBJECT
     Q_INTERFACES(QDLTPluginInterface)
     Q_INTERFACES(QDLTPluginDecoderInterface)
+    Q_INTERFACES(QDltPluginDecoderInterestInterface)
 #ifdef QT5
-    Q_PLUGIN_METADATA(IID "org.genivi.DLT.NonVerbosePlugin")
+    Q_PLUGIN_METADATA(IID "org.genivi.DLT.NonVerbosePlugin" FILE "nonverboseplugin.json")
 #endif
 
 public:
@@ -127,16 +176,32 @@ public:
     bool isMsg(QDltMsg &msg, int triggeredByUser);
     bool decodeMsg(QDltMsg &msg, int triggeredByUser);
 
+    /* QDltPluginDecoderInterestInterface */
+    bool decoderInterest(QDltDecoderInterest &interest);
+
     /* Faster lookup */
     //is it necessary that this is public?
     QHash<QString, DltFibexPdu *> pdumap;
     QHash<QString, DltFibexFrame *> framemap;
     QHash<DltFibexKey, DltFibexFrame *> framemapwithkey;
 
+    /* Integer keyed lookup used while decoding */
+    QHash<uint32_t, DltFibexFrame *> framemapbyid;
+    QHash<DltFibexIdKey, DltFibexFrame *> framemapbyidkey;
+
 private:
     bool parseFile(QString filename);
     void clear();
 
+    /* link PDUs, create integer keyed lookup and decode steps of all frames */
+    void compileFrames();
+
+    /* find the frame of a message */
+    DltFibexFrame *findFrame(const QDltMsg &msg);
+
+    /* pack AppId and CtId of up to four characters, returns false if an id is longer */
+    static bool packIds(const QString &appid, const QString &ctid, uint64_t &packed);
+
     QString m_error_string;
 };
 
@@ -21,6 +21,8 @@
 #define PLUGININTERFACE_H
 
 #include <QString>
+#include <QVector>
+#include <QPair>
 #include "qdlt.h"
 
 #define PLUGIN_INTERFACE_VERSION "1.0.0"
@@ -150,6 +152,60 @@ public:
 Q_DECLARE_INTERFACE(QDLTPluginDecoderInterface,
                     "org.genivi.DLT.Plugin.DLTViewerPluginDecoderInterface/1.0")
 
+//! Description of the messages a decoder plugin is interested in.
+/*!
+  An empty list means no restriction by this criteria.
+  A message is only passed to isMsg() and decodeMsg() of the plugin, if it matches all criteria.
+  Application Id and Context Id of non-verbose messages without extended header are empty,
+  before they are decoded.
+*/
+class QDltDecoderInterest
+{
+public:
+    QDltDecoderInterest() { verbose = true; nonVerbose = true; }
+
+    //! Application Ids of the messages.
+    QStringList apids;
+
+    //! Context Ids of the messages.
+    QStringList ctids;
+
+    //! Message types of the messages.
+    QList<QDltMsg::DltTypeDef> types;
+
+    //! Verbose messages are decoded.
+    bool verbose;
+
+    //! Non-verbose messages are decoded.
+    bool nonVerbose;
+
+    //! Ranges of message ids of non-verbose messages, first and last id of each range included.
+    QList<QPair<unsigned int,unsigned int> > messageIdRanges;
+};
+
+//! Optional extension of the decoder plugin interface to declare the handled messages.
+/*!
+  A decoder plugin can declare up front which messages it handles.
+  The plugin manager then calls isMsg() and decodeMsg() only for matching messages,
+  instead of asking every decoder plugin for every message.
+  Decoder plugins not implementing this interface get all messages.
+*/
+class QDltPluginDecoderInterestInterface
+{
+public:
+    //! Declare the messages handled by the decoder plugin.
+    /*!
+      This function is called after the plugin is loaded and each time the configuration
+      of the plugin was changed.
+      \param interest The criteria of the handled messages.
+      \return True if the interest is declared. False if all messages should be checked by isMsg().
+    */
+    virtual bool decoderInterest(QDltDecoderInterest &interest) = 0;
+};
+
+Q_DECLARE_INTERFACE(QDltPluginDecoderInterestInterface,
+                    "org.genivi.DLT.Plugin.DLTViewerPluginDecoderInterestInterface/1.0")
+
 //! Extended DLT Viewer Plugin Interface used by viewer plugins.
 /*!
   This is an extended DLT Plugin Interface.
@@ -267,6 +323,81 @@ public:
 Q_DECLARE_INTERFACE(QDltPluginViewerInterface,
                     "org.genivi.DLT.Plugin.DLTViewerPluginViewerInterface/1.2")
 
+//! Number of messages passed at once to the batch callbacks of viewer plugins.
+#define QDLT_VIEWER_BATCH_SIZE 4096
+
+//! A batch of messages passed to the batch callbacks of viewer plugins.
+/*!
+  Each entry contains the index of the message in the log file and the message.
+  The messages are only valid during the callback, the plugin must copy them to keep them.
+*/
+typedef QVector<QPair<int, QDltMsg*> > QDltMsgBatch;
+
+//! Optional extension of the viewer plugin interface to process messages in batches.
+/*!
+  A viewer plugin implementing this interface gets the messages in batches of up to
+  QDLT_VIEWER_BATCH_SIZE messages instead of one call per message; initMsg(), initMsgDecoded(),
+  updateMsg() and updateMsgDecoded() are not called anymore for this plugin.
+  initMsgs() and updateMsgs() are called with all messages of a batch before they are decoded,
+  initMsgsDecoded() and updateMsgsDecoded() after all messages of the batch were decoded.
+  initMsgs() and initMsgsDecoded() are called in the indexer thread, not in the GUI thread.
+  Viewer plugins not implementing this interface get one call per message.
+*/
+class QDltPluginViewerBatchInterface
+{
+public:
+    //! A batch of undecoded DLT messages is processed after a new log file is opened.
+    /*!
+      \param batch The undecoded DLT messages with their index
+    */
+    virtual void initMsgs(const QDltMsgBatch &batch) = 0;
+
+    //! A batch of decoded DLT messages is processed after a new log file is opened.
+    /*!
+      \param batch The decoded DLT messages with their index
+    */
+    virtual void initMsgsDecoded(const QDltMsgBatch &batch) = 0;
+
+    //! A batch of undecoded DLT messages was added to the log file.
+    /*!
+      \param batch The undecoded DLT messages with their index
+    */
+    virtual void updateMsgs(const QDltMsgBatch &batch) = 0;
+
+    //! A batch of decoded DLT messages was added to the log file.
+    /*!
+      \param batch The decoded DLT messages with their index
+    */
+    virtual void updateMsgsDecoded(const QDltMsgBatch &batch) = 0;
+};
+
+Q_DECLARE_INTERFACE(QDltPluginViewerBatchInterface,
+                    "org.genivi.DLT.Plugin.DLTViewerPluginViewerBatchInterface/1.0")
+
+//! Optional extension of the viewer plugin batch interface to run the plugin in its own thread.
+/*!
+  A viewer plugin implementing this interface and QDltPluginViewerBatchInterface can run
+  the batch callbacks in a worker thread of its own, so a slow plugin does not delay indexing.
+  The worker thread gets all messages in their order, while indexing and while receiving.
+  Each worker thread gets its own copy of the messages.
+  The viewer only waits for the worker thread before calling initFileFinish(),
+  all other viewer callbacks are still called in the GUI thread.
+  The plugin must not access widgets in the batch callbacks, GUI updates must be
+  done by signals, which are queued to the GUI thread.
+*/
+class QDltPluginViewerWorkerInterface
+{
+public:
+    //! Check if the batch callbacks should be run in a worker thread.
+    /*!
+      \return True if the plugin is ready to run in a worker thread.
+    */
+    virtual bool runInWorkerThread() = 0;
+};
+
+Q_DECLARE_INTERFACE(QDltPluginViewerWorkerInterface,
+                    "org.genivi.DLT.Plugin.DLTViewerPluginViewerWorkerInterface/1.0")
+
 //! Extended DLT Control Plugin Interface used by control plugins.
 /*!
   This is an extended DLT Plugin Interface.
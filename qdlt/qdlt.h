@@ -23,13 +23,22 @@
 #define QDLT_H
 
 #include <qdltbase.h>
+#include <qdlttextwriter.h>
+#include <qdlttimecache.h>
+#include <qdltmetrics.h>
 
 #include <qdltargument.h>
 #include <qdltmsg.h>
+#include <qdltmsgring.h>
 #include <qdltfilter.h>
 #include <qdltfilterlist.h>
 #include <qdltfilterindex.h>
 #include <qdltdefaultfilter.h>
+#include <qdltcompressedfile.h>
+#include <qdltcompressedwriter.h>
+#include <qdltdecodedmsgcache.h>
+#include <qdltexportformatter.h>
+#include <qdltudpreceiver.h>
 #include <qdltfile.h>
 #include <qdltcontrol.h>
 #include <qdltconnection.h>
@@ -54,6 +54,17 @@ UI_DIR      = build/ui
 
 INCLUDEPATH = . ../src
 
+# Support for compressed log files, zlib and zstd are used if found,
+# disable them with CONFIG+=no_zlib or CONFIG+=no_zstd
+!no_zlib:packagesExist(zlib) {
+    DEFINES += QDLT_WITH_ZLIB
+    LIBS += -lz
+}
+!no_zstd:packagesExist(libzstd) {
+    DEFINES += QDLT_WITH_ZSTD
+    LIBS += -lzstd
+}
+
 SOURCES +=  \
             dlt_common.c \
     qdltipconnection.cpp \
@@ -72,7 +83,17 @@ SOURCES +=  \
     qdltdefaultfilter.cpp \
     qdltpluginmanager.cpp \
     qdltplugin.cpp \
-    qdltsegmentedmsg.cpp
+    qdltsegmentedmsg.cpp \
+    qdltsegmentreassembler.cpp \
+    qdltcompressedfile.cpp \
+    qdltcompressedwriter.cpp \
+    qdltdecodedmsgcache.cpp \
+    qdlttextwriter.cpp \
+    qdlttimecache.cpp \
+    qdltexportformatter.cpp \
+    qdltudpreceiver.cpp \
+    qdltmsgring.cpp \
+    qdltmetrics.cpp
 
 
 HEADERS += qdlt.h \
@@ -98,7 +119,17 @@ HEADERS += qdlt.h \
     qdltplugin.h \
     dlt_types.h \
     dlt_protocol.h \
-    qdltsegmentedmsg.h
+    qdltsegmentedmsg.h \
+    qdltsegmentreassembler.h \
+    qdltcompressedfile.h \
+    qdltcompressedwriter.h \
+    qdltdecodedmsgcache.h \
+    qdlttextwriter.h \
+    qdlttimecache.h \
+    qdltexportformatter.h \
+    qdltudpreceiver.h \
+    qdltmsgring.h \
+    qdltmetrics.h
 
 unix:VERSION            = 1.0.0
 
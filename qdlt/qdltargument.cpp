@@ -383,17 +383,25 @@ QString QDltArgument::toString(bool binary) const
     QString text;
     text.reserve(1024);
 
+    toString(text,binary);
+
+    return text;
+}
+
+void QDltArgument::toString(QString &text, bool binary) const
+{
     if(binary) {
-        return toAscii(data);
+        toAscii(text,data);
+        return;
     }
 
     switch(getTypeInfo()) {
     case DltTypeInfoUnknown:
-        text += QString("?");
+        text += QLatin1Char('?');
         break;
     case DltTypeInfoStrg:
         if(data.size()) {
-            text += QString("%1").arg(QString(getData()));
+            text += QString(data);
         }
         break;
     case DltTypeInfoUtf8:
@@ -404,39 +412,39 @@ QString QDltArgument::toString(bool binary) const
     case DltTypeInfoBool:
         if(data.size()) {
             if(data.constData()[0])
-                text += QString("true");
+                text += QLatin1String("true");
             else
-                text += QString("false");
+                text += QLatin1String("false");
         }
         else
-            text += QString("?");
+            text += QLatin1Char('?');
         break;
     case DltTypeInfoSInt:
         switch(data.size())
         {
         case 1:
-            text += QString("%1").arg((short)(*(char*)(data.constData())));
+            QDltTextWriter::appendInt(text,(short)(*(char*)(data.constData())));
             break;
         case 2:
             if(endianness == DltEndiannessLittleEndian)
-                text += QString("%1").arg((short)(*(short*)(data.constData())));
+                QDltTextWriter::appendInt(text,(short)(*(short*)(data.constData())));
             else
-                text += QString("%1").arg((short)DLT_SWAP_16((short)(*(short*)(data.constData()))));
+                QDltTextWriter::appendInt(text,(short)DLT_SWAP_16((short)(*(short*)(data.constData()))));
             break;
         case 4:
             if(endianness == DltEndiannessLittleEndian)
-                text += QString("%1").arg((int)(*(int*)(data.constData())));
+                QDltTextWriter::appendInt(text,(int)(*(int*)(data.constData())));
             else
-                text += QString("%1").arg((int)DLT_SWAP_32((int)(*(int*)(data.constData()))));
+                QDltTextWriter::appendInt(text,(int)DLT_SWAP_32((int)(*(int*)(data.constData()))));
             break;
         case 8:
             if(endianness == DltEndiannessLittleEndian)
-                text += QString("%1").arg((long long)(*(long long*)(data.constData())));
+                QDltTextWriter::appendInt(text,(long long)(*(long long*)(data.constData())));
             else
-                text += QString("%1").arg((long long)DLT_SWAP_64((long long)(*(long long*)(data.constData()))));
+                QDltTextWriter::appendInt(text,(long long)DLT_SWAP_64((long long)(*(long long*)(data.constData()))));
             break;
         default:
-            text += QString("?");
+            text += QLatin1Char('?');
         }
 
         break;
@@ -444,48 +452,48 @@ QString QDltArgument::toString(bool binary) const
         if ((dltType & DLT_TYPE_INFO_SCOD)==DLT_SCOD_BIN)
         {
             if((dltType & DLT_TYPE_INFO_TYLE)==DLT_TYLE_8BIT)
-                text += toAscii(data,2,1); // show binary
+                toAscii(text,data,2,1); // show binary
             else if((dltType & DLT_TYPE_INFO_TYLE)==DLT_TYLE_16BIT)
-                text += toAscii(data,2,2); // show binary
+                toAscii(text,data,2,2); // show binary
         }
         else if ((dltType & DLT_TYPE_INFO_SCOD)==DLT_SCOD_HEX)
         {
             if((dltType & DLT_TYPE_INFO_TYLE)==DLT_TYLE_8BIT)
-                text += toAscii(data,0,1); // show 8 bit hex
+                toAscii(text,data,0,1); // show 8 bit hex
             else if((dltType & DLT_TYPE_INFO_TYLE)==DLT_TYLE_16BIT)
-                text += toAscii(data,0,2); // show 16 bit hex
+                toAscii(text,data,0,2); // show 16 bit hex
             else if((dltType & DLT_TYPE_INFO_TYLE)==DLT_TYLE_32BIT)
-                text += toAscii(data,0,4); // show 32 bit hex
+                toAscii(text,data,0,4); // show 32 bit hex
             else if((dltType & DLT_TYPE_INFO_TYLE)==DLT_TYLE_64BIT)
-                text += toAscii(data,0,8); // show 64 bit hex
+                toAscii(text,data,0,8); // show 64 bit hex
         }
         else
         {
             switch(data.size())
             {
             case 1:
-                text += QString("%1").arg((unsigned short)(*(unsigned char*)(data.constData())));
+                QDltTextWriter::appendUInt(text,(unsigned short)(*(unsigned char*)(data.constData())));
                 break;
             case 2:
                 if(endianness == DltEndiannessLittleEndian)
-                    text += QString("%1").arg((unsigned short)(*(unsigned short*)(data.constData())));
+                    QDltTextWriter::appendUInt(text,(unsigned short)(*(unsigned short*)(data.constData())));
                 else
-                    text += QString("%1").arg((unsigned short)DLT_SWAP_16((unsigned short)(*(unsigned short*)(data.constData()))));
+                    QDltTextWriter::appendUInt(text,(unsigned short)DLT_SWAP_16((unsigned short)(*(unsigned short*)(data.constData()))));
                 break;
             case 4:
                 if(endianness == DltEndiannessLittleEndian)
-                    text += QString("%1").arg((unsigned int)(*(unsigned int*)(data.constData())));
+                    QDltTextWriter::appendUInt(text,(unsigned int)(*(unsigned int*)(data.constData())));
                 else
-                    text += QString("%1").arg((unsigned int)DLT_SWAP_32((unsigned int)(*(unsigned int*)(data.constData()))));
+                    QDltTextWriter::appendUInt(text,(unsigned int)DLT_SWAP_32((unsigned int)(*(unsigned int*)(data.constData()))));
                 break;
             case 8:
                 if(endianness == DltEndiannessLittleEndian)
-                    text += QString("%1").arg((unsigned long long)(*(unsigned long long*)(data.constData())));
+                    QDltTextWriter::appendUInt(text,(unsigned long long)(*(unsigned long long*)(data.constData())));
                 else
-                    text += QString("%1").arg((unsigned long long)DLT_SWAP_64((unsigned long long)(*(unsigned long long*)(data.constData()))));
+                    QDltTextWriter::appendUInt(text,(unsigned long long)DLT_SWAP_64((unsigned long long)(*(unsigned long long*)(data.constData()))));
                 break;
             default:
-                text += QString("?");
+                text += QLatin1Char('?');
             }
         }
         break;
@@ -494,40 +502,38 @@ QString QDltArgument::toString(bool binary) const
         {
         case 4:
             if(endianness == DltEndiannessLittleEndian)
-                text += QString("%1").arg((double)(*(float*)(data.constData())));
+                QDltTextWriter::appendDouble(text,(double)(*(float*)(data.constData())));
             else
             {
                 unsigned int tmp;
                 tmp = DLT_SWAP_32((unsigned int)(*(unsigned int*)(data.constData())));
                 void *buf = (void *) &tmp;
-                text += QString("%1").arg((double)(*((float*)buf)));
+                QDltTextWriter::appendDouble(text,(double)(*((float*)buf)));
             }
             break;
         case 8:
             if(endianness == DltEndiannessLittleEndian)
-                text += QString("%1").arg((double)(*(double*)(data.constData())));
+                QDltTextWriter::appendDouble(text,(double)(*(double*)(data.constData())));
             else {
                 unsigned int tmp;
                 tmp = DLT_SWAP_64((unsigned long long)(*(unsigned long long*)(data.constData())));
                 void *buf = (void *) &tmp;
-                text += QString("%1").arg((double)(*((double*)buf)));
+                QDltTextWriter::appendDouble(text,(double)(*((double*)buf)));
             }
             break;
         default:
-            text += QString("?");
+            text += QLatin1Char('?');
         }
         break;
     case DltTypeInfoRawd:
-        text += toAscii(data,0); // show raw format (no leading 0x)
+        toAscii(text,data,0); // show raw format (no leading 0x)
         break;
     case DltTypeInfoTrai:
-        text += QString("?");
+        text += QLatin1Char('?');
         break;
     default:
-        text += QString("?");
+        text += QLatin1Char('?');
     }
-
-    return text;
 }
 
 QVariant QDltArgument::getValue() const
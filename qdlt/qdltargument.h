@@ -180,6 +180,13 @@ public:
     */
     QString toString(bool binary = false) const;
 
+    //! Print argument content and append it to a buffer.
+    /*!
+      \param text The buffer the argument content is appended to.
+      \param binary if true write parameter as  Hex, if false translate into text
+    */
+    void toString(QString &text, bool binary = false) const;
+
     //! Clears all variables of the class.
     void clear();
 
@@ -158,12 +158,17 @@ QString QDlt::toAsciiTable(const QByteArray &bytes, bool withLineNumber, bool wi
 
 QString QDlt::toAscii(const QByteArray &bytes, int type,int size_bytes) const
 {
-    static const char hexmap[16] = {'0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f'};
+    QString text;
+    toAscii(text,bytes,type,size_bytes);
+    return text;
+}
+
+void QDlt::toAscii(QString &text, const QByteArray &bytes, int type,int size_bytes) const
+{
     if (type==1)
     {
         // ascii
-        // Could also use QString::QString ( const QByteArray & ba )
-        return QString::fromLatin1(bytes.data(), bytes.size() );
+        text.append(QLatin1String(bytes.data(), bytes.size()));
     }
     else if (type==2)
     {
@@ -171,27 +176,21 @@ QString QDlt::toAscii(const QByteArray &bytes, int type,int size_bytes) const
         int size = bytes.size();
         if (!size)
         {
-            //Let's return an empty string.
-            return QString("");
+            return;
         }
 
         if (1 == size_bytes)
         {
             uint8_t toEncode = bytes.data()[0];
-            QString encoded = QString("0b%1").arg(toEncode, 8, 2, QChar('0'));
-            return encoded.insert(6, ' '); // insert a space after 0bxxxx
+            text.append(QLatin1String("0b"));
+            QDltTextWriter::appendBinary(text, toEncode, 8);
         }
         else // has to be: (2 == size_bytes)
         {
             uint16_t toEncode = (uint8_t)(bytes.data()[0]) | (((uint8_t)(bytes.data()[1])) << 8);
-            QString encoded = QString("0b%1").arg(toEncode, 16, 2, QChar('0'));
-            encoded.insert(14, ' '); // insert spaces
-            encoded.insert(10, ' ');
-            encoded.insert(6, ' ');
-            return encoded;
+            text.append(QLatin1String("0b"));
+            QDltTextWriter::appendBinary(text, toEncode, 16);
         }
-
-        return QString("");
     }
     else
     {
@@ -199,57 +198,39 @@ QString QDlt::toAscii(const QByteArray &bytes, int type,int size_bytes) const
         int size = bytes.size();
         if (!size)
         {
-            //Let's return an empty string.
-            return QString("");
+            return;
         }
 
         if (1 == size_bytes)
         {
             uint8_t toEncode = bytes.data()[0];
-            return QString("0x%1").arg(toEncode, 2, 16, QChar('0'));
+            text.append(QLatin1String("0x"));
+            QDltTextWriter::appendHex(text, toEncode, 2);
         }
-        if (2 == size_bytes)
+        else if (2 == size_bytes)
         {
             uint16_t toEncode = (uint8_t)(bytes.data()[0]) | (((uint8_t)(bytes.data()[1])) << 8);
-            return QString("0x%1").arg(toEncode, 4, 16, QChar('0'));
+            text.append(QLatin1String("0x"));
+            QDltTextWriter::appendHex(text, toEncode, 4);
         }
-        if (4 == size_bytes)
+        else if (4 == size_bytes)
         {
             uint32_t toEncode = (uint8_t)(bytes.data()[0]) | (((uint8_t)(bytes.data()[1])) << 8) | (((uint8_t)(bytes.data()[2])) << 16) | (((uint8_t)(bytes.data()[3])) << 24);
-            return QString("0x%1").arg(toEncode, 8, 16, QChar('0'));
+            text.append(QLatin1String("0x"));
+            QDltTextWriter::appendHex(text, toEncode, 8);
         }
-        if (8 == size_bytes)
+        else if (8 == size_bytes)
         {
             uint32_t toEncodeLo = (uint8_t)(bytes.data()[0]) | (((uint8_t)(bytes.data()[1])) << 8) | (((uint8_t)(bytes.data()[2])) << 16) | (((uint8_t)(bytes.data()[3])) << 24);
             uint32_t toEncodeHi = (uint8_t)(bytes.data()[4]) | (((uint8_t)(bytes.data()[5])) << 8) | (((uint8_t)(bytes.data()[6])) << 16) | (((uint8_t)(bytes.data()[7])) << 24);
-            return QString("0x%1").arg(toEncodeHi, 8, 16, QChar('0')) + QString("%1").arg(toEncodeLo, 8, 16, QChar('0'));
+            text.append(QLatin1String("0x"));
+            QDltTextWriter::appendHex(text, toEncodeHi, 8);
+            QDltTextWriter::appendHex(text, toEncodeLo, 8);
         }
-
-        if (0xff == size_bytes)
+        else if (0xff == size_bytes)
         {
-            std::vector<char> str( size*3, ' ' );
-
-            char* strData = &str[0];
-            const char* byteData = bytes.data();
-            for(int num=0;num<size;++num)
-            {
-                *strData = hexmap[ (*byteData & 0xF0) >> 4 ];
-                ++strData;
-                *strData = hexmap[ *byteData & 0x0F ];
-                if((((num+1)%1)==0) && (num!=size-1))
-                    strData += 2;
-                else
-                    strData += 1;
-                ++byteData;
-            }
-            // add termination
-            if (size>0)
-            {
-                *(strData) = 0;
-            }
-            return QString( &str[0] );
+            QDltTextWriter::appendHexBytes(text, bytes);
         }
     }
-    return QString("");
 }
 
@@ -102,6 +102,15 @@ public:
     */
     QString toAscii(const QByteArray &bytes, int type = false, int size_bytes = 0xff) const;
 
+    //! Convert byte array to text output and append it to a buffer.
+    /*!
+      \param text The buffer the output is appended to
+      \param bytes The data to be converted
+      \param type 1 output in ASCII, 0 output in hex, 2 output in binary
+      \param size_bytes grouping of bytes together (0xff for raw format)
+    */
+    void toAscii(QString &text, const QByteArray &bytes, int type = false, int size_bytes = 0xff) const;
+
     //! The endianness of the message.
     typedef enum { DltEndiannessUnknown = -2, DltEndiannessLittleEndian = 0, DltEndiannessBigEndian = 1 } DltEndiannessDef;
 
@@ -0,0 +1,785 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltcompressedfile.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QFile>
+#include <QDataStream>
+#include <QtEndian>
+#include <QtDebug>
+#include <string.h>
+
+#include "qdltcompressedfile.h"
+
+#ifdef QDLT_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef QDLT_WITH_ZSTD
+#include <zstd.h>
+#endif
+
+/* Size of the buffer for reading compressed data */
+#define QDLT_COMPRESSED_IN_BUFFER_SIZE (256*1024)
+
+/* Size of the deflate dictionary needed to restart in the middle of a gzip member */
+#define QDLT_COMPRESSED_WINDOW_SIZE 32768
+
+/* zstd seekable format: skippable frame magic, seek table footer magic and footer size */
+#define QDLT_ZSTD_SKIPPABLE_MAGIC 0x184D2A5E
+#define QDLT_ZSTD_SEEKABLE_MAGIC 0x8F92EAB1
+#define QDLT_ZSTD_SEEKABLE_FOOTER_SIZE 9
+
+QDltSeekIndex::QDltSeekIndex()
+{
+    uncompressedSize = -1;
+}
+
+void QDltSeekIndex::clear()
+{
+    points.clear();
+    uncompressedSize = -1;
+}
+
+bool QDltSeekIndex::save(const QString &filename, qint64 sourceSize) const
+{
+    QFile file(filename);
+
+    // open index file
+    if(!file.open(QFile::WriteOnly))
+    {
+        // open file failed
+        return false;
+    }
+
+    QDataStream stream(&file);
+
+    // write header
+    stream << (quint32) QDLT_COMPRESSED_SEEK_INDEX_VERSION;
+    stream << (qint64) sourceSize;
+    stream << (qint64) uncompressedSize;
+    stream << (quint32) points.size();
+
+    // write all seek points
+    for(int num=0;num<points.size();num++)
+    {
+        stream << points[num].in;
+        stream << points[num].out;
+        stream << (qint32) points[num].bits;
+        stream << points[num].window;
+    }
+
+    file.close();
+
+    return stream.status() == QDataStream::Ok;
+}
+
+bool QDltSeekIndex::load(const QString &filename, qint64 sourceSize)
+{
+    quint32 version;
+    qint64 size;
+    quint32 count;
+
+    clear();
+
+    QFile file(filename);
+
+    // open index file
+    if(!file.open(QFile::ReadOnly))
+    {
+        // open file failed
+        return false;
+    }
+
+    QDataStream stream(&file);
+
+    // read and check header
+    stream >> version;
+    stream >> size;
+    if(stream.status() != QDataStream::Ok || version != QDLT_COMPRESSED_SEEK_INDEX_VERSION || size != sourceSize)
+    {
+        // wrong version or index belongs to a different file
+        file.close();
+        return false;
+    }
+    stream >> uncompressedSize;
+    stream >> count;
+
+    // read all seek points
+    points.reserve(count);
+    for(quint32 num=0;num<count && stream.status() == QDataStream::Ok;num++)
+    {
+        QDltSeekIndex::SeekPoint point;
+        qint32 bits;
+
+        stream >> point.in;
+        stream >> point.out;
+        stream >> bits;
+        stream >> point.window;
+        point.bits = bits;
+
+        points.append(point);
+    }
+
+    file.close();
+
+    if(stream.status() != QDataStream::Ok || points.isEmpty())
+    {
+        // index file is corrupted
+        clear();
+        return false;
+    }
+
+    return true;
+}
+
+QDltCompressedFile::QDltCompressedFile(QIODevice *source)
+{
+    this->source = source;
+    format = FormatNone;
+    stream = 0;
+    rawDeflate = false;
+    streamEnd = false;
+    endInPos = -1;
+    inBufferPos = 0;
+    inBufferLength = 0;
+    inPos = 0;
+    outPos = 0;
+    knownSize = 0;
+}
+
+QDltCompressedFile::~QDltCompressedFile()
+{
+    close();
+}
+
+QDltCompressedFile::FormatDef QDltCompressedFile::detectFormat(QIODevice *device)
+{
+    if(!device || !device->isOpen())
+        return FormatNone;
+
+    QByteArray magic = device->peek(4);
+
+#ifdef QDLT_WITH_ZLIB
+    if(magic.size() >= 2 && (unsigned char)magic[0] == 0x1f && (unsigned char)magic[1] == 0x8b)
+        return FormatGzip;
+#endif
+
+#ifdef QDLT_WITH_ZSTD
+    if(magic.size() == 4 && (unsigned char)magic[0] == 0x28 && (unsigned char)magic[1] == 0xb5 &&
+       (unsigned char)magic[2] == 0x2f && (unsigned char)magic[3] == 0xfd)
+        return FormatZstd;
+#endif
+
+    Q_UNUSED(magic);
+
+    return FormatNone;
+}
+
+bool QDltCompressedFile::readBlockIndex(QIODevice *device, QDltSeekIndex &index, qint64 &indexOffset)
+{
+    index.clear();
+    indexOffset = -1;
+
+    qint64 sourceSize = device->size();
+    if(sourceSize < QDLT_COMPRESSED_FOOTER_SIZE || !device->seek(sourceSize - QDLT_COMPRESSED_FOOTER_SIZE))
+        return false;
+
+    /* the footer is an empty gzip member with the extra subfield 'DF' */
+    QByteArray footer = device->read(QDLT_COMPRESSED_FOOTER_SIZE);
+    const uchar *data = (const uchar*) footer.constData();
+    if(footer.size() != QDLT_COMPRESSED_FOOTER_SIZE ||
+       data[0] != 0x1f || data[1] != 0x8b || data[2] != 0x08 || data[3] != 0x04 ||
+       qFromLittleEndian<quint16>(data + 10) != 28 || data[12] != 'D' || data[13] != 'F' ||
+       qFromLittleEndian<quint16>(data + 14) != 24)
+        return false;
+
+    qint64 offset = qFromLittleEndian<qint64>(data + 16);
+    qint64 blocks = qFromLittleEndian<qint64>(data + 24);
+    qint64 uncompressedSize = qFromLittleEndian<qint64>(data + 32);
+    if(offset < 0 || offset > sourceSize - QDLT_COMPRESSED_FOOTER_SIZE || blocks <= 0 || uncompressedSize < 0)
+        return false;
+
+    /* read all index members, each one contains a 'DI' subfield with (in, out) pairs */
+    if(!device->seek(offset))
+        return false;
+    QByteArray members = device->read(sourceSize - QDLT_COMPRESSED_FOOTER_SIZE - offset);
+    data = (const uchar*) members.constData();
+    int pos = 0;
+    while(pos + 16 <= members.size())
+    {
+        int xlen = qFromLittleEndian<quint16>(data + pos + 10);
+        int length = qFromLittleEndian<quint16>(data + pos + 14);
+        if(data[pos] != 0x1f || data[pos + 1] != 0x8b || data[pos + 3] != 0x04 ||
+           data[pos + 12] != 'D' || data[pos + 13] != 'I' || length + 4 > xlen ||
+           pos + 12 + xlen + 10 > members.size())
+            return false;
+
+        for(int num = 0; num + 16 <= length; num += 16)
+        {
+            QDltSeekIndex::SeekPoint point;
+            point.in = qFromLittleEndian<qint64>(data + pos + 16 + num);
+            point.out = qFromLittleEndian<qint64>(data + pos + 16 + num + 8);
+            point.bits = -1;
+            index.points.append(point);
+        }
+
+        pos += 12 + xlen + 10;
+    }
+
+    if(index.points.size() != blocks || index.points[0].in != 0 || index.points[0].out != 0)
+    {
+        index.clear();
+        return false;
+    }
+
+    index.uncompressedSize = uncompressedSize;
+    indexOffset = offset;
+
+    return true;
+}
+
+bool QDltCompressedFile::readSeekTable(QIODevice *device, QDltSeekIndex &index)
+{
+    index.clear();
+
+    qint64 sourceSize = device->size();
+    if(sourceSize < 8 + QDLT_ZSTD_SEEKABLE_FOOTER_SIZE || !device->seek(sourceSize - QDLT_ZSTD_SEEKABLE_FOOTER_SIZE))
+        return false;
+
+    /* the footer contains the number of frames, the descriptor and the seekable magic */
+    QByteArray footer = device->read(QDLT_ZSTD_SEEKABLE_FOOTER_SIZE);
+    const uchar *data = (const uchar*) footer.constData();
+    if(footer.size() != QDLT_ZSTD_SEEKABLE_FOOTER_SIZE || qFromLittleEndian<quint32>(data + 5) != QDLT_ZSTD_SEEKABLE_MAGIC ||
+       (data[4] & 0x7c) != 0)
+        return false;
+
+    /* each entry has the compressed and decompressed size, optionally followed by a checksum */
+    qint64 frames = qFromLittleEndian<quint32>(data);
+    int entrySize = (data[4] & 0x80) ? 12 : 8;
+    qint64 tableSize = frames * entrySize + QDLT_ZSTD_SEEKABLE_FOOTER_SIZE;
+    qint64 tableOffset = sourceSize - 8 - tableSize;
+    if(frames == 0 || tableOffset < 0 || !device->seek(tableOffset))
+        return false;
+
+    /* the seek table is the content of a skippable frame */
+    QByteArray table = device->read(8 + tableSize - QDLT_ZSTD_SEEKABLE_FOOTER_SIZE);
+    data = (const uchar*) table.constData();
+    if(table.size() != 8 + tableSize - QDLT_ZSTD_SEEKABLE_FOOTER_SIZE ||
+       qFromLittleEndian<quint32>(data) != QDLT_ZSTD_SKIPPABLE_MAGIC || qFromLittleEndian<quint32>(data + 4) != tableSize)
+        return false;
+
+    qint64 in = 0;
+    qint64 out = 0;
+    for(qint64 num = 0; num < frames; num++)
+    {
+        QDltSeekIndex::SeekPoint point;
+        point.in = in;
+        point.out = out;
+        point.bits = -1;
+        index.points.append(point);
+
+        in += qFromLittleEndian<quint32>(data + 8 + num * entrySize);
+        out += qFromLittleEndian<quint32>(data + 8 + num * entrySize + 4);
+    }
+
+    /* the frames must end where the seek table starts */
+    if(in != tableOffset)
+    {
+        index.clear();
+        return false;
+    }
+
+    index.uncompressedSize = out;
+
+    return true;
+}
+
+bool QDltCompressedFile::isCompressedFile(const QString &filename)
+{
+    QFile file(filename);
+
+    if(!file.open(QIODevice::ReadOnly))
+        return false;
+
+    return detectFormat(&file) != FormatNone;
+}
+
+bool QDltCompressedFile::open(OpenMode mode)
+{
+    if((mode & QIODevice::WriteOnly) || !source || !source->isOpen())
+        return false;
+
+    format = detectFormat(source);
+    if(format == FormatNone)
+    {
+        qWarning() << "QDltCompressedFile: unsupported compression format";
+        return false;
+    }
+
+    inBuffer.resize(QDLT_COMPRESSED_IN_BUFFER_SIZE);
+
+    // files written by QDltCompressedWriter contain their own block index
+    if(format == FormatGzip && seekIndex.points.isEmpty())
+    {
+        QDltSeekIndex blockIndex;
+        qint64 indexOffset;
+        if(readBlockIndex(source, blockIndex, indexOffset))
+            setSeekIndex(blockIndex);
+    }
+
+    // files written in the zstd seekable format contain a seek table
+    if(format == FormatZstd && seekIndex.points.isEmpty())
+    {
+        QDltSeekIndex seekTable;
+        if(readSeekTable(source, seekTable))
+            setSeekIndex(seekTable);
+    }
+
+    // the start of the file is always a valid seek point
+    addSeekPoint(0, 0, -1, QByteArray());
+
+    initStream();
+    if(!stream || !restartAt(seekIndex.points[0]))
+    {
+        freeStream();
+        return false;
+    }
+
+    if(!isRandomAccess())
+        qWarning() << "QDltCompressedFile: zstd file has no seek table, seeking backwards decompresses from the start of the frame";
+
+    return QIODevice::open(QIODevice::ReadOnly | QIODevice::Unbuffered);
+}
+
+void QDltCompressedFile::close()
+{
+    freeStream();
+
+    if(isOpen())
+        QIODevice::close();
+}
+
+bool QDltCompressedFile::isRandomAccess() const
+{
+    return format == FormatGzip || seekIndex.points.size() > 1;
+}
+
+qint64 QDltCompressedFile::size() const
+{
+    if(isIndexComplete())
+        return seekIndex.uncompressedSize;
+
+    return knownSize;
+}
+
+void QDltCompressedFile::setSeekIndex(const QDltSeekIndex &index)
+{
+    seekIndex = index;
+
+    if(seekIndex.uncompressedSize > knownSize)
+        knownSize = seekIndex.uncompressedSize;
+    if(!seekIndex.points.isEmpty() && seekIndex.points.last().out > knownSize)
+        knownSize = seekIndex.points.last().out;
+}
+
+qint64 QDltCompressedFile::readData(char *data, qint64 maxSize)
+{
+    qint64 length = 0;
+
+    /* move decompressor to the requested position */
+    if(!seekStream(pos()))
+        return -1;
+
+    while(length < maxSize)
+    {
+        qint64 bytes = decompress(data + length, maxSize - length);
+        if(bytes < 0)
+            return (length > 0) ? length : -1;
+        if(bytes == 0)
+            break; // end of data
+        length += bytes;
+    }
+
+    return length;
+}
+
+qint64 QDltCompressedFile::writeData(const char *data, qint64 maxSize)
+{
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+
+    return -1;
+}
+
+bool QDltCompressedFile::seekStream(qint64 pos)
+{
+    if(!stream || seekIndex.points.isEmpty())
+        return false;
+
+    /* find the last seek point in front of the position */
+    int low = 0;
+    int high = seekIndex.points.size() - 1;
+    while(low < high)
+    {
+        int mid = (low + high + 1) / 2;
+        if(seekIndex.points[mid].out <= pos)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+    const QDltSeekIndex::SeekPoint &point = seekIndex.points[low];
+
+    /* restart only if it is cheaper than to continue with the current stream */
+    if(pos < outPos || outPos < point.out)
+    {
+        if(!restartAt(point))
+            return false;
+    }
+
+    /* skip data up to the requested position */
+    QByteArray skip;
+    while(outPos < pos)
+    {
+        if(skip.isEmpty())
+            skip.resize(64*1024);
+        qint64 bytes = decompress(skip.data(), qMin(pos - outPos, (qint64) skip.size()));
+        if(bytes < 0)
+            return false;
+        if(bytes == 0)
+            break; // position is behind end of data
+    }
+
+    return true;
+}
+
+bool QDltCompressedFile::restartAt(const QDltSeekIndex::SeekPoint &point)
+{
+    /* position the source, one byte earlier if some bits of that byte are needed */
+    if(!source->seek((point.bits > 0) ? point.in - 1 : point.in))
+        return false;
+
+    inPos = source->pos();
+    inBufferPos = 0;
+    inBufferLength = 0;
+    outPos = point.out;
+    streamEnd = false;
+    endInPos = -1;
+
+    switch(format)
+    {
+#ifdef QDLT_WITH_ZLIB
+    case FormatGzip:
+    {
+        z_stream *strm = (z_stream*) stream;
+
+        if(point.bits < 0)
+        {
+            /* start of a gzip member */
+            rawDeflate = false;
+            return inflateReset2(strm, 15 + 16) == Z_OK;
+        }
+
+        /* inside of a gzip member, continue with raw deflate data */
+        rawDeflate = true;
+        if(inflateReset2(strm, -15) != Z_OK)
+            return false;
+
+        if(point.bits > 0)
+        {
+            char c;
+            if(!source->getChar(&c))
+                return false;
+            inPos++;
+            inflatePrime(strm, point.bits, ((unsigned char) c) >> (8 - point.bits));
+        }
+
+        QByteArray window = qUncompress(point.window);
+        return inflateSetDictionary(strm, (const Bytef*) window.constData(), window.size()) == Z_OK;
+    }
+#endif
+#ifdef QDLT_WITH_ZSTD
+    case FormatZstd:
+        /* seek points are always at frame boundaries */
+        return !ZSTD_isError(ZSTD_DCtx_reset((ZSTD_DStream*) stream, ZSTD_reset_session_only));
+#endif
+    default:
+        return false;
+    }
+}
+
+bool QDltCompressedFile::fillInput()
+{
+    if(inBufferPos < inBufferLength)
+        return true;
+
+    qint64 length = source->read(inBuffer.data(), inBuffer.size());
+    if(length <= 0)
+        return false;
+
+    inBufferPos = 0;
+    inBufferLength = (int) length;
+    inPos += length;
+
+    return true;
+}
+
+qint64 QDltCompressedFile::decompress(char *data, qint64 maxSize)
+{
+    switch(format)
+    {
+    case FormatGzip:
+        return decompressGzip(data, maxSize);
+    case FormatZstd:
+        return decompressZstd(data, maxSize);
+    default:
+        return -1;
+    }
+}
+
+qint64 QDltCompressedFile::decompressGzip(char *data, qint64 maxSize)
+{
+#ifdef QDLT_WITH_ZLIB
+    z_stream *strm = (z_stream*) stream;
+    qint64 length = 0;
+
+    if(streamEnd && endInPos >= 0 && source->size() > endInPos && source->seek(endInPos))
+    {
+        /* the file has grown, e.g. during recording, continue with the appended members */
+        streamEnd = false;
+        seekIndex.uncompressedSize = -1;
+        inPos = endInPos;
+        inBufferPos = 0;
+        inBufferLength = 0;
+        rawDeflate = false;
+        endInPos = -1;
+        inflateReset2(strm, 15 + 16);
+    }
+
+    while(length < maxSize && !streamEnd)
+    {
+        if(!fillInput())
+        {
+            /* no more data yet, the member is continued if the file grows */
+            break;
+        }
+
+        uInt outSize = (uInt) qMin(maxSize - length, (qint64) 0x40000000);
+        strm->next_in = (Bytef*) inBuffer.data() + inBufferPos;
+        strm->avail_in = inBufferLength - inBufferPos;
+        strm->next_out = (Bytef*) data + length;
+        strm->avail_out = outSize;
+
+        /* stop at each deflate block boundary to be able to store seek points */
+        int ret = inflate(strm, Z_BLOCK);
+
+        inBufferPos = inBufferLength - strm->avail_in;
+        qint64 bytes = outSize - strm->avail_out;
+        length += bytes;
+        outPos += bytes;
+
+        if(ret == Z_STREAM_END)
+        {
+            /* end of gzip member, raw deflate does not consume the gzip trailer */
+            qint64 next = inPos - (inBufferLength - inBufferPos) + (rawDeflate ? 8 : 0);
+            if(next >= source->size() || !source->seek(next))
+            {
+                streamEnd = true;
+                endInPos = next;
+                break;
+            }
+
+            /* continue with the next gzip member */
+            inPos = next;
+            inBufferPos = 0;
+            inBufferLength = 0;
+            rawDeflate = false;
+            inflateReset2(strm, 15 + 16);
+            addSeekPoint(next, outPos, -1, QByteArray());
+        }
+        else if(ret == Z_BUF_ERROR && strm->avail_in == 0)
+        {
+            /* all input consumed, read next chunk */
+            continue;
+        }
+        else if(ret != Z_OK)
+        {
+            if(!rawDeflate && strm->total_out == 0 && outPos > 0)
+            {
+                /* ignore trailing garbage behind the last member */
+                streamEnd = true;
+                break;
+            }
+            qWarning() << "QDltCompressedFile: gzip data error at offset" << outPos << (strm->msg ? strm->msg : "");
+            return (length > 0) ? length : -1;
+        }
+        else if((strm->data_type & 128) && !(strm->data_type & 64) && !isIndexComplete() &&
+                outPos >= seekIndex.points.last().out + QDLT_COMPRESSED_SEEK_SPAN)
+        {
+            /* at a deflate block boundary, store the dictionary as seek point */
+            QByteArray window(QDLT_COMPRESSED_WINDOW_SIZE, 0);
+            uInt windowSize = QDLT_COMPRESSED_WINDOW_SIZE;
+            if(inflateGetDictionary(strm, (Bytef*) window.data(), &windowSize) == Z_OK)
+            {
+                window.resize(windowSize);
+                addSeekPoint(inPos - (inBufferLength - inBufferPos), outPos, strm->data_type & 7, qCompress(window));
+            }
+        }
+    }
+
+    if(outPos > knownSize)
+        knownSize = outPos;
+    if(streamEnd && !isIndexComplete())
+        seekIndex.uncompressedSize = outPos;
+
+    return length;
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+
+    return -1;
+#endif
+}
+
+qint64 QDltCompressedFile::decompressZstd(char *data, qint64 maxSize)
+{
+#ifdef QDLT_WITH_ZSTD
+    ZSTD_DStream *zds = (ZSTD_DStream*) stream;
+    qint64 length = 0;
+
+    while(length < maxSize && !streamEnd)
+    {
+        if(!fillInput())
+        {
+            /* end of file, a truncated file is treated as end of data */
+            break;
+        }
+
+        ZSTD_inBuffer input = { inBuffer.constData(), (size_t) inBufferLength, (size_t) inBufferPos };
+        ZSTD_outBuffer output = { data + length, (size_t) (maxSize - length), 0 };
+
+        size_t ret = ZSTD_decompressStream(zds, &output, &input);
+
+        inBufferPos = (int) input.pos;
+        length += output.pos;
+        outPos += output.pos;
+
+        if(ZSTD_isError(ret))
+        {
+            qWarning() << "QDltCompressedFile: zstd data error at offset" << outPos << ZSTD_getErrorName(ret);
+            return (length > 0) ? length : -1;
+        }
+
+        if(ret == 0)
+        {
+            /* frame completely decoded, the next frame is a seek point,
+             * zstd cannot restart inside a frame, a skippable frame adds no seek point */
+            qint64 next = inPos - (inBufferLength - inBufferPos);
+            if(next >= source->size())
+            {
+                streamEnd = true;
+                break;
+            }
+            addSeekPoint(next, outPos, -1, QByteArray());
+        }
+    }
+
+    if(outPos > knownSize)
+        knownSize = outPos;
+    if(streamEnd && !isIndexComplete())
+        seekIndex.uncompressedSize = outPos;
+
+    return length;
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(maxSize);
+
+    return -1;
+#endif
+}
+
+void QDltCompressedFile::addSeekPoint(qint64 in, qint64 out, int bits, const QByteArray &window)
+{
+    /* only add seek points behind the already known ones */
+    if(!seekIndex.points.isEmpty() && out <= seekIndex.points.last().out)
+        return;
+
+    QDltSeekIndex::SeekPoint point;
+    point.in = in;
+    point.out = out;
+    point.bits = bits;
+    point.window = window;
+
+    seekIndex.points.append(point);
+}
+
+void QDltCompressedFile::initStream()
+{
+    freeStream();
+
+    switch(format)
+    {
+#ifdef QDLT_WITH_ZLIB
+    case FormatGzip:
+    {
+        z_stream *strm = new z_stream;
+        memset(strm, 0, sizeof(z_stream));
+        if(inflateInit2(strm, 15 + 16) != Z_OK)
+        {
+            delete strm;
+            return;
+        }
+        stream = strm;
+        break;
+    }
+#endif
+#ifdef QDLT_WITH_ZSTD
+    case FormatZstd:
+        stream = ZSTD_createDStream();
+        break;
+#endif
+    default:
+        break;
+    }
+}
+
+void QDltCompressedFile::freeStream()
+{
+    if(!stream)
+        return;
+
+    switch(format)
+    {
+#ifdef QDLT_WITH_ZLIB
+    case FormatGzip:
+        inflateEnd((z_stream*) stream);
+        delete (z_stream*) stream;
+        break;
+#endif
+#ifdef QDLT_WITH_ZSTD
+    case FormatZstd:
+        ZSTD_freeDStream((ZSTD_DStream*) stream);
+        break;
+#endif
+    default:
+        break;
+    }
+
+    stream = 0;
+}
@@ -0,0 +1,260 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltcompressedfile.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_COMPRESSED_FILE_H
+#define QDLT_COMPRESSED_FILE_H
+
+#include <QIODevice>
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+
+#include "export_rules.h"
+
+//! Distance in uncompressed bytes between two seek points of a compressed file.
+#define QDLT_COMPRESSED_SEEK_SPAN (1024*1024)
+
+//! Version of the persisted seek index file format.
+#define QDLT_COMPRESSED_SEEK_INDEX_VERSION 1
+
+//! Size of the footer member of a block compressed file written by QDltCompressedWriter.
+#define QDLT_COMPRESSED_FOOTER_SIZE 50
+
+//! Seek index of a compressed DLT log file.
+/*!
+  A seek point stores everything needed to restart decompression in the
+  middle of a compressed stream. For gzip this is the bit position of a
+  deflate block boundary and the 32 kByte dictionary preceding it; the
+  start of a gzip member or a zstd frame needs no dictionary at all.
+*/
+class QDLT_EXPORT QDltSeekIndex
+{
+public:
+    //! One restart position in the compressed stream.
+    class SeekPoint
+    {
+    public:
+        //! Offset in the compressed file of the first complete byte.
+        qint64 in;
+
+        //! Offset in the uncompressed data.
+        qint64 out;
+
+        //! Number of bits of the byte before "in" still to be used, -1 if the point is the start of a member or frame.
+        int bits;
+
+        //! Dictionary needed to restart, stored compressed with qCompress().
+        QByteArray window;
+    };
+
+    //! Constructor.
+    QDltSeekIndex();
+
+    //! Remove all seek points.
+    void clear();
+
+    //! Save the seek index to a file.
+    /*!
+      \param filename The name of the index file
+      \param sourceSize Size of the compressed file, used to validate the index on load
+      \return true if the operation was successful, false if an error occurred.
+    */
+    bool save(const QString &filename, qint64 sourceSize) const;
+
+    //! Load the seek index from a file.
+    /*!
+      \param filename The name of the index file
+      \param sourceSize Size of the compressed file, the index is rejected if it does not match
+      \return true if the operation was successful, false if an error occurred.
+    */
+    bool load(const QString &filename, qint64 sourceSize);
+
+    //! All seek points sorted by uncompressed offset.
+    QVector<SeekPoint> points;
+
+    //! Size of the complete uncompressed data, -1 if not known yet.
+    qint64 uncompressedSize;
+};
+
+//! Random access to a compressed DLT log file.
+/*!
+  This class decompresses a gzip (.dlt.gz) or zstd (.dlt.zst) file on the fly
+  and provides the uncompressed data as a random access QIODevice.
+  While gzip data is read sequentially a seek point is stored every
+  QDLT_COMPRESSED_SEEK_SPAN bytes, so later random access only needs to
+  decompress a single block. zstd can only restart at the start of a frame,
+  so seek points are stored at frame boundaries only. The seek table of the
+  zstd seekable format is read on open, so such files are seekable per frame
+  right away. A zstd file without seek table is seekable at the frame
+  boundaries found while reading; a single frame file is not randomly
+  accessible at all, see isRandomAccess().
+  The seek index can be persisted and set again to avoid the first sequential pass.
+  The compressed data is read from a source device, which must be opened
+  before and is not owned by this class.
+  This class is currently not thread safe.
+*/
+class QDLT_EXPORT QDltCompressedFile : public QIODevice
+{
+public:
+    //! The compression format of the file.
+    typedef enum { FormatNone, FormatGzip, FormatZstd } FormatDef;
+
+    //! Constructor.
+    /*!
+      \param source The device containing the compressed data.
+    */
+    QDltCompressedFile(QIODevice *source);
+
+    //! Destructor.
+    ~QDltCompressedFile();
+
+    //! Detect the compression format by the magic bytes of the data.
+    /*!
+      The position of the device is not changed.
+      \param device The opened device.
+      \return The detected format, FormatNone if data is not compressed or the format is not supported by this build.
+    */
+    static FormatDef detectFormat(QIODevice *device);
+
+    //! Read the block index appended to a file written by QDltCompressedWriter.
+    /*!
+      The position of the device is changed.
+      \param device The opened device containing the compressed data.
+      \param index Seek index filled with one seek point per block.
+      \param indexOffset Offset of the first index member in the file.
+      \return true if a valid block index was found.
+    */
+    static bool readBlockIndex(QIODevice *device, QDltSeekIndex &index, qint64 &indexOffset);
+
+    //! Read the seek table of a file written in the zstd seekable format.
+    /*!
+      The seek table is a skippable frame at the end of the file with the
+      compressed and decompressed size of each frame.
+      The position of the device is changed.
+      \param device The opened device containing the compressed data.
+      \param index Seek index filled with one seek point per frame.
+      \return true if a valid seek table was found.
+    */
+    static bool readSeekTable(QIODevice *device, QDltSeekIndex &index);
+
+    //! Check if a file is compressed with a supported format.
+    /*!
+      \param filename The name of the file.
+      \return true if the file is compressed.
+    */
+    static bool isCompressedFile(const QString &filename);
+
+    //! Get the compression format of the source.
+    FormatDef getFormat() const { return format; }
+
+    //! Open the device, only QIODevice::ReadOnly is supported.
+    bool open(OpenMode mode);
+
+    //! Close the device, the seek index is kept.
+    void close();
+
+    //! Random access is supported.
+    bool isSequential() const { return false; }
+
+    //! Get the size of the uncompressed data.
+    /*!
+      As long as the data was not read completely once and no complete
+      seek index was set, this is the amount of uncompressed data known so far.
+      \return size of the uncompressed data
+    */
+    qint64 size() const;
+
+    //! Check if a seek does not need to decompress the file from its start.
+    /*!
+      gzip files are always randomly accessible, zstd files only if they
+      consist of more than one frame. Without seek table this is known only
+      after the frames were found by reading.
+      \return true if seek points behind the start of the file exist or can be created
+    */
+    bool isRandomAccess() const;
+
+    //! Check if the uncompressed size and all seek points are known.
+    bool isIndexComplete() const { return seekIndex.uncompressedSize >= 0; }
+
+    //! Get the seek index created so far.
+    const QDltSeekIndex &getSeekIndex() const { return seekIndex; }
+
+    //! Set a seek index created before, e.g. loaded from the index cache.
+    void setSeekIndex(const QDltSeekIndex &index);
+
+protected:
+    qint64 readData(char *data, qint64 maxSize);
+    qint64 writeData(const char *data, qint64 maxSize);
+
+private:
+    //! Restart decompression so that the next output byte is at position pos.
+    bool seekStream(qint64 pos);
+
+    //! Restart decompression at a seek point.
+    bool restartAt(const QDltSeekIndex::SeekPoint &point);
+
+    //! Decompress the next bytes of the stream.
+    qint64 decompress(char *data, qint64 maxSize);
+    qint64 decompressGzip(char *data, qint64 maxSize);
+    qint64 decompressZstd(char *data, qint64 maxSize);
+
+    //! Read the next chunk of compressed data from the source.
+    bool fillInput();
+
+    //! Store a new seek point, if it extends the seek index.
+    void addSeekPoint(qint64 in, qint64 out, int bits, const QByteArray &window);
+
+    void initStream();
+    void freeStream();
+
+    QIODevice *source;
+    FormatDef format;
+
+    //! zlib or zstd stream state.
+    void *stream;
+
+    //! Stream decompresses raw deflate data after restart inside a gzip member.
+    bool rawDeflate;
+
+    //! End of the compressed data was reached.
+    bool streamEnd;
+
+    //! Offset in the source where the data ended at a member boundary, -1 if unknown.
+    qint64 endInPos;
+
+    //! Compressed input buffer.
+    QByteArray inBuffer;
+    int inBufferPos;
+    int inBufferLength;
+
+    //! Offset in the source behind the last byte read into the input buffer.
+    qint64 inPos;
+
+    //! Offset in the uncompressed data of the next decompressed byte.
+    qint64 outPos;
+
+    //! Largest uncompressed offset decompressed so far.
+    qint64 knownSize;
+
+    QDltSeekIndex seekIndex;
+};
+
+#endif // QDLT_COMPRESSED_FILE_H
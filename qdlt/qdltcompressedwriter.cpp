@@ -0,0 +1,384 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltcompressedwriter.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QMutexLocker>
+#include <QtEndian>
+#include <QtDebug>
+#include <string.h>
+
+#include "qdltbase.h"
+#include "qdltcompressedfile.h"
+#include "qdltcompressedwriter.h"
+#include "qdltmetrics.h"
+
+#ifdef QDLT_WITH_ZLIB
+#include <zlib.h>
+#endif
+
+/* Maximum number of block index entries in one index member */
+#define QDLT_COMPRESSED_WRITER_INDEX_ENTRIES 4000
+
+/* Create an empty gzip member with a single extra subfield 'D' id */
+static QByteArray emptyMember(char id, const QByteArray &payload)
+{
+    QByteArray member;
+    uchar length[2];
+
+    /* gzip header with flag FEXTRA, no time, unknown OS */
+    member.append("\x1f\x8b\x08\x04\x00\x00\x00\x00\x00\xff", 10);
+    qToLittleEndian<quint16>(payload.size() + 4, length);
+    member.append((const char*) length, 2);
+
+    /* extra subfield */
+    member.append('D');
+    member.append(id);
+    qToLittleEndian<quint16>(payload.size(), length);
+    member.append((const char*) length, 2);
+    member.append(payload);
+
+    /* empty final deflate block, crc32 and size of empty data */
+    member.append("\x03\x00", 2);
+    member.append(QByteArray(8, 0));
+
+    return member;
+}
+
+QDltCompressedWriter::QDltCompressedWriter(QObject *parent) :
+    QThread(parent)
+{
+    fileOffset = 0;
+    stopRequested = false;
+    queueWarned = false;
+    storeWarned = false;
+    blockSize = QDLT_COMPRESSED_WRITER_BLOCK_SIZE;
+    flushInterval = QDLT_COMPRESSED_WRITER_FLUSH_INTERVAL;
+    compressionLevel = 6;
+    blockIndexValid = true;
+    uncompressedSize = 0;
+    bytesIn = 0;
+    bytesOut = 0;
+    blocks = 0;
+    msecsCompress = 0;
+    msecsWrite = 0;
+}
+
+QDltCompressedWriter::~QDltCompressedWriter()
+{
+    close();
+}
+
+bool QDltCompressedWriter::open(const QString &filename)
+{
+    close();
+
+    file.setFileName(filename);
+    fileOffset = 0;
+    stopRequested = false;
+    currentBlock.clear();
+    queue.clear();
+    queueWarned = false;
+    storeWarned = false;
+    blockIndex.clear();
+    blockIndexValid = true;
+    uncompressedSize = 0;
+    bytesIn = 0;
+    bytesOut = 0;
+    blocks = 0;
+    msecsCompress = 0;
+    msecsWrite = 0;
+
+#ifndef QDLT_WITH_ZLIB
+    qWarning() << "QDltCompressedWriter: compression is not supported by this build";
+    return false;
+#endif
+
+    if(!file.open(QIODevice::ReadWrite | QIODevice::Append))
+    {
+        qWarning() << "QDltCompressedWriter: cannot open" << filename << file.errorString();
+        return false;
+    }
+
+    if(file.size() > 0)
+    {
+        /* data can only be appended to a compressed file */
+        if(QDltCompressedFile::detectFormat(&file) != QDltCompressedFile::FormatGzip)
+        {
+            qWarning() << "QDltCompressedWriter: cannot append to uncompressed file" << filename;
+            file.close();
+            return false;
+        }
+
+        /* continue the block index of the last session, the old index stays as empty members */
+        QDltSeekIndex index;
+        qint64 indexOffset;
+        if(QDltCompressedFile::readBlockIndex(&file, index, indexOffset))
+        {
+            for(int num=0;num<index.points.size();num++)
+                blockIndex.append(qMakePair(index.points[num].in, index.points[num].out));
+            uncompressedSize = index.uncompressedSize;
+        }
+        else
+        {
+            /* without index of the existing data the reader has to scan the file anyway */
+            blockIndexValid = false;
+        }
+    }
+
+    fileOffset = file.size();
+
+    start();
+
+    return true;
+}
+
+void QDltCompressedWriter::close()
+{
+    if(!file.isOpen())
+        return;
+
+    /* write all pending blocks */
+    mutex.lock();
+    stopRequested = true;
+    condition.wakeOne();
+    mutex.unlock();
+    wait();
+
+    if(blockIndexValid && !blockIndex.isEmpty())
+        writeBlockIndex();
+
+    file.close();
+}
+
+void QDltCompressedWriter::write(const char *data, int size)
+{
+    QMutexLocker locker(&mutex);
+
+    if(currentBlock.isEmpty())
+    {
+        currentBlock.reserve(blockSize + DLT_MAX_MESSAGE_LEN);
+        currentBlockAge.start();
+    }
+
+    currentBlock.append(data, size);
+
+    if(currentBlock.size() >= blockSize)
+    {
+        queueCurrentBlock();
+        condition.wakeOne();
+    }
+}
+
+void QDltCompressedWriter::queueCurrentBlock()
+{
+    static QDltMetricGauge *queueGauge = QDltMetrics::instance()->gauge("writer.queue");
+
+    queue.enqueue(currentBlock);
+    currentBlock = QByteArray();
+    queueGauge->set(queue.size());
+
+    if(queue.size() >= QDLT_COMPRESSED_WRITER_WARN_QUEUE && !queueWarned)
+    {
+        qWarning() << "QDltCompressedWriter: compression is slower than received data, queued blocks:" << queue.size();
+        queueWarned = true;
+    }
+}
+
+void QDltCompressedWriter::run()
+{
+    QElapsedTimer timer;
+    QDltMetricHistogram *compressTime = QDltMetrics::instance()->histogram("writer.compress");
+    QDltMetricHistogram *flushTime = QDltMetrics::instance()->histogram("writer.flush");
+    QDltMetricCounter *bytesWritten = QDltMetrics::instance()->counter("writer.bytes");
+    QDltMetricGauge *queueGauge = QDltMetrics::instance()->gauge("writer.queue");
+
+    QDltMetricCounter *backpressure = QDltMetrics::instance()->counter("writer.backpressure");
+
+    forever
+    {
+        QByteArray block;
+        bool store;
+
+        /* wait for a full block, the flush interval or the stop request */
+        mutex.lock();
+        while(queue.isEmpty())
+        {
+            if(!currentBlock.isEmpty() && (stopRequested || currentBlockAge.elapsed() >= flushInterval))
+            {
+                queueCurrentBlock();
+                break;
+            }
+            if(stopRequested)
+            {
+                mutex.unlock();
+                return;
+            }
+            condition.wait(&mutex, (flushInterval > 0) ? flushInterval : ULONG_MAX);
+        }
+        /* store the block uncompressed, if compression is too slow to empty the queue */
+        store = (queue.size() >= QDLT_COMPRESSED_WRITER_MAX_QUEUE);
+        if(store && !storeWarned)
+        {
+            qWarning() << "QDltCompressedWriter: queue full, storing blocks uncompressed, queued blocks:" << queue.size();
+            storeWarned = true;
+        }
+        block = queue.dequeue();
+        queueGauge->set(queue.size());
+        if(queue.size() < QDLT_COMPRESSED_WRITER_WARN_QUEUE)
+        {
+            queueWarned = false;
+            storeWarned = false;
+        }
+        mutex.unlock();
+
+        /* compress block, level 0 only stores the data */
+        QByteArray member;
+        timer.start();
+        if(store)
+            backpressure->add();
+        if(!compressBlock(block, member, store ? 0 : compressionLevel))
+        {
+            qWarning() << "QDltCompressedWriter: compression of block failed," << block.size() << "bytes lost";
+            continue;
+        }
+        compressTime->record(timer.nsecsElapsed());
+        qint64 msecsCompressBlock = timer.restart();
+
+        /* write block to file */
+        if(file.write(member) != member.size())
+        {
+            qWarning() << "QDltCompressedWriter: write to" << file.fileName() << "failed" << file.errorString();
+            blockIndexValid = false;
+        }
+        file.flush();
+        flushTime->record(timer.nsecsElapsed());
+        bytesWritten->add(member.size());
+        qint64 msecsWriteBlock = timer.elapsed();
+
+        blockIndex.append(qMakePair(fileOffset, uncompressedSize));
+        fileOffset += member.size();
+        uncompressedSize += block.size();
+
+        mutex.lock();
+        bytesIn += block.size();
+        bytesOut += member.size();
+        blocks++;
+        msecsCompress += msecsCompressBlock;
+        msecsWrite += msecsWriteBlock;
+        mutex.unlock();
+
+        emit blockWritten(block.size());
+    }
+}
+
+void QDltCompressedWriter::writeBlockIndex()
+{
+    QByteArray data;
+    uchar value[8];
+
+    /* index members with up to QDLT_COMPRESSED_WRITER_INDEX_ENTRIES entries each */
+    for(int num=0;num<blockIndex.size();num+=QDLT_COMPRESSED_WRITER_INDEX_ENTRIES)
+    {
+        QByteArray entries;
+        for(int entry=num;entry<blockIndex.size() && entry<num+QDLT_COMPRESSED_WRITER_INDEX_ENTRIES;entry++)
+        {
+            qToLittleEndian<qint64>(blockIndex[entry].first, value);
+            entries.append((const char*) value, 8);
+            qToLittleEndian<qint64>(blockIndex[entry].second, value);
+            entries.append((const char*) value, 8);
+        }
+        data += emptyMember('I', entries);
+    }
+
+    /* footer with position of the index */
+    QByteArray footer;
+    qToLittleEndian<qint64>(fileOffset, value);
+    footer.append((const char*) value, 8);
+    qToLittleEndian<qint64>(blockIndex.size(), value);
+    footer.append((const char*) value, 8);
+    qToLittleEndian<qint64>(uncompressedSize, value);
+    footer.append((const char*) value, 8);
+    data += emptyMember('F', footer);
+
+    if(file.write(data) != data.size())
+        qWarning() << "QDltCompressedWriter: write of block index failed" << file.errorString();
+
+    fileOffset += data.size();
+}
+
+bool QDltCompressedWriter::compressBlock(const QByteArray &data, QByteArray &member, int level)
+{
+#ifdef QDLT_WITH_ZLIB
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+
+    /* window bits 15 + 16 writes a gzip header and trailer */
+    if(deflateInit2(&strm, level, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return false;
+
+    member.resize(deflateBound(&strm, data.size()) + 32);
+    strm.next_in = (Bytef*) data.constData();
+    strm.avail_in = data.size();
+    strm.next_out = (Bytef*) member.data();
+    strm.avail_out = member.size();
+
+    int ret = deflate(&strm, Z_FINISH);
+    member.resize(member.size() - strm.avail_out);
+    deflateEnd(&strm);
+
+    return ret == Z_STREAM_END;
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(member);
+    Q_UNUSED(level);
+
+    return false;
+#endif
+}
+
+qint64 QDltCompressedWriter::getBytesIn()
+{
+    QMutexLocker locker(&mutex);
+    return bytesIn;
+}
+
+qint64 QDltCompressedWriter::getBytesOut()
+{
+    QMutexLocker locker(&mutex);
+    return bytesOut;
+}
+
+qint64 QDltCompressedWriter::getBlocks()
+{
+    QMutexLocker locker(&mutex);
+    return blocks;
+}
+
+qint64 QDltCompressedWriter::getMsecsCompress()
+{
+    QMutexLocker locker(&mutex);
+    return msecsCompress;
+}
+
+qint64 QDltCompressedWriter::getMsecsWrite()
+{
+    QMutexLocker locker(&mutex);
+    return msecsWrite;
+}
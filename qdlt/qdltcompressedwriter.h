@@ -0,0 +1,177 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltcompressedwriter.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_COMPRESSED_WRITER_H
+#define QDLT_COMPRESSED_WRITER_H
+
+#include <QThread>
+#include <QFile>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QVector>
+#include <QPair>
+#include <QElapsedTimer>
+
+#include "export_rules.h"
+
+//! Default size of uncompressed data in one block.
+#define QDLT_COMPRESSED_WRITER_BLOCK_SIZE (1024*1024)
+
+//! Default time in ms after which a partly filled block is written.
+#define QDLT_COMPRESSED_WRITER_FLUSH_INTERVAL 1000
+
+//! Number of queued blocks at which the writer thread stores blocks uncompressed to catch up.
+#define QDLT_COMPRESSED_WRITER_MAX_QUEUE 64
+
+//! Number of queued blocks at which a warning is logged, each time the queue grows to it again.
+#define QDLT_COMPRESSED_WRITER_WARN_QUEUE 16
+
+//! Write a block compressed DLT log file in a background thread.
+/*!
+  The written file is a valid multi member gzip file, so it can be read by
+  any gzip tool and by QDltCompressedFile:
+  - each block of up to QDLT_COMPRESSED_WRITER_BLOCK_SIZE bytes of DLT data is an independent gzip member
+  - on close the block index is appended as empty gzip members with the extra subfield 'DI',
+    containing the compressed and uncompressed offset of each block
+  - the last member is an empty gzip member of QDLT_COMPRESSED_FOOTER_SIZE bytes with the
+    extra subfield 'DF', containing the offset of the index, the number of blocks and the uncompressed size
+
+  If the file was not closed properly the block index is missing and the reader
+  finds the blocks by decompressing the file once.
+  Data is collected by write(); the compression and writing is done in the writer thread.
+  write() never waits for the writer thread. If QDLT_COMPRESSED_WRITER_MAX_QUEUE blocks
+  are waiting for compression, the blocks are stored uncompressed until the queue is
+  short again, so the queue is emptied at the speed of the disk.
+*/
+class QDLT_EXPORT QDltCompressedWriter : public QThread
+{
+    Q_OBJECT
+public:
+    //! Constructor.
+    QDltCompressedWriter(QObject *parent = 0);
+
+    //! Destructor, closes the file.
+    ~QDltCompressedWriter();
+
+    //! Open the file and start the writer thread.
+    /*!
+      Data is appended, if the file already exists and is a compressed file.
+      \param filename The name of the file.
+      \return true if the operation was successful, false if an error occurred.
+    */
+    bool open(const QString &filename);
+
+    //! Write all pending data, append the block index and close the file.
+    void close();
+
+    //! Check if the writer is active.
+    bool isOpen() const { return file.isOpen(); }
+
+    //! Get the name of the file.
+    QString fileName() const { return file.fileName(); }
+
+    //! Set the size of uncompressed data in one block.
+    void setBlockSize(int size) { blockSize = size; }
+
+    //! Set the time in ms after which a partly filled block is written.
+    void setFlushInterval(int msecs) { flushInterval = msecs; }
+
+    //! Set the zlib compression level 1..9.
+    void setCompressionLevel(int level) { compressionLevel = level; }
+
+    //! Add data to the file, this function is thread safe.
+    /*!
+      \param data pointer to the data
+      \param size size of the data
+    */
+    void write(const char *data, int size);
+
+    //! Get the number of uncompressed bytes written so far.
+    qint64 getBytesIn();
+
+    //! Get the number of compressed bytes written so far.
+    qint64 getBytesOut();
+
+    //! Get the number of written blocks.
+    qint64 getBlocks();
+
+    //! Get the time spent in compression in ms.
+    qint64 getMsecsCompress();
+
+    //! Get the time spent in writing to the file in ms.
+    qint64 getMsecsWrite();
+
+    //! Compress one block of data into a gzip member.
+    /*!
+      \param data the uncompressed data
+      \param member the resulting gzip member
+      \param level zlib compression level
+      \return true if the operation was successful, false if an error occurred.
+    */
+    static bool compressBlock(const QByteArray &data, QByteArray &member, int level);
+
+signals:
+    //! A block was written to the file.
+    void blockWritten(qint64 uncompressedSize);
+
+protected:
+    void run();
+
+private:
+    //! Move the currently collected data to the queue, must be called with locked mutex.
+    void queueCurrentBlock();
+
+    //! Append the block index and the footer to the file.
+    void writeBlockIndex();
+
+    QFile file;
+
+    //! Size of the file, the next block is written at this offset.
+    qint64 fileOffset;
+
+    QMutex mutex;
+    QWaitCondition condition;
+    QQueue<QByteArray> queue;
+    bool queueWarned;
+    bool storeWarned;
+    QByteArray currentBlock;
+    QElapsedTimer currentBlockAge;
+    bool stopRequested;
+
+    int blockSize;
+    int flushInterval;
+    int compressionLevel;
+
+    //! Compressed and uncompressed offset of each block, only accessed by the writer thread.
+    QVector<QPair<qint64,qint64> > blockIndex;
+    bool blockIndexValid;
+    qint64 uncompressedSize;
+
+    // statistics
+    qint64 bytesIn;
+    qint64 bytesOut;
+    qint64 blocks;
+    qint64 msecsCompress;
+    qint64 msecsWrite;
+};
+
+#endif // QDLT_COMPRESSED_WRITER_H
@@ -64,7 +64,11 @@ bool QDltConnection::getSyncSerialHeader() const
 void QDltConnection::clear()
 {
     data.clear();
+    /* keep the memory of the receive buffer, when all data is parsed */
+    data.reserve(QDLT_CONNECTION_COMPACT_SIZE);
     dataView.align(data);
+    syncPos = 0;
+    scanPos = 0;
     bytesReceived = 0;
     bytesError = 0;
     syncFound = 0;
@@ -74,9 +78,17 @@ void QDltConnection::add(const QByteArray &bytes)
 {
     bytesReceived += bytes.size();
 
-    data = dataView + bytes;
+    /* remove the parsed data only occasionally, so the unparsed data is not copied on every read */
+    int parsed = data.size() - dataView.size();
+    if(parsed > 0 && (dataView.size() == 0 || (parsed >= QDLT_CONNECTION_COMPACT_SIZE && parsed >= dataView.size())))
+    {
+        data.remove(0,parsed);
+        parsed = 0;
+    }
 
-    dataView.align(data);
+    data.append(bytes);
+
+    dataView.align(data,parsed);
 }
 
 bool QDltConnection::parse(QDltMsg &msg)
@@ -92,8 +104,19 @@ bool QDltConnection::parse(QDltMsg &msg)
     int cbuf_sz = dataView.size();
     const char *cbuf = dataView.constData();
 
+    /* continue the search for the second header behind the data searched before */
+    int start = 0;
+    if(syncSerialHeader && syncPos > 0)
+    {
+        found = 1;
+        firstPos = syncPos;
+        start = qMax(firstPos, scanPos - 3);
+    }
+    syncPos = 0;
+    scanPos = 0;
+
     /* find marker in buffer */
-    for(int num=0;num<cbuf_sz;num++) {
+    for(int num=start;num<cbuf_sz;num++) {
         if(cbuf[num] == 'D')
         {
             lastFound = 'D';
@@ -139,6 +162,13 @@ bool QDltConnection::parse(QDltMsg &msg)
             bytesError += dataView.size();
             dataView.clear();
         }
+        else
+        {
+            /* keep only the start of the sync header */
+            int keep = (lastFound == 'D') ? 1 : ((lastFound == 'L') ? 2 : 3);
+            bytesError += dataView.size() - keep;
+            dataView.advance(dataView.size() - keep);
+        }
         return false;
     }
 
@@ -186,6 +216,12 @@ bool QDltConnection::parse(QDltMsg &msg)
             bytesError += dataView.size();
             dataView.clear();
         }
+        else if(syncSerialHeader && found == 1)
+        {
+            /* remember the searched data, so it is not searched again when more data is received */
+            syncPos = firstPos;
+            scanPos = cbuf_sz;
+        }
         return false;
     }
 
@@ -33,6 +33,9 @@
 #include "export_rules.h"
 #include "qdltmsg.h"
 
+//! Parsed data in the receive buffer is only removed, if it exceeds this size.
+#define QDLT_CONNECTION_COMPACT_SIZE (64*1024)
+
 class QDLT_EXPORT QDltDataView
 {
 public:
@@ -99,9 +102,22 @@ public:
     void setSyncSerialHeader(bool _syncSerialHeader);
     bool getSyncSerialHeader() const;
 
+    //! Parse the next message from the receive buffer.
+    /*!
+      The message is parsed in place, the parsed data stays in the buffer until it is compacted.
+      \param msg The parsed message.
+      \return true if a message was parsed, false if more data is needed.
+    */
     bool parse(QDltMsg &msg);
 
     void clear();
+
+    //! Append received data to the receive buffer.
+    /*!
+      The unparsed data is not copied, parsed data is removed only
+      if it exceeds QDLT_CONNECTION_COMPACT_SIZE and the unparsed data.
+      \param bytes The received data.
+    */
     void add(const QByteArray &bytes);
 
     QByteArray data;
@@ -116,6 +132,11 @@ protected:
     bool sendSerialHeader;
     bool syncSerialHeader;
 
+    //! Position in the unparsed data behind a serial header, whose message is not complete yet, 0 if none.
+    int syncPos;
+
+    //! Size of the unparsed data already searched for the next serial header.
+    int scanPos;
 
 
 };
@@ -0,0 +1,325 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltdecodedmsgcache.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QDataStream>
+#include <QMutexLocker>
+#include <QtEndian>
+#include <QtDebug>
+#include <string.h>
+
+#include "qdlt.h"
+
+/* magic of header and footer */
+static const char decodedMsgCacheMagic[4] = { 'D', 'D', 'M', 'C' };
+
+/* size of header and footer */
+#define QDLT_DECODED_MSG_CACHE_HEADER_SIZE 12
+#define QDLT_DECODED_MSG_CACHE_FOOTER_SIZE 12
+
+QDltDecodedMsgCache::QDltDecodedMsgCache()
+{
+    temporary = false;
+    generation = 0;
+    writePos = 0;
+    map = 0;
+}
+
+QDltDecodedMsgCache::~QDltDecodedMsgCache()
+{
+    clear();
+}
+
+bool QDltDecodedMsgCache::create(const QString &filename, int size, bool temporary)
+{
+    clear();
+
+    file.setFileName(filename);
+    if(!file.open(QIODevice::ReadWrite | QIODevice::Truncate))
+    {
+        qWarning() << "QDltDecodedMsgCache: cannot create" << filename << file.errorString();
+        return false;
+    }
+    this->temporary = temporary;
+
+    /* header */
+    uchar header[QDLT_DECODED_MSG_CACHE_HEADER_SIZE];
+    memcpy(header, decodedMsgCacheMagic, 4);
+    qToLittleEndian<quint32>(QDLT_DECODED_MSG_CACHE_VERSION, header + 4);
+    qToLittleEndian<qint32>(size, header + 8);
+    if(file.write((const char*) header, sizeof(header)) != sizeof(header))
+    {
+        file.close();
+        file.remove();
+        return false;
+    }
+    writePos = sizeof(header);
+
+    offsets.fill(-1, size);
+    generation = QDltPlugin::getConfigGeneration();
+    state.store(StateRecording);
+
+    return true;
+}
+
+void QDltDecodedMsgCache::store(int index, const QDltMsg &msg)
+{
+    if(!isRecording() || index < 0 || index >= offsets.size())
+        return;
+
+    /* the decoder plugins changed while recording, the cache is dropped by finish() */
+    if(generation != QDltPlugin::getConfigGeneration())
+        return;
+
+    QByteArray record = writeRecord(msg);
+    uchar length[4];
+    qToLittleEndian<quint32>(record.size(), length);
+
+    QMutexLocker locker(&mutex);
+
+    if(file.write((const char*) length, 4) != 4 || file.write(record) != record.size())
+    {
+        /* incomplete cache is useless */
+        qWarning() << "QDltDecodedMsgCache: write to" << file.fileName() << "failed" << file.errorString();
+        state.store(StateNone);
+        return;
+    }
+    offsets[index] = writePos;
+    writePos += 4 + record.size();
+}
+
+bool QDltDecodedMsgCache::finish()
+{
+    if(!isRecording())
+        return false;
+
+    if(generation != QDltPlugin::getConfigGeneration())
+    {
+        clear();
+        return false;
+    }
+
+    /* table of offsets and footer */
+    QByteArray table;
+    table.resize(offsets.size() * 8 + QDLT_DECODED_MSG_CACHE_FOOTER_SIZE);
+    uchar *data = (uchar*) table.data();
+    for(int num=0;num<offsets.size();num++)
+        qToLittleEndian<qint64>(offsets[num], data + num * 8);
+    qToLittleEndian<qint64>(writePos, data + offsets.size() * 8);
+    memcpy(data + offsets.size() * 8 + 8, decodedMsgCacheMagic, 4);
+
+    if(file.write(table) != table.size() || !file.flush())
+    {
+        qWarning() << "QDltDecodedMsgCache: write to" << file.fileName() << "failed" << file.errorString();
+        clear();
+        return false;
+    }
+
+    map = file.map(0, file.size());
+    state.store(StateComplete);
+
+    return true;
+}
+
+bool QDltDecodedMsgCache::load(const QString &filename, int size)
+{
+    clear();
+
+    file.setFileName(filename);
+    if(!file.open(QIODevice::ReadOnly))
+        return false;
+
+    /* check header and footer */
+    uchar header[QDLT_DECODED_MSG_CACHE_HEADER_SIZE];
+    uchar footer[QDLT_DECODED_MSG_CACHE_FOOTER_SIZE];
+    qint64 fileSize = file.size();
+    if(fileSize < (qint64) (sizeof(header) + sizeof(footer)) ||
+       file.read((char*) header, sizeof(header)) != sizeof(header) ||
+       !file.seek(fileSize - sizeof(footer)) ||
+       file.read((char*) footer, sizeof(footer)) != sizeof(footer) ||
+       memcmp(header, decodedMsgCacheMagic, 4) != 0 ||
+       memcmp(footer + 8, decodedMsgCacheMagic, 4) != 0 ||
+       qFromLittleEndian<quint32>(header + 4) != QDLT_DECODED_MSG_CACHE_VERSION ||
+       qFromLittleEndian<qint32>(header + 8) != size)
+    {
+        file.close();
+        return false;
+    }
+
+    /* read table */
+    qint64 tablePos = qFromLittleEndian<qint64>(footer);
+    if(tablePos + (qint64) size * 8 + (qint64) sizeof(footer) != fileSize || !file.seek(tablePos))
+    {
+        file.close();
+        return false;
+    }
+    QByteArray table = file.read((qint64) size * 8);
+    if(table.size() != size * 8)
+    {
+        file.close();
+        return false;
+    }
+    offsets.resize(size);
+    const uchar *data = (const uchar*) table.constData();
+    for(int num=0;num<size;num++)
+        offsets[num] = qFromLittleEndian<qint64>(data + num * 8);
+
+    temporary = false;
+    map = file.map(0, fileSize);
+    generation = QDltPlugin::getConfigGeneration();
+    state.store(StateComplete);
+
+    return true;
+}
+
+void QDltDecodedMsgCache::clear()
+{
+    bool remove = temporary || isRecording();
+
+    state.store(StateNone);
+
+    if(map)
+    {
+        file.unmap(map);
+        map = 0;
+    }
+    if(file.isOpen())
+    {
+        file.close();
+        if(remove)
+            file.remove();
+    }
+
+    offsets.clear();
+    writePos = 0;
+    temporary = false;
+}
+
+bool QDltDecodedMsgCache::isComplete() const
+{
+    return state.load() == StateComplete && generation == QDltPlugin::getConfigGeneration();
+}
+
+bool QDltDecodedMsgCache::isOutdated() const
+{
+    return state.load() == StateComplete && generation != QDltPlugin::getConfigGeneration();
+}
+
+QDltDecodedMsgCache::LookupResult QDltDecodedMsgCache::lookup(int index, QDltMsg &msg) const
+{
+    if(!isComplete() || index < 0 || index >= offsets.size())
+        return CacheMiss;
+
+    qint64 offset = offsets[index];
+    if(offset < 0)
+        return CacheNotDecoded;
+
+    QByteArray record;
+    if(map)
+    {
+        quint32 length = qFromLittleEndian<quint32>(map + offset);
+        record = QByteArray::fromRawData((const char*) map + offset + 4, length);
+    }
+    else
+    {
+        QMutexLocker locker(&mutex);
+        uchar length[4];
+        if(!file.seek(offset) || file.read((char*) length, 4) != 4)
+            return CacheMiss;
+        record = file.read(qFromLittleEndian<quint32>(length));
+    }
+
+    if(!readRecord(record, msg))
+        return CacheMiss;
+
+    return CacheDecoded;
+}
+
+QByteArray QDltDecodedMsgCache::writeRecord(const QDltMsg &msg)
+{
+    QByteArray record;
+    QDataStream stream(&record, QIODevice::WriteOnly);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    stream << msg.getApid().toUtf8();
+    stream << msg.getCtid().toUtf8();
+    stream << (qint8) msg.getType();
+    stream << (quint8) msg.getSubtype();
+    stream << (quint8) msg.getNumberOfArguments();
+    stream << (quint16) msg.sizeArguments();
+
+    QDltArgument argument;
+    for(int num=0;num<msg.sizeArguments();num++)
+    {
+        msg.getArgument(num, argument);
+        stream << (qint8) argument.getTypeInfo();
+        stream << (qint8) argument.getEndianness();
+        stream << (qint32) argument.getOffsetPayload();
+        stream << argument.getName().toUtf8();
+        stream << argument.getUnit().toUtf8();
+        stream << argument.getData();
+    }
+
+    return record;
+}
+
+bool QDltDecodedMsgCache::readRecord(const QByteArray &record, QDltMsg &msg)
+{
+    QDataStream stream(record);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    QByteArray apid, ctid;
+    qint8 type;
+    quint8 subtype, numberOfArguments;
+    quint16 size;
+
+    stream >> apid >> ctid >> type >> subtype >> numberOfArguments >> size;
+    if(stream.status() != QDataStream::Ok)
+        return false;
+
+    msg.setApid(QString::fromUtf8(apid));
+    msg.setCtid(QString::fromUtf8(ctid));
+    msg.setType((QDltMsg::DltTypeDef) type);
+    msg.setSubtype(subtype);
+    msg.setNumberOfArguments(numberOfArguments);
+    msg.clearArguments();
+
+    for(int num=0;num<size;num++)
+    {
+        QDltArgument argument;
+        qint8 typeInfo, endianness;
+        qint32 offsetPayload;
+        QByteArray name, unit, data;
+
+        stream >> typeInfo >> endianness >> offsetPayload >> name >> unit >> data;
+        if(stream.status() != QDataStream::Ok)
+            return false;
+
+        argument.setTypeInfo((QDltArgument::DltTypeInfoDef) typeInfo);
+        argument.setEndianness((QDltMsg::DltEndiannessDef) endianness);
+        argument.setOffsetPayload(offsetPayload);
+        argument.setName(QString::fromUtf8(name));
+        argument.setUnit(QString::fromUtf8(unit));
+        argument.setData(data);
+        msg.addArgument(argument);
+    }
+
+    return true;
+}
@@ -0,0 +1,154 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltdecodedmsgcache.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_DECODED_MSG_CACHE_H
+#define QDLT_DECODED_MSG_CACHE_H
+
+#include <QFile>
+#include <QString>
+#include <QByteArray>
+#include <QVector>
+#include <QMutex>
+#include <QAtomicInt>
+
+#include "export_rules.h"
+
+class QDltMsg;
+
+//! Version of the decoded message cache file format.
+#define QDLT_DECODED_MSG_CACHE_VERSION 1
+
+//! Cache of the results of the decoder plugins.
+/*!
+  The decoded header fields and arguments of each message handled by a decoder
+  plugin are stored in a file, while the messages are decoded once during indexing.
+  Afterwards the table, search and export read the decoded messages from the cache
+  instead of running the decoder plugins again.
+  The file name of the cache must identify the log files and the decoder plugin
+  configuration, so a cache file can be reused when the log file is opened again.
+
+  The cache is only valid for the decoder plugin configuration it was created or
+  loaded with. After a plugin changed its mode, configuration or interest, lookups
+  miss and recording is abandoned, see QDltPlugin::getConfigGeneration().
+
+  File format: header with magic, version and number of messages, the records of
+  the decoded messages, the table with the offset of the record of each message
+  (-1 if no plugin decoded the message) and a footer with the offset of the table.
+*/
+class QDLT_EXPORT QDltDecodedMsgCache
+{
+public:
+    //! Result of a cache lookup
+    typedef enum { CacheMiss, CacheNotDecoded, CacheDecoded } LookupResult;
+
+    //! Constructor.
+    QDltDecodedMsgCache();
+
+    //! Destructor.
+    ~QDltDecodedMsgCache();
+
+    //! Create a new cache file and start recording decoded messages.
+    /*!
+      \param filename The name of the cache file.
+      \param size The number of messages of the log file.
+      \param temporary The file is removed, when the cache is cleared.
+      \return true if the operation was successful, false if an error occurred.
+    */
+    bool create(const QString &filename, int size, bool temporary = false);
+
+    //! Store a decoded message while recording, this function is thread safe.
+    /*!
+      \param index The index of the message in the log file.
+      \param msg The decoded message.
+    */
+    void store(int index, const QDltMsg &msg);
+
+    //! Finish recording and make the cache available for lookups.
+    /*!
+      \return true if the operation was successful, false if an error occurred.
+    */
+    bool finish();
+
+    //! Load an existing cache file.
+    /*!
+      \param filename The name of the cache file.
+      \param size The number of messages of the log file, the cache is rejected if it does not match.
+      \return true if the operation was successful, false if an error occurred.
+    */
+    bool load(const QString &filename, int size);
+
+    //! Close the cache, the cache file is removed if it is not complete or temporary.
+    void clear();
+
+    //! Check if the cache is available for lookups.
+    /*!
+      \return true if the cache is complete and no decoder plugin changed since it was created or loaded.
+    */
+    bool isComplete() const;
+
+    //! Check if the cache is complete, but a decoder plugin changed since it was created or loaded.
+    bool isOutdated() const;
+
+    //! Check if decoded messages are recorded.
+    bool isRecording() const { return state.load() == StateRecording; }
+
+    //! Get the name of the cache file.
+    QString getFileName() const { return file.fileName(); }
+
+    //! Get the number of messages covered by the cache.
+    int size() const { return offsets.size(); }
+
+    //! Apply the cached decoding results to a message.
+    /*!
+      The message must be the undecoded message read from the log file.
+      \param index The index of the message in the log file.
+      \param msg The message to be updated.
+      \return CacheMiss if the message is not covered by the cache and must be decoded,
+      CacheNotDecoded if no decoder plugin handles the message, CacheDecoded if the message was updated.
+    */
+    LookupResult lookup(int index, QDltMsg &msg) const;
+
+private:
+    typedef enum { StateNone, StateRecording, StateComplete } StateDef;
+
+    //! Serialise the decoded data of a message.
+    static QByteArray writeRecord(const QDltMsg &msg);
+
+    //! Update a message with the decoded data of a record.
+    static bool readRecord(const QByteArray &record, QDltMsg &msg);
+
+    mutable QFile file;
+    bool temporary;
+    QAtomicInt state;
+
+    //! Plugin configuration generation the cache was created or loaded with.
+    int generation;
+
+    //! Offset of the record of each message, -1 if not decoded.
+    QVector<qint64> offsets;
+    qint64 writePos;
+    mutable QMutex mutex;
+
+    //! The mapped cache file, zero if the file could not be mapped.
+    uchar *map;
+};
+
+#endif // QDLT_DECODED_MSG_CACHE_H
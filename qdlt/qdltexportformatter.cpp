@@ -0,0 +1,130 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltexportformatter.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include "qdlt.h"
+
+QDltExportFormatter::QDltExportFormatter(Format format)
+    : format(format)
+{
+}
+
+QString QDltExportFormatter::csvHeader()
+{
+    return QString("\"Index\",\"Time\",\"Timestamp\",\"Count\",\"Ecuid\",\"Apid\",\"Ctid\",\"SessionId\",\"Type\",\"Subtype\",\"Mode\",\"#Args\",\"Payload\"\n");
+}
+
+void QDltExportFormatter::appendLatin1(QByteArray &output, const QString &text)
+{
+    const QChar *src = text.constData();
+    const int size = text.size();
+    const int start = output.size();
+
+    output.resize(start + size);
+    char *dst = output.data() + start;
+    int num;
+    for(num = 0; num < size; num++)
+    {
+        ushort ch = src[num].unicode();
+        if(ch == 0)
+            break;
+        dst[num] = ch > 0xff ? '?' : (char) ch;
+    }
+    output.resize(start + num);
+}
+
+void QDltExportFormatter::csvLine(int index, QDltMsg &msg, QString &text)
+{
+    text += QLatin1Char('"');
+    QDltTextWriter::appendInt(text,index);
+    text += QLatin1String("\",\"");
+    text += msg.getTimeString();
+    text += QLatin1Char('.');
+    QDltTextWriter::appendUInt(text,msg.getMicroseconds(),6);
+    text += QLatin1String("\",\"");
+    QDltTextWriter::appendUInt(text,msg.getTimestamp()/10000);
+    text += QLatin1Char('.');
+    QDltTextWriter::appendUInt(text,msg.getTimestamp()%10000,4);
+    text += QLatin1String("\",\"");
+    QDltTextWriter::appendUInt(text,msg.getMessageCounter());
+    text += QLatin1String("\",");
+    QDltTextWriter::appendCSVValue(text,msg.getEcuid());
+    text += QLatin1Char(',');
+    QDltTextWriter::appendCSVValue(text,msg.getApid());
+    text += QLatin1Char(',');
+    QDltTextWriter::appendCSVValue(text,msg.getCtid());
+    text += QLatin1String(",\"");
+    QDltTextWriter::appendUInt(text,msg.getSessionid());
+    text += QLatin1String("\",");
+    QDltTextWriter::appendCSVValue(text,msg.getTypeString());
+    text += QLatin1Char(',');
+    QDltTextWriter::appendCSVValue(text,msg.getSubtypeString());
+    text += QLatin1Char(',');
+    QDltTextWriter::appendCSVValue(text,msg.getModeString());
+    text += QLatin1String(",\"");
+    QDltTextWriter::appendUInt(text,msg.getNumberOfArguments());
+    text += QLatin1String("\",");
+    payload.resize(0);
+    msg.toStringPayload(payload);
+    QDltTextWriter::appendCSVValue(text,payload,true);
+    text += QLatin1Char('\n');
+}
+
+void QDltExportFormatter::textLine(int index, QDltMsg &msg, QString &text)
+{
+    QDltTextWriter::appendInt(text,index);
+    text += QLatin1Char(' ');
+    msg.toStringHeader(text);
+    text += QLatin1Char(' ');
+    payload.resize(0);
+    msg.toStringPayload(payload);
+    QDltTextWriter::appendSimplified(text,payload);
+    text += QLatin1Char('\n');
+}
+
+void QDltExportFormatter::formatMsg(int index, QDltMsg &msg, QByteArray &buf, QByteArray &output)
+{
+    /* the buffer is reused for all messages, resize() keeps the allocated memory */
+    text.resize(0);
+
+    switch(format)
+    {
+    case FormatDlt:
+        output.append(buf);
+        break;
+    case FormatDltDecoded:
+        msg.setNumberOfArguments(msg.sizeArguments());
+        msg.getMsg(buf,true);
+        output.append(buf);
+        break;
+    case FormatAscii:
+        textLine(index,msg,text);
+        appendLatin1(output,text);
+        break;
+    case FormatUTF8:
+        textLine(index,msg,text);
+        output.append(text.toUtf8().constData());
+        break;
+    case FormatCsv:
+        csvLine(index,msg,text);
+        appendLatin1(output,text);
+        break;
+    }
+}
@@ -0,0 +1,93 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltexportformatter.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_EXPORT_FORMATTER_H
+#define QDLT_EXPORT_FORMATTER_H
+
+#include <QString>
+#include <QByteArray>
+
+#include "export_rules.h"
+
+class QDltMsg;
+
+//! Format messages for the export to DLT, ASCII, UTF8 and CSV files.
+/*!
+  The viewer export and the command line converter use this class, so both
+  create the same output. An instance keeps buffers which are reused for
+  each message, so one instance should be used per thread.
+*/
+class QDLT_EXPORT QDltExportFormatter
+{
+public:
+    //! The export format.
+    typedef enum { FormatDlt, FormatAscii, FormatCsv, FormatDltDecoded, FormatUTF8 } Format;
+
+    //! Constructor.
+    QDltExportFormatter(Format format = FormatAscii);
+
+    //! Get the export format.
+    Format getFormat() const { return format; }
+
+    //! Check if the format is written as text file.
+    bool isText() const { return format == FormatAscii || format == FormatUTF8 || format == FormatCsv; }
+
+    //! Get the first line of a CSV file with the names of the fields.
+    static QString csvHeader();
+
+    //! Append the text line of a message used by the ASCII, UTF8 and clipboard export.
+    /*!
+      \param index Index of the message in the DLT file.
+      \param msg The decoded message.
+      \param text Buffer to append the line including the line feed to.
+    */
+    void textLine(int index, QDltMsg &msg, QString &text);
+
+    //! Append the CSV line of a message.
+    /*!
+      \param index Index of the message in the DLT file.
+      \param msg The decoded message.
+      \param text Buffer to append the line including the line feed to.
+    */
+    void csvLine(int index, QDltMsg &msg, QString &text);
+
+    //! Append a message in the export format.
+    /*!
+      For FormatDltDecoded the message is serialised again into buf.
+      \param index Index of the message in the DLT file.
+      \param msg The decoded message.
+      \param buf The binary message.
+      \param output Buffer to append the formatted message to.
+    */
+    void formatMsg(int index, QDltMsg &msg, QByteArray &buf, QByteArray &output);
+
+    //! Append the Latin-1 bytes of a text up to the first null character.
+    static void appendLatin1(QByteArray &output, const QString &text);
+
+private:
+    Format format;
+
+    //! Buffers reused for all messages.
+    QString text;
+    QString payload;
+};
+
+#endif // QDLT_EXPORT_FORMATTER_H
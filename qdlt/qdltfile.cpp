@@ -22,6 +22,13 @@
 #include <QFile>
 #include <QtDebug>
 
+#if defined(Q_OS_UNIX)
+#include <unistd.h>
+#endif
+#if defined(Q_OS_LINUX)
+#include <sys/syscall.h>
+#endif
+
 #include "qdlt.h"
 
 extern "C"
@@ -44,6 +51,9 @@ void QDltFile::clear()
 {
     for(int num=0;num<files.size();num++)
     {
+        if(files[num]->compressedFile) {
+             files[num]->compressedFile->close();
+        }
         if(files[num]->infile.isOpen()) {
              files[num]->infile.close();
         }
@@ -65,6 +75,16 @@ void QDltFile::setDltIndex(QVector<qint64> &_indexAll, int num)
     files[num]->indexAll = _indexAll;
 }
 
+void QDltFile::appendDltIndex(const QVector<qint64> &positions, int num)
+{
+    if(num<0 || num>=files.size())
+        return;
+
+    mutexQDlt.lock();
+    files[num]->indexAll += positions;
+    mutexQDlt.unlock();
+}
+
 int QDltFile::size() const
 {
     int size=0;
@@ -119,6 +139,17 @@ bool QDltFile::open(QString _filename, bool append) {
         return false;
     }
 
+    /* read compressed log files through a decompressor */
+    if(QDltCompressedFile::detectFormat(&item->infile) != QDltCompressedFile::FormatNone)
+    {
+        item->compressedFile = new QDltCompressedFile(&item->infile);
+        if(item->compressedFile->open(QIODevice::ReadOnly)==false) {
+            /* open decompressor failed */
+            qWarning() << "open of compressed file" << _filename << "failed";
+            return false;
+        }
+    }
+
     //qDebug() << "Open file" << _filename << "finished";
 
     return true;
@@ -160,14 +191,29 @@ bool QDltFile::updateIndex()
 
     for(int numFile=0;numFile<files.size();numFile++)
     {
+        QIODevice *device = files[numFile]->device();
+
         /* check if file is already opened */
-        if(false == files[numFile]->infile.isOpen())
+        if(false == device->isOpen())
         {
             qDebug() << "updateMsg: Infile is not open" << files[numFile]->infile.fileName() << __FILE__ << "line" << __LINE__;
             mutexQDlt.unlock();
             return false;
         }
 
+        /* a file recorded compressed was still empty when it was opened */
+        if(!files[numFile]->compressedFile && files[numFile]->indexAll.isEmpty() && files[numFile]->infile.size() > 0 &&
+           QDltCompressedFile::detectFormat(&files[numFile]->infile) != QDltCompressedFile::FormatNone)
+        {
+            files[numFile]->compressedFile = new QDltCompressedFile(&files[numFile]->infile);
+            if(files[numFile]->compressedFile->open(QIODevice::ReadOnly)==false)
+            {
+                qWarning() << "updateIndex: open of compressed file" << files[numFile]->infile.fileName() << "failed";
+                delete files[numFile]->compressedFile;
+                files[numFile]->compressedFile = 0;
+            }
+            device = files[numFile]->device();
+        }
 
         /* start at last found position */
         if(files[numFile]->indexAll.size())
@@ -175,11 +221,11 @@ bool QDltFile::updateIndex()
             /* move behind last found position */
             const QVector<qint64>* const_indexAll = &(files[numFile]->indexAll);
             pos = (*const_indexAll)[files[numFile]->indexAll.size()-1] + 4;
-            files[numFile]->infile.seek(pos);
+            device->seek(pos);
         }
         else {
             /* the file was empty the last call */
-            files[numFile]->infile.seek(0);
+            device->seek(0);
         }
 
         /* Align kbytes, 1MB read at a time */
@@ -192,7 +238,7 @@ bool QDltFile::updateIndex()
         while(true) {
 
             /* read buffer from file */
-            buf = files[numFile]->infile.read(READ_BUF_SZ);
+            buf = device->read(READ_BUF_SZ);
             if(buf.isEmpty())
                 break; // EOF
 
@@ -323,6 +369,32 @@ QString QDltFile::getFileName(int num)
     return files[num]->infile.fileName();
 }
 
+bool QDltFile::isCompressed(int num) const
+{
+    if(num<0 || num>=files.size())
+        return false;
+
+    return files[num]->compressedFile != 0;
+}
+
+bool QDltFile::isRandomAccess(int num) const
+{
+    if(num<0 || num>=files.size())
+        return false;
+
+    return !files[num]->compressedFile || files[num]->compressedFile->isRandomAccess();
+}
+
+void QDltFile::setSeekIndex(int num, const QDltSeekIndex &seekIndex)
+{
+    if(num<0 || num>=files.size() || !files[num]->compressedFile)
+        return;
+
+    mutexQDlt.lock();
+    files[num]->compressedFile->setSeekIndex(seekIndex);
+    mutexQDlt.unlock();
+}
+
 void QDltFile::close()
 {
     /* close file */
@@ -344,6 +416,9 @@ QByteArray QDltFile::getMsg(int index) const
         return QByteArray();
     }
 
+    /* the index can be extended by another thread while receiving */
+    QMutexLocker locker(&mutexQDlt);
+
     for(num=0;num<files.size();num++)
     {
         if(index<files[num]->indexAll.size())
@@ -360,7 +435,7 @@ QByteArray QDltFile::getMsg(int index) const
     }
 
     /* check if file is already opened */
-    if(false == files[num]->infile.isOpen())
+    if(false == files[num]->device()->isOpen())
     {
         /* return empty buffer */
         qDebug() << "getMsg: Infile is not open" << files[num]->infile.fileName() << __FILE__ << "line" << __LINE__;
@@ -369,29 +444,159 @@ QByteArray QDltFile::getMsg(int index) const
         return QByteArray();
     }
 
-    mutexQDlt.lock();
-
     QDltFileItem* file = files[num];
     const QDltFileItem* const_file = file;
+    QIODevice *device = file->device();
     qint64 positionForIndex = const_file->indexAll[index];
 
     /* move to file position selected by index */
-    file->infile.seek(positionForIndex);
+    device->seek(positionForIndex);
 
     /* read DLT message from file */
     if(index == (file->indexAll.size()-1))
         /* last message in file */
-        buf = file->infile.read(file->infile.size() - positionForIndex);
+        buf = device->read(device->size() - positionForIndex);
     else
         /* any other file position */
-        buf = file->infile.read(const_file->indexAll[index+1] - positionForIndex);
-
-    mutexQDlt.unlock();
+        buf = device->read(const_file->indexAll[index+1] - positionForIndex);
 
     /* return DLT message buffer */
     return buf;
 }
 
+bool QDltFile::getMsgRange(int index, int &num, qint64 &pos, qint64 &length) const
+{
+    if(index<0)
+        return false;
+
+    /* the index can be extended by another thread while receiving */
+    QMutexLocker locker(&mutexQDlt);
+
+    for(num=0;num<files.size();num++)
+    {
+        if(index<files[num]->indexAll.size())
+            break;
+        else
+            index -= files[num]->indexAll.size();
+    }
+
+    if(num>=files.size())
+        return false;
+
+    const QDltFileItem *file = files[num];
+    pos = file->indexAll[index];
+
+    if(index == (file->indexAll.size()-1))
+        /* last message in file */
+        length = files[num]->device()->size() - pos;
+    else
+        length = file->indexAll[index+1] - pos;
+
+    return length >= 0;
+}
+
+/* Copy a range of a device by reading and writing large blocks */
+static bool copyDeviceRange(QIODevice *device, qint64 pos, qint64 length, QFile &to)
+{
+    if(!device->seek(pos))
+        return false;
+
+    QByteArray buf;
+    while(length > 0)
+    {
+        buf = device->read(qMin(length, (qint64) QDLT_FILE_COPY_BLOCK_SIZE));
+        if(buf.isEmpty() || to.write(buf) != buf.size())
+            return false;
+        length -= buf.size();
+    }
+
+    return true;
+}
+
+#if defined(Q_OS_UNIX)
+/* Copy a range of a file with positional reads, the file position is not used */
+static bool preadFileRange(int fd, qint64 pos, qint64 length, QFile &to)
+{
+    QByteArray buf(qMin(length, (qint64) QDLT_FILE_COPY_BLOCK_SIZE), 0);
+    while(length > 0)
+    {
+        ssize_t size = pread(fd, buf.data(), (size_t) qMin(length, (qint64) buf.size()), (off_t) pos);
+        if(size <= 0 || to.write(buf.constData(), size) != size)
+            return false;
+        pos += size;
+        length -= size;
+    }
+
+    return true;
+}
+#endif
+
+bool QDltFile::copyRange(int num, qint64 pos, qint64 length, QFile &to) const
+{
+    if(num<0 || num>=files.size() || pos<0 || length<0)
+        return false;
+
+    QDltFileItem *file = files[num];
+
+    if(false == file->device()->isOpen())
+        return false;
+
+    if(file->compressedFile)
+    {
+        /* the decompressor keeps the state of the stream, so the access is serialized */
+        QMutexLocker locker(&mutexQDlt);
+        return copyDeviceRange(file->compressedFile, pos, length, to);
+    }
+
+#if defined(Q_OS_UNIX)
+    /* copyFileRange() only uses positional I/O here, so ranges can be copied in parallel */
+    return copyFileRange(file->infile, pos, length, to);
+#else
+    QMutexLocker locker(&mutexQDlt);
+    return copyFileRange(file->infile, pos, length, to);
+#endif
+}
+
+bool QDltFile::copyFileRange(QFile &from, qint64 pos, qint64 length, QFile &to)
+{
+    if(pos<0 || length<0)
+        return false;
+
+#if defined(Q_OS_LINUX) && defined(SYS_copy_file_range)
+    /* let the kernel copy the data without passing it through user space */
+    if(to.flush())
+    {
+        loff_t inPos = pos;
+        loff_t outPos = to.pos();
+
+        while(length > 0)
+        {
+            ssize_t copied = syscall(SYS_copy_file_range, from.handle(), &inPos, to.handle(), &outPos, (size_t) qMin(length, (qint64) 0x40000000), 0u);
+            if(copied <= 0)
+                break;
+            length -= copied;
+        }
+
+        /* copy_file_range does not move the file positions */
+        if(!to.seek(outPos))
+            return false;
+        pos = inPos;
+
+        /* e.g. copies between different file systems are not supported by older kernels */
+        if(length == 0)
+            return true;
+    }
+#endif
+
+#if defined(Q_OS_UNIX)
+    /* the file position of the source is not changed, it may be shared with other threads */
+    if(from.handle() >= 0)
+        return preadFileRange(from.handle(), pos, length, to);
+#endif
+
+    return copyDeviceRange(&from, pos, length, to);
+}
+
 bool QDltFile::getMsg(int index,QDltMsg &msg) const
 {
     QByteArray data = getMsg(index);
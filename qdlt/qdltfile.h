@@ -31,13 +31,26 @@
 #include <time.h>
 
 #include "export_rules.h"
+#include "qdltcompressedfile.h"
+
+//! Size of the blocks used to copy ranges of a log file, if the kernel cannot copy them.
+#define QDLT_FILE_COPY_BLOCK_SIZE (1024*1024)
 
 class QDLT_EXPORT QDltFileItem
 {
 public:
+    QDltFileItem() : compressedFile(0) {}
+    ~QDltFileItem() { delete compressedFile; }
+
+    //! Device providing the uncompressed DLT data of the log file.
+    QIODevice *device() { return compressedFile ? static_cast<QIODevice*>(compressedFile) : &infile; }
+
     //! DLT log file.
     QFile infile;
 
+    //! Decompressor for the DLT log file, 0 if the file is not compressed.
+    QDltCompressedFile *compressedFile;
+
     //! Index of all DLT messages.
     /*!
       Index contains positions of beginning of DLT messages in DLT log file.
@@ -106,6 +119,13 @@ public:
     */
     void setDltIndex(QVector<qint64> &_indexAll, int num = 0);
 
+    //! Append positions of new DLT messages to the internal index.
+    /*!
+      \param positions Positions of the new DLT messages, behind the last indexed message
+      \param num Number of the file
+    */
+    void appendDltIndex(const QVector<qint64> &positions, int num = 0);
+
     //! Clears the internal index of all DLT messages.
     /*!
     */
@@ -165,6 +185,41 @@ public:
     */
     int getMsgFilterPos(int index) const;
 
+    //! Get the location of a DLT message in the log files
+    /*!
+      \param index position of the DLT message in the log file up to the number of DLT messages in the file
+      \param num number of the log file containing the message
+      \param pos offset of the message in the uncompressed data of the log file
+      \param length length of the message in bytes
+      \return true if the index is valid, false otherwise
+    */
+    bool getMsgRange(int index, int &num, qint64 &pos, qint64 &length) const;
+
+    //! Copy a byte range of a log file to another file
+    /*!
+      Uncompressed log files are copied with copyFileRange() without locking on Unix,
+      so several ranges can be copied by different threads at the same time.
+      \param num number of the log file
+      \param pos offset of the range in the uncompressed data of the log file
+      \param length length of the range in bytes
+      \param to opened destination file, the data is written at the current position
+      \return true if the range was copied completely, false otherwise
+    */
+    bool copyRange(int num, qint64 pos, qint64 length, QFile &to) const;
+
+    //! Copy a byte range of a file to another file
+    /*!
+      The data is copied by the kernel with copy_file_range on Linux,
+      otherwise it is read and written in large blocks.
+      On Unix the source is read with positional I/O, its file position is not changed.
+      \param from opened source file
+      \param pos offset of the range in the source file
+      \param length length of the range in bytes
+      \param to opened destination file, the data is written at the current position
+      \return true if the range was copied completely, false otherwise
+    */
+    static bool copyFileRange(QFile &from, qint64 pos, qint64 length, QFile &to);
+
     //! Delete all filters and markers.
     /*!
       This includes all positive and negative filters and markers.
@@ -250,6 +305,28 @@ public:
      **/
     QString getFileName(int num = 0);
 
+    //! Check if the underlying file is compressed
+    /*!
+     * \param num Number of the file
+     * \return true if the file is read through a decompressor
+     **/
+    bool isCompressed(int num = 0) const;
+
+    //! Check if the underlying file can be read at any position without decompressing it from its start
+    /*!
+     * \param num Number of the file
+     * \return false if the file is a zstd file with a single frame or without seek table
+     **/
+    bool isRandomAccess(int num = 0) const;
+
+    //! Set the seek index of a compressed file
+    /*!
+     * The seek index is created by reading the file once or loaded from the index cache.
+     * \param num Number of the file
+     * \param seekIndex The seek index of the compressed file
+     **/
+    void setSeekIndex(int num, const QDltSeekIndex &seekIndex);
+
     //! Get Index of all DLT messages matching filter
     /*!
      * \return List of file positions
@@ -122,7 +122,11 @@ bool QDltFilterList::checkFilter(QDltMsg &msg)
     for(int numfilter=0;numfilter<pfilters.size();numfilter++)
     {
         filter = pfilters[numfilter];
-        found = filter->match(msg);
+        {
+            QDltMetricTimer timer(ptimes[numfilter]);
+            found = filter->match(msg);
+            timer.setHit(found);
+        }
         if (found)
           break;
     }
@@ -136,7 +140,13 @@ bool QDltFilterList::checkFilter(QDltMsg &msg)
         for(int numfilter=0;numfilter<nfilters.size();numfilter++)
         {
             filter = nfilters[numfilter];
-            if (filter->match(msg))
+            bool matched;
+            {
+                QDltMetricTimer timer(ntimes[numfilter]);
+                matched = filter->match(msg);
+                timer.setHit(matched);
+            }
+            if (matched)
             {
                 // a negative filter has matched -> found = false
                 found = false;
@@ -273,6 +283,8 @@ void QDltFilterList::updateSortedFilter()
     mfilters.clear();
     pfilters.clear();
     nfilters.clear();
+    ptimes.clear();
+    ntimes.clear();
 
     QDltFilter *filter;
 
@@ -290,13 +302,23 @@ void QDltFilterList::updateSortedFilter()
         {
             /* add to positive list */
             pfilters.append(filter);
+            ptimes.append(filterTime(filter, numfilter));
         }
 
         if(filter->isNegative() && filter->enableFilter)
         {
             /* add to negative list */
             nfilters.append(filter);
+            ntimes.append(filterTime(filter, numfilter));
         }
     }
 
 }
+
+QDltMetricHistogram *QDltFilterList::filterTime(const QDltFilter *filter, int num)
+{
+    /* filters without name are identified by their position in the list */
+    QString name = filter->name.isEmpty() ? QString::number(num) : filter->name;
+
+    return QDltMetrics::instance()->histogram(QString("filter.%1").arg(name));
+}
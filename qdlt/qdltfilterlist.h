@@ -33,6 +33,7 @@
 #include <QXmlStreamWriter>
 
 #include "export_rules.h"
+#include "qdltmetrics.h"
 
 
 class QDLT_EXPORT QDltFilterList
@@ -130,6 +131,13 @@ private:
     //! List of nfilters.
     QList<QDltFilter*> nfilters;
 
+    //! Histograms of the match time of each pfilter and nfilter.
+    QList<QDltMetricHistogram*> ptimes;
+    QList<QDltMetricHistogram*> ntimes;
+
+    //! Get the histogram of the match time of a filter.
+    static QDltMetricHistogram *filterTime(const QDltFilter *filter, int num);
+
 };
 
 #endif // QDLT_FILTER_LIST_H
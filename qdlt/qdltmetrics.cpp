@@ -0,0 +1,215 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltmetrics.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QFile>
+#include <QDateTime>
+#include <QJsonDocument>
+#include <QMutexLocker>
+
+#include "qdltmetrics.h"
+
+QAtomicInt QDltMetrics::timingUsers(0);
+
+QDltMetricHistogram::QDltMetricHistogram() : total(0), hitCount(0), nsecsSum(0), nsecsMax(0)
+{
+    for(int num = 0; num < QDLT_METRICS_HISTOGRAM_BUCKETS; num++)
+        buckets[num].store(0);
+}
+
+void QDltMetricHistogram::record(qint64 nsecs, bool hit)
+{
+    /* bucket n counts durations below 2^n microseconds */
+    quint64 usecs = nsecs / 1000;
+    int bucket = 0;
+    while(usecs && bucket < QDLT_METRICS_HISTOGRAM_BUCKETS - 1)
+    {
+        usecs >>= 1;
+        bucket++;
+    }
+
+    buckets[bucket].fetchAndAddRelaxed(1);
+    total.fetchAndAddRelaxed(1);
+    if(hit)
+        hitCount.fetchAndAddRelaxed(1);
+    nsecsSum.fetchAndAddRelaxed(nsecs);
+
+    qint64 current = nsecsMax.load();
+    while(nsecs > current && !nsecsMax.testAndSetRelaxed(current, nsecs))
+        current = nsecsMax.load();
+}
+
+qint64 QDltMetricHistogram::percentile(double percent) const
+{
+    qint64 count = total.load();
+    if(count == 0)
+        return 0;
+
+    qint64 rank = (qint64)(count * percent / 100.0);
+    qint64 seen = 0;
+    for(int num = 0; num < QDLT_METRICS_HISTOGRAM_BUCKETS; num++)
+    {
+        seen += buckets[num].load();
+        if(seen > rank)
+            return qMin(((qint64) 1 << num) * 1000, nsecsMax.load());
+    }
+
+    return nsecsMax.load();
+}
+
+QDltMetrics::QDltMetrics()
+{
+    sampleTimer.start();
+}
+
+QDltMetrics::~QDltMetrics()
+{
+    qDeleteAll(counters);
+    qDeleteAll(gauges);
+    qDeleteAll(histograms);
+}
+
+QDltMetrics *QDltMetrics::instance()
+{
+    static QDltMetrics metrics;
+    return &metrics;
+}
+
+QDltMetricCounter *QDltMetrics::counter(const QString &name)
+{
+    QMutexLocker locker(&mutex);
+
+    QDltMetricCounter *&metric = counters[name];
+    if(!metric)
+        metric = new QDltMetricCounter();
+    return metric;
+}
+
+QDltMetricGauge *QDltMetrics::gauge(const QString &name)
+{
+    QMutexLocker locker(&mutex);
+
+    QDltMetricGauge *&metric = gauges[name];
+    if(!metric)
+        metric = new QDltMetricGauge();
+    return metric;
+}
+
+QDltMetricHistogram *QDltMetrics::histogram(const QString &name)
+{
+    QMutexLocker locker(&mutex);
+
+    QDltMetricHistogram *&metric = histograms[name];
+    if(!metric)
+        metric = new QDltMetricHistogram();
+    return metric;
+}
+
+void QDltMetrics::sample()
+{
+    QMutexLocker locker(&mutex);
+
+    double secs = sampleTimer.restart() / 1000.0;
+    if(secs <= 0)
+        return;
+
+    QMap<QString, QDltMetricCounter*>::const_iterator it;
+    for(it = counters.constBegin(); it != counters.constEnd(); ++it)
+    {
+        qint64 value = it.value()->value();
+        sampleRates[it.key()] = (value - sampleValues.value(it.key(), 0)) / secs;
+        sampleValues[it.key()] = value;
+    }
+}
+
+QJsonObject QDltMetrics::snapshot()
+{
+    QMutexLocker locker(&mutex);
+    QJsonObject root;
+
+    root["time"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    root["timing"] = isTimingEnabled();
+
+    QJsonObject counterObjects;
+    QJsonObject hitRates;
+    QMap<QString, QDltMetricCounter*>::const_iterator it;
+    for(it = counters.constBegin(); it != counters.constEnd(); ++it)
+    {
+        QJsonObject counter;
+        counter["value"] = it.value()->value();
+        counter["rate"] = sampleRates.value(it.key(), 0);
+        counterObjects[it.key()] = counter;
+
+        if(it.key().endsWith(".hit"))
+        {
+            QString base = it.key().left(it.key().size() - 4);
+            QDltMetricCounter *miss = counters.value(base + ".miss");
+            if(miss)
+            {
+                qint64 hits = it.value()->value();
+                qint64 all = hits + miss->value();
+                hitRates[base] = all ? (double) hits / all : 0.0;
+            }
+        }
+    }
+    root["counters"] = counterObjects;
+    root["hitRates"] = hitRates;
+
+    QJsonObject gaugeObjects;
+    QMap<QString, QDltMetricGauge*>::const_iterator itGauge;
+    for(itGauge = gauges.constBegin(); itGauge != gauges.constEnd(); ++itGauge)
+        gaugeObjects[itGauge.key()] = itGauge.value()->value();
+    root["gauges"] = gaugeObjects;
+
+    QJsonObject histogramObjects;
+    QMap<QString, QDltMetricHistogram*>::const_iterator itHistogram;
+    for(itHistogram = histograms.constBegin(); itHistogram != histograms.constEnd(); ++itHistogram)
+    {
+        const QDltMetricHistogram *metric = itHistogram.value();
+        QJsonObject histogram;
+        histogram["count"] = metric->count();
+        histogram["hits"] = metric->hits();
+        histogram["meanUs"] = metric->count() ? metric->sum() / 1000.0 / metric->count() : 0.0;
+        histogram["p50Us"] = metric->percentile(50) / 1000.0;
+        histogram["p99Us"] = metric->percentile(99) / 1000.0;
+        histogram["maxUs"] = metric->max() / 1000.0;
+        histogram["totalMs"] = metric->sum() / 1000000.0;
+        histogramObjects[itHistogram.key()] = histogram;
+    }
+    root["histograms"] = histogramObjects;
+
+    return root;
+}
+
+bool QDltMetrics::dumpJson(const QString &fileName)
+{
+    QByteArray json = QJsonDocument(snapshot()).toJson();
+
+    /* write to a temporary file first, so a reader never sees a partly written file */
+    QFile file(fileName + ".tmp");
+    if(!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+    if(file.write(json) != json.size())
+        return false;
+    file.close();
+
+    QFile::remove(fileName);
+    return QFile::rename(fileName + ".tmp", fileName);
+}
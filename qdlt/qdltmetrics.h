@@ -0,0 +1,218 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltmetrics.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_METRICS_H
+#define QDLT_METRICS_H
+
+#include <QString>
+#include <QMap>
+#include <QHash>
+#include <QMutex>
+#include <QAtomicInt>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+#include "export_rules.h"
+
+//! Number of buckets of a latency histogram, bucket n counts durations below 2^n microseconds.
+#define QDLT_METRICS_HISTOGRAM_BUCKETS 32
+
+//! A counter which is only increased, e.g. the number of received bytes.
+class QDLT_EXPORT QDltMetricCounter
+{
+public:
+    //! Constructor.
+    QDltMetricCounter() : count(0) {}
+
+    //! Increase the counter, this function is thread safe.
+    void add(qint64 n = 1) { count.fetchAndAddRelaxed(n); }
+
+    //! Get the current value.
+    qint64 value() const { return count.load(); }
+
+private:
+    QAtomicInteger<qint64> count;
+};
+
+//! A value which can go up and down, e.g. the depth of a queue.
+class QDLT_EXPORT QDltMetricGauge
+{
+public:
+    //! Constructor.
+    QDltMetricGauge() : current(0) {}
+
+    //! Set the value, this function is thread safe.
+    void set(qint64 value) { current.store(value); }
+
+    //! Get the current value.
+    qint64 value() const { return current.load(); }
+
+private:
+    QAtomicInteger<qint64> current;
+};
+
+//! Distribution of durations in buckets of powers of two microseconds.
+class QDLT_EXPORT QDltMetricHistogram
+{
+public:
+    //! Constructor.
+    QDltMetricHistogram();
+
+    //! Add a duration, this function is thread safe.
+    /*!
+      \param nsecs The duration in nanoseconds.
+      \param hit The measured call had a result, e.g. a plugin decoded or a filter matched the message.
+    */
+    void record(qint64 nsecs, bool hit = false);
+
+    //! Get the number of recorded durations.
+    qint64 count() const { return total.load(); }
+
+    //! Get the number of recorded durations of calls which had a result.
+    qint64 hits() const { return hitCount.load(); }
+
+    //! Get the sum of all recorded durations in nanoseconds.
+    qint64 sum() const { return nsecsSum.load(); }
+
+    //! Get the longest recorded duration in nanoseconds.
+    qint64 max() const { return nsecsMax.load(); }
+
+    //! Get the upper bound of the bucket containing a percentile in nanoseconds.
+    /*!
+      \param percent The percentile between 0 and 100.
+    */
+    qint64 percentile(double percent) const;
+
+private:
+    QAtomicInteger<qint64> buckets[QDLT_METRICS_HISTOGRAM_BUCKETS];
+    QAtomicInteger<qint64> total;
+    QAtomicInteger<qint64> hitCount;
+    QAtomicInteger<qint64> nsecsSum;
+    QAtomicInteger<qint64> nsecsMax;
+};
+
+//! Registry of the performance metrics of all processing stages.
+/*!
+  Metrics are created on first use and live until the end of the process,
+  so a stage can keep the pointer to its metric and update it without lookup.
+  Counters and gauges are always updated, they only cost an atomic operation.
+  Durations are only measured while timing is enabled, e.g. while the
+  diagnostics are shown or written to a file.
+  Names are dot separated, the first part names the stage, e.g. "receive.bytes".
+*/
+class QDLT_EXPORT QDltMetrics
+{
+public:
+    //! Get the registry of the process.
+    static QDltMetrics *instance();
+
+    //! Get a counter, it is created if it does not exist.
+    QDltMetricCounter *counter(const QString &name);
+
+    //! Get a gauge, it is created if it does not exist.
+    QDltMetricGauge *gauge(const QString &name);
+
+    //! Get a histogram of durations, it is created if it does not exist.
+    QDltMetricHistogram *histogram(const QString &name);
+
+    //! Check if durations are measured.
+    static bool isTimingEnabled() { return timingUsers.load() > 0; }
+
+    //! Request or release measuring of durations.
+    /*!
+      Durations are measured as long as at least one user requested it,
+      every request must be released once.
+    */
+    static void requestTiming(bool enable) { if(enable) timingUsers.ref(); else timingUsers.deref(); }
+
+    //! Calculate the rates per second of all counters since the last call.
+    /*!
+      Should be called periodically by one owner, e.g. once per second.
+    */
+    void sample();
+
+    //! Get all metrics as JSON.
+    /*!
+      Counters contain the value and the rate per second of the last sample,
+      counters named "<name>.hit" and "<name>.miss" are combined to a hit rate,
+      histograms contain the count, the hits, the mean, the 50th and 99th percentile
+      and the maximum in microseconds and the total in milliseconds.
+    */
+    QJsonObject snapshot();
+
+    //! Write all metrics as JSON to a file.
+    /*!
+      \param fileName The name of the file, the file is replaced.
+      \return true if the operation was successful, false if an error occurred.
+    */
+    bool dumpJson(const QString &fileName);
+
+private:
+    QDltMetrics();
+    ~QDltMetrics();
+
+    QMutex mutex;
+    QMap<QString, QDltMetricCounter*> counters;
+    QMap<QString, QDltMetricGauge*> gauges;
+    QMap<QString, QDltMetricHistogram*> histograms;
+
+    //! Counter values and rates of the last sample.
+    QHash<QString, qint64> sampleValues;
+    QHash<QString, double> sampleRates;
+    QElapsedTimer sampleTimer;
+
+    static QAtomicInt timingUsers;
+};
+
+//! Measure the duration of a scope into a histogram, if timing is enabled.
+class QDltMetricTimer
+{
+public:
+    //! Start measuring.
+    /*!
+      \param histogram The histogram, nothing is measured if it is zero.
+    */
+    explicit QDltMetricTimer(QDltMetricHistogram *histogram)
+    {
+        this->histogram = (histogram && QDltMetrics::isTimingEnabled()) ? histogram : 0;
+        hit = false;
+        if(this->histogram)
+            timer.start();
+    }
+
+    //! Mark the measured call as having a result.
+    void setHit(bool hit = true) { this->hit = hit; }
+
+    //! Record the duration.
+    ~QDltMetricTimer()
+    {
+        if(histogram)
+            histogram->record(timer.nsecsElapsed(), hit);
+    }
+
+private:
+    QDltMetricHistogram *histogram;
+    QElapsedTimer timer;
+    bool hit;
+};
+
+#endif // QDLT_METRICS_H
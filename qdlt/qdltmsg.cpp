@@ -40,33 +40,48 @@ QDltMsg::~QDltMsg()
 
 QString QDltMsg::getTypeString() const
 {
-    return QString((type>=0 && type<=7)?qDltMessageType[type]:"");
+    return QString(getTypeName());
 }
 
 QString QDltMsg::getSubtypeString() const
+{
+    return QString(getSubtypeName());
+}
+
+QString QDltMsg::getModeString() const
+{
+    return QString(getModeName());
+}
+
+const char *QDltMsg::getTypeName() const
+{
+    return (type>=0 && type<=7)?qDltMessageType[type]:"";
+}
+
+const char *QDltMsg::getSubtypeName() const
 {
     switch(type)
     {
     case DltTypeLog:
-        return QString((subtype>=0 && subtype<=7)?qDltLogInfo[subtype]:"");
+        return (subtype>=0 && subtype<=7)?qDltLogInfo[subtype]:"";
         break;
     case DltTypeAppTrace:
-        return QString((subtype>=0 && subtype<=7)?qDltTraceType[subtype]:"");
+        return (subtype>=0 && subtype<=7)?qDltTraceType[subtype]:"";
         break;
     case DltTypeNwTrace:
-        return QString((subtype>=0 && subtype<=7)?qDltNwTraceType[subtype]:"");
+        return (subtype>=0 && subtype<=7)?qDltNwTraceType[subtype]:"";
         break;
     case DltTypeControl:
-        return QString((subtype>=0 && subtype<=7)?qDltControlType[subtype]:"");
+        return (subtype>=0 && subtype<=7)?qDltControlType[subtype]:"";
         break;
     default:
-        return QString("");
+        return "";
     }
 }
 
-QString QDltMsg::getModeString() const
+const char *QDltMsg::getModeName() const
 {
-    return QString((mode>=0 && mode<=1)?qDltMode[mode]:"");
+    return (mode>=0 && mode<=1)?qDltMode[mode]:"";
 }
 
 QString QDltMsg::getEndiannessString() const
@@ -104,40 +119,14 @@ QString QDltMsg::getCtrlReturnTypeString() const
 }
 QString QDltMsg::getTimeString() const
 {
-    char strtime[256];
-    struct tm *time_tm;
-    time_tm = localtime(&time);
-    if(time_tm)
-        strftime(strtime, 256, "%Y/%m/%d %H:%M:%S", time_tm);
-    return QString(strtime);
+    return QDltTimeCache::localTimeString(time);
 }
 
 QString QDltMsg::getGmTimeWithOffsetString(qlonglong offset, bool dst)
 {
-    struct tm *time_tm;
-    time_tm = gmtime(&time);
-
-    /*Reason for adding:
-        tm_mon	months since January	0-11
-        tm_year	years since 1900
-    */
-    QDate date(time_tm->tm_year+1900,time_tm->tm_mon+1,time_tm->tm_mday);
-    QTime time(time_tm->tm_hour,time_tm->tm_min,time_tm->tm_sec);
-
-    if(!date.isValid() || !time.isValid())
-        return QString("Invalid date");
-
-    QDateTime gmDateTime(date,time,Qt::UTC);
-
-    gmDateTime = gmDateTime.addSecs(offset);
-
-    if(dst)
-       gmDateTime = gmDateTime.addSecs(3600);
-
-    return gmDateTime.toString("yyyy/MM/dd hh:mm:ss");
+    return QDltTimeCache::gmTimeWithOffsetString(time,offset,dst);
 }
 
-
 bool QDltMsg::setMsg(const QByteArray& buf, bool withStorageHeader)
 {
     unsigned int offset;
@@ -504,56 +493,88 @@ QString QDltMsg::toStringHeader() const
     QString text;
     text.reserve(1024);
 
-    text += QString("%1.%2").arg(getTimeString()).arg(getMicroseconds(),6,10,QLatin1Char('0'));
-    text += QString(" %1.%2").arg(getTimestamp()/10000).arg(getTimestamp()%10000,4,10,QLatin1Char('0'));
-    text += QString(" %1").arg(getMessageCounter());
-    text += QString(" %1").arg(getEcuid());
-    text += QString(" %1").arg(getApid());
-    text += QString(" %1").arg(getCtid());
-    text += QString(" %1").arg(getSessionid());
-    text += QString(" %2").arg(getTypeString());
-    text += QString(" %2").arg(getSubtypeString());
-    text += QString(" %2").arg(getModeString());
-    text += QString(" %1").arg(getNumberOfArguments());
+    toStringHeader(text);
 
     return text;
 }
 
+void QDltMsg::toStringHeader(QString &text) const
+{
+    text += getTimeString();
+    text += QLatin1Char('.');
+    QDltTextWriter::appendUInt(text,getMicroseconds(),6);
+    text += QLatin1Char(' ');
+    QDltTextWriter::appendUInt(text,getTimestamp()/10000);
+    text += QLatin1Char('.');
+    QDltTextWriter::appendUInt(text,getTimestamp()%10000,4);
+    text += QLatin1Char(' ');
+    QDltTextWriter::appendUInt(text,getMessageCounter());
+    text += QLatin1Char(' ');
+    text += ecuid;
+    text += QLatin1Char(' ');
+    text += apid;
+    text += QLatin1Char(' ');
+    text += ctid;
+    text += QLatin1Char(' ');
+    QDltTextWriter::appendUInt(text,getSessionid());
+    text += QLatin1Char(' ');
+    text += QLatin1String(getTypeName());
+    text += QLatin1Char(' ');
+    text += QLatin1String(getSubtypeName());
+    text += QLatin1Char(' ');
+    text += QLatin1String(getModeName());
+    text += QLatin1Char(' ');
+    QDltTextWriter::appendUInt(text,getNumberOfArguments());
+}
+
 QString QDltMsg::toStringPayload() const
 {
     QString text;
-    QDltArgument argument;
-    QByteArray data;
-
     text.reserve(1024);
 
+    toStringPayload(text);
+
+    return text;
+}
+
+void QDltMsg::toStringPayload(QString &text) const
+{
+    QByteArray data;
+
     if((getMode()==QDltMsg::DltModeNonVerbose) && (getType()!=QDltMsg::DltTypeControl) && (getNumberOfArguments() == 0)) {
-        text += QString("[%1] ").arg(getMessageId());
+        text += QLatin1Char('[');
+        QDltTextWriter::appendUInt(text,getMessageId());
+        text += QLatin1String("] ");
         data = payload.mid(4,(payload.size()>260)?256:(payload.size()-4));
         if(!data.isEmpty())
         {
             text += toAsciiTable(data,false,false,true,1024,1024,false);
-            text += "|";
-            text += toAscii(data, false);
+            text += QLatin1Char('|');
+            toAscii(text, data, false);
         }
-        return text;
+        return;
     }
 
     if( getType()==QDltMsg::DltTypeControl && getSubtype()==QDltMsg::DltControlResponse) {
 
         if(getCtrlServiceId() == DLT_SERVICE_ID_MARKER)
         {
-            return "MARKER";
+            text += QLatin1String("MARKER");
+            return;
         }
 
-        text += QString("[%1 %2] ").arg(getCtrlServiceIdString()).arg(getCtrlReturnTypeString());
+        text += QLatin1Char('[');
+        text += getCtrlServiceIdString();
+        text += QLatin1Char(' ');
+        text += getCtrlReturnTypeString();
+        text += QLatin1String("] ");
 
         // ServiceID of Get ECU Software Version
         if(getCtrlServiceId() == DLT_SERVICE_ID_GET_SOFTWARE_VERSION)
         {
             // Skip the ServiceID, Status and Lenght bytes and start from the String containing the ECU Software Version
             data = payload.mid(9,(payload.size()>262)?256:(payload.size()-9));
-            text += toAscii(data,true);
+            toAscii(text,data,true);
         }
         else if(getCtrlServiceId() == DLT_SERVICE_ID_CONNECTION_INFO)
         {
@@ -564,20 +585,21 @@ QString QDltMsg::toStringPayload() const
                 switch(service->state)
                 {
                 case DLT_CONNECTION_STATUS_DISCONNECTED:
-                    text += "disconnected";
+                    text += QLatin1String("disconnected");
                     break;
                 case DLT_CONNECTION_STATUS_CONNECTED:
-                    text += "connected";
+                    text += QLatin1String("connected");
                     break;
                 default:
-                    text += "unknown";
+                    text += QLatin1String("unknown");
                 }
-                text += " " + QString(QByteArray(service->comid,4));
+                text += QLatin1Char(' ');
+                text += QString(QByteArray(service->comid,4));
             }
             else
             {
                 data = payload.mid(5,(payload.size()>262)?256:(payload.size()-6));
-                text += toAscii(data);
+                toAscii(text,data);
             }
         }
         else if(getCtrlServiceId() == DLT_SERVICE_ID_TIMEZONE)
@@ -588,43 +610,42 @@ QString QDltMsg::toStringPayload() const
                 service = (DltServiceTimezone*) payload.constData();
 
                 if(endianness == DltEndiannessLittleEndian)
-                    text += QString("%1 s").arg(service->timezone);
+                    QDltTextWriter::appendInt(text,service->timezone);
                 else
-                    text += QString("%1 s").arg(DLT_SWAP_32(service->timezone));
-                text += QString(" %1").arg(service->isdst?"DST":"");
+                    QDltTextWriter::appendUInt(text,DLT_SWAP_32(service->timezone));
+                text += QLatin1String(" s ");
+                if(service->isdst)
+                    text += QLatin1String("DST");
             }
             else
             {
                 data = payload.mid(5,(payload.size()>262)?256:(payload.size()-6));
-                text += toAscii(data);
+                toAscii(text,data);
             }
         }
         else
         {
             data = payload.mid(5,(payload.size()>262)?256:(payload.size()-6));
-            text += toAscii(data);
+            toAscii(text,data);
         }
 
-        return text;
+        return;
     }
 
     if( getType()==QDltMsg::DltTypeControl) {
-        text += QString("[%1] ").arg(getCtrlServiceIdString());
+        text += QLatin1Char('[');
+        text += getCtrlServiceIdString();
+        text += QLatin1String("] ");
         data = payload.mid(4,(payload.size()>260)?256:(payload.size()-4));
-        text += toAscii(data);
+        toAscii(text,data);
 
-        return text;
+        return;
     }
 
     for(int num=0;num<arguments.size();num++) {
-        if(getArgument(num,argument)) {
-            if(num!=0) {
-                text += " ";
-            }
-            text += argument.toString();
+        if(num!=0) {
+            text += QLatin1Char(' ');
         }
-
+        arguments.at(num).toString(text);
     }
-
-    return text;
 }
@@ -432,10 +432,27 @@ public:
       \return The payload string.
     */
     QString toStringPayload() const;
+
+    //! Print Header and append it to a buffer.
+    /*!
+      \param text The buffer the header is appended to.
+    */
+    void toStringHeader(QString &text) const;
+
+    //! Print Payload content and append it to a buffer.
+    /*!
+      \param text The buffer the payload is appended to.
+    */
+    void toStringPayload(QString &text) const;
 protected:
 
 private:
 
+    //! Get the text of the type, subtype and mode without creating a string.
+    const char *getTypeName() const;
+    const char *getSubtypeName() const;
+    const char *getModeName() const;
+
     //! The header parameter ECU Id.
     QString ecuid;
 
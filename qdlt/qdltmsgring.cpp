@@ -0,0 +1,131 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltmsgring.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include "qdltmsgring.h"
+
+QDltMsgRing::QDltMsgRing()
+{
+    head = 0;
+    count = 0;
+    first = 0;
+    maxMessages = QDLT_MSG_RING_DEFAULT_SIZE;
+    maxAge = 0;
+}
+
+void QDltMsgRing::setMaxMessages(int maxMessages)
+{
+    if(maxMessages < 1)
+        maxMessages = 1;
+
+    this->maxMessages = maxMessages;
+
+    while(count > maxMessages)
+        removeFirst();
+
+    /* release storage not needed anymore */
+    if(msgs.size() > maxMessages)
+    {
+        linearize();
+        if(msgs.size() > maxMessages)
+            msgs.resize(maxMessages);
+        msgs.squeeze();
+    }
+}
+
+void QDltMsgRing::setMaxAge(int seconds)
+{
+    maxAge = seconds;
+
+    if(count > 0)
+        removeExpired(msgs[(head + count - 1) % msgs.size()].getTime());
+}
+
+void QDltMsgRing::append(const QDltMsg &msg)
+{
+    if(count == maxMessages)
+        removeFirst();
+
+    if(count == msgs.size())
+    {
+        /* grow the storage until the maximum number of messages is reached */
+        linearize();
+        msgs.append(msg);
+    }
+    else
+    {
+        msgs[(head + count) % msgs.size()] = msg;
+    }
+    count++;
+
+    removeExpired(msg.getTime());
+}
+
+void QDltMsgRing::clear()
+{
+    first += count;
+    head = 0;
+    count = 0;
+    msgs.clear();
+}
+
+const QDltMsg *QDltMsgRing::getMsg(qint64 sequence) const
+{
+    if(sequence < first || sequence >= first + count)
+        return 0;
+
+    return &msgs[(head + (int)(sequence - first)) % msgs.size()];
+}
+
+void QDltMsgRing::removeFirst()
+{
+    if(count == 0)
+        return;
+
+    /* release the data of the message */
+    msgs[head] = QDltMsg();
+    head = (head + 1) % msgs.size();
+    count--;
+    first++;
+}
+
+void QDltMsgRing::removeExpired(unsigned int time)
+{
+    if(maxAge <= 0)
+        return;
+
+    /* keep at least the newest message */
+    while(count > 1 && msgs[head].getTime() + (unsigned int)maxAge < time)
+        removeFirst();
+}
+
+void QDltMsgRing::linearize()
+{
+    if(head == 0)
+        return;
+
+    QVector<QDltMsg> ordered;
+    ordered.reserve(qMax(msgs.size(), qMin(maxMessages, msgs.size() * 2)));
+    for(int num = 0; num < count; num++)
+        ordered.append(msgs[(head + num) % msgs.size()]);
+
+    msgs.swap(ordered);
+    head = 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltmsgring.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_MSG_RING_H
+#define QDLT_MSG_RING_H
+
+#include <QVector>
+
+#include "export_rules.h"
+#include "qdltmsg.h"
+
+//! Default maximum number of messages kept in a message ring.
+#define QDLT_MSG_RING_DEFAULT_SIZE 100000
+
+//! Bounded in-memory ring of the last received messages.
+/*!
+  The ring keeps the last messages appended, limited by the number of messages
+  and optionally by the age of the messages. The age is measured with the
+  storage header time, relative to the newest message.
+  Each message gets a sequence number counting all messages ever appended,
+  so a view can track which messages were removed and added since the last update.
+  The storage of the ring grows up to the maximum number of messages and is reused afterwards.
+  This class is not thread safe.
+*/
+class QDLT_EXPORT QDltMsgRing
+{
+public:
+    //! Constructor.
+    QDltMsgRing();
+
+    //! Set the maximum number of messages, older messages are removed.
+    void setMaxMessages(int maxMessages);
+
+    //! Get the maximum number of messages.
+    int getMaxMessages() const { return maxMessages; }
+
+    //! Set the maximum age of the messages in seconds, 0 for no limit.
+    void setMaxAge(int seconds);
+
+    //! Get the maximum age of the messages in seconds.
+    int getMaxAge() const { return maxAge; }
+
+    //! Append a message, the oldest messages are removed if a limit is reached.
+    void append(const QDltMsg &msg);
+
+    //! Remove all messages, the sequence numbers continue.
+    void clear();
+
+    //! Get the number of messages in the ring.
+    int size() const { return count; }
+
+    //! Get the sequence number of the oldest message in the ring.
+    qint64 firstSequence() const { return first; }
+
+    //! Get the sequence number the next appended message will get.
+    qint64 endSequence() const { return first + count; }
+
+    //! Get a message by its sequence number.
+    /*!
+      \param sequence The sequence number of the message.
+      \return The message or zero if the message is not in the ring anymore.
+    */
+    const QDltMsg *getMsg(qint64 sequence) const;
+
+private:
+    //! Remove the oldest message.
+    void removeFirst();
+
+    //! Remove messages older than the maximum age relative to a time.
+    void removeExpired(unsigned int time);
+
+    //! Move the oldest message to the start of the storage.
+    void linearize();
+
+    QVector<QDltMsg> msgs;
+    int head;
+    int count;
+    qint64 first;
+
+    int maxMessages;
+    int maxAge;
+};
+
+#endif // QDLT_MSG_RING_H
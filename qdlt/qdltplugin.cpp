@@ -3,24 +3,51 @@
 #include <QDir>
 #include <QCoreApplication>
 #include <QPluginLoader>
+#include <QJsonArray>
+#include <QElapsedTimer>
+#include <QDebug>
 
 QDltPlugin::QDltPlugin()
 {
     plugininterface = 0;
     pluginviewerinterface = 0;
+    pluginviewerbatchinterface = 0;
+    pluginviewerworkerinterface = 0;
     plugindecoderinterface = 0;
     plugincontrolinterface = 0;
     plugincommandinterface = 0;
+    plugindecoderinterestinterface = 0;
+
+    decodeTime = 0;
+    initMsgTime = 0;
+    initMsgDecodedTime = 0;
+    updateMsgTime = 0;
+    updateMsgDecodedTime = 0;
+    initMsgsTime = 0;
+    initMsgsDecodedTime = 0;
+    updateMsgsTime = 0;
+    updateMsgsDecodedTime = 0;
+
+    loadTime = -1;
+    control = 0;
+    connectionsSet = false;
 
     mode = ModeDisable;
 }
 
+QAtomicInt QDltPlugin::configGeneration;
+
+int QDltPlugin::getConfigGeneration()
+{
+    return configGeneration.load();
+}
+
 QString QDltPlugin::getName()
 {
     if(plugininterface)
         return plugininterface->name();
     else
-        return QString();
+        return metaName;
 }
 
 QString QDltPlugin::getPluginVersion()
@@ -28,7 +55,7 @@ QString QDltPlugin::getPluginVersion()
     if(plugininterface)
         return plugininterface->pluginVersion();
     else
-        return QString();
+        return metaVersion;
 }
 
 QString QDltPlugin::getPluginInterfaceVersion()
@@ -36,7 +63,7 @@ QString QDltPlugin::getPluginInterfaceVersion()
     if(plugininterface)
         return plugininterface->pluginInterfaceVersion();
     else
-        return QString();
+        return metaInterfaceVersion;
 }
 
 int QDltPlugin::getMode()
@@ -48,15 +75,22 @@ int QDltPlugin::getMode()
 void QDltPlugin::setMode(QDltPlugin::Mode _mode)
 {
     //return QDltSettingsManager::getInstance()->value("plugin/pluginmodefor"+getName(),QVariant(QDltPlugin::ModeDisable)).toInt();
+
+    /* the plugin is loaded when it is enabled the first time */
+    if(_mode != ModeDisable && !load())
+        _mode = ModeDisable;
+
     mode = _mode;
+    configGeneration.ref();
 }
 
 void QDltPlugin::setFilename(QString _filename)
 {
     filename = _filename;
-    if(plugininterface)
+    if(load())
         plugininterface->loadConfig(_filename);
     setMode(ModeEnable);
+    configGeneration.ref();
 
 }
 
@@ -93,15 +127,117 @@ void QDltPlugin::loadPlugin(QObject *plugin)
     plugindecoderinterface = qobject_cast<QDLTPluginDecoderInterface *>(plugin);
     plugincontrolinterface = qobject_cast<QDltPluginControlInterface *>(plugin);
     plugincommandinterface = qobject_cast<QDltPluginCommandInterface *>(plugin);
+    plugindecoderinterestinterface = qobject_cast<QDltPluginDecoderInterestInterface *>(plugin);
+    pluginviewerbatchinterface = pluginviewerinterface ? qobject_cast<QDltPluginViewerBatchInterface *>(plugin) : 0;
+    pluginviewerworkerinterface = pluginviewerbatchinterface ? qobject_cast<QDltPluginViewerWorkerInterface *>(plugin) : 0;
+
+    /* plugins with the same name share their histograms */
+    QString name = getName();
+    if(plugindecoderinterface)
+        decodeTime = QDltMetrics::instance()->histogram(QString("decode.%1").arg(name));
+    if(pluginviewerinterface)
+    {
+        initMsgTime = QDltMetrics::instance()->histogram(QString("viewer.%1.initMsg").arg(name));
+        initMsgDecodedTime = QDltMetrics::instance()->histogram(QString("viewer.%1.initMsgDecoded").arg(name));
+        updateMsgTime = QDltMetrics::instance()->histogram(QString("viewer.%1.updateMsg").arg(name));
+        updateMsgDecodedTime = QDltMetrics::instance()->histogram(QString("viewer.%1.updateMsgDecoded").arg(name));
+    }
+    if(pluginviewerbatchinterface)
+    {
+        initMsgsTime = QDltMetrics::instance()->histogram(QString("viewer.%1.initMsgs").arg(name));
+        initMsgsDecodedTime = QDltMetrics::instance()->histogram(QString("viewer.%1.initMsgsDecoded").arg(name));
+        updateMsgsTime = QDltMetrics::instance()->histogram(QString("viewer.%1.updateMsgs").arg(name));
+        updateMsgsDecodedTime = QDltMetrics::instance()->histogram(QString("viewer.%1.updateMsgsDecoded").arg(name));
+    }
+
+    configGeneration.ref();
     //item->update();
 
 }
 
+void QDltPlugin::setMetaData(const QString &path, const QJsonObject &metaData)
+{
+    this->path = path;
+    metaName = metaData.value("name").toString();
+    metaVersion = metaData.value("version").toString();
+    metaInterfaceVersion = metaData.value("interfaceVersion").toString();
+    metaInterfaces.clear();
+    QJsonArray interfaces = metaData.value("interfaces").toArray();
+    for(int num = 0; num < interfaces.size(); num++)
+        metaInterfaces.append(interfaces[num].toString());
+}
+
+bool QDltPlugin::load()
+{
+    if(plugininterface)
+        return true;
+
+    if(path.isEmpty())
+        return false;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QPluginLoader pluginLoader(path);
+    QObject *plugin = pluginLoader.instance();
+    if(!plugin)
+    {
+        loadError = QString("The plugin %1 cannot be loaded.\n\nError: %2\n").arg(path).arg(pluginLoader.errorString());
+        return false;
+    }
+
+    QDLTPluginInterface *pluginInterface = qobject_cast<QDLTPluginInterface *>(plugin);
+    if(!pluginInterface)
+    {
+        /* no DLT Viewer plugin */
+        return false;
+    }
+
+    if(pluginInterface->pluginInterfaceVersion() != PLUGIN_INTERFACE_VERSION)
+    {
+        loadError = QString("Error: Plugin could not be loaded!\n"
+                            "Mismatch with plugin interface version of DLT Viewer.\n\n"
+                            "Plugin name: %1\n"
+                            "Plugin version: %2\n"
+                            "Plugin interface version: %3\n"
+                            "Plugin path: %4\n\n"
+                            "DLT Viewer - Plugin interface version: %5\n")
+                .arg(pluginInterface->name()).arg(pluginInterface->pluginVersion()).arg(pluginInterface->pluginInterfaceVersion())
+                .arg(path).arg(PLUGIN_INTERFACE_VERSION);
+        return false;
+    }
+
+    loadPlugin(plugin);
+
+    /* pass the control interface, if the plugin was loaded after initialisation */
+    if(plugincontrolinterface && control)
+        plugincontrolinterface->initControl(control);
+    if(plugincontrolinterface && connectionsSet)
+        plugincontrolinterface->initConnections(connections);
+
+    loadTime = timer.elapsed();
+    QDltMetrics::instance()->histogram(QString("pluginload.%1").arg(getName()))->record(timer.nsecsElapsed(), true);
+    qDebug() << "Loaded plugin" << getName() << getPluginVersion() << "in" << loadTime << "ms";
+
+    return true;
+}
+
+QString QDltPlugin::takeLoadError()
+{
+    QString error = loadError;
+    loadError.clear();
+    return error;
+}
+
 bool QDltPlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
 {
+    QMutexLocker locker(&decodeMutex);
+    QDltMetricTimer timer(decodeTime);
+
     if(mode != ModeDisable && plugindecoderinterface && plugindecoderinterface->isMsg(msg,triggeredByUser))
     {
         plugindecoderinterface->decodeMsg(msg,triggeredByUser);
+        timer.setHit();
         return true;
     }
     return false;
@@ -109,21 +245,47 @@ bool QDltPlugin::decodeMsg(QDltMsg &msg, int triggeredByUser)
 
 bool QDltPlugin::isDecoder()
 {
+    if(!plugininterface)
+        return metaInterfaces.contains("decoder");
     return (plugindecoderinterface?true:false);
 }
 
+bool QDltPlugin::getDecoderInterest(QDltDecoderInterest &interest)
+{
+    if(plugindecoderinterface && plugindecoderinterestinterface)
+        return plugindecoderinterestinterface->decoderInterest(interest);
+    else
+        return false;
+}
+
 bool QDltPlugin::isViewer()
 {
+    if(!plugininterface)
+        return metaInterfaces.contains("viewer");
     return (pluginviewerinterface?true:false);
 }
 
+bool QDltPlugin::isViewerBatch()
+{
+    return (pluginviewerbatchinterface?true:false);
+}
+
+bool QDltPlugin::isViewerWorker()
+{
+    return (pluginviewerworkerinterface && pluginviewerworkerinterface->runInWorkerThread());
+}
+
 bool QDltPlugin::isControl()
 {
+    if(!plugininterface)
+        return metaInterfaces.contains("control");
     return (plugincontrolinterface?true:false);
 }
 
 bool QDltPlugin::isCommand()
 {
+    if(!plugininterface)
+        return metaInterfaces.contains("command");
     return (plugincommandinterface?true:false);
 }
 
@@ -137,10 +299,15 @@ QStringList QDltPlugin::infoConfig()
 
 bool QDltPlugin::loadConfig(QString filename)
 {
-    if(plugininterface)
-        return plugininterface->loadConfig(filename);
-    else
-        return false;
+    bool ret = false;
+
+    if(load())
+        ret = plugininterface->loadConfig(filename);
+
+    /* the interest of a decoder can depend on the configuration */
+    configGeneration.ref();
+
+    return ret;
 }
 
 QString QDltPlugin::error()
@@ -153,6 +320,8 @@ QString QDltPlugin::error()
 
 bool QDltPlugin::command(QString cmd,QStringList params)
 {
+    load();
+
     if(plugincommandinterface)
         return plugincommandinterface->command(cmd,params);
     else
@@ -162,6 +331,8 @@ bool QDltPlugin::command(QString cmd,QStringList params)
 // viewer plugin interfaces
 QWidget* QDltPlugin::initViewer()
 {
+load();
+
 if(pluginviewerinterface)
     return pluginviewerinterface->initViewer();
 else
@@ -179,11 +350,13 @@ if(pluginviewerinterface)
 }
 void QDltPlugin::initMsg(int index, QDltMsg &msg)
 {
+QDltMetricTimer timer(initMsgTime);
 if(pluginviewerinterface)
     pluginviewerinterface->initMsg(index,msg);
 }
 void QDltPlugin::initMsgDecoded(int index, QDltMsg &msg)
 {
+QDltMetricTimer timer(initMsgDecodedTime);
 if(pluginviewerinterface)
     pluginviewerinterface->initMsgDecoded(index,msg);
 }
@@ -194,11 +367,13 @@ if(pluginviewerinterface)
 }
 void QDltPlugin::updateMsg(int index, QDltMsg &msg)
 {
+QDltMetricTimer timer(updateMsgTime);
 if(pluginviewerinterface)
     pluginviewerinterface->updateMsg(index,msg);
 }
 void QDltPlugin::updateMsgDecoded(int index, QDltMsg &msg)
 {
+QDltMetricTimer timer(updateMsgDecodedTime);
 if(pluginviewerinterface)
     pluginviewerinterface->updateMsgDecoded(index,msg);
 }
@@ -218,9 +393,38 @@ if(pluginviewerinterface)
     pluginviewerinterface->selectedIdxMsgDecoded(index,msg);
 }
 
+// viewer plugin batch interface
+void QDltPlugin::initMsgs(const QDltMsgBatch &batch)
+{
+QDltMetricTimer timer(initMsgsTime);
+if(pluginviewerbatchinterface)
+    pluginviewerbatchinterface->initMsgs(batch);
+}
+void QDltPlugin::initMsgsDecoded(const QDltMsgBatch &batch)
+{
+QDltMetricTimer timer(initMsgsDecodedTime);
+if(pluginviewerbatchinterface)
+    pluginviewerbatchinterface->initMsgsDecoded(batch);
+}
+void QDltPlugin::updateMsgs(const QDltMsgBatch &batch)
+{
+QDltMetricTimer timer(updateMsgsTime);
+if(pluginviewerbatchinterface)
+    pluginviewerbatchinterface->updateMsgs(batch);
+}
+void QDltPlugin::updateMsgsDecoded(const QDltMsgBatch &batch)
+{
+QDltMetricTimer timer(updateMsgsDecodedTime);
+if(pluginviewerbatchinterface)
+    pluginviewerbatchinterface->updateMsgsDecoded(batch);
+}
+
 // control plugin interface
 bool QDltPlugin::initControl(QDltControl *control)
 {
+    /* kept for plugins loaded later */
+    this->control = control;
+
     if(plugincontrolinterface)
         return plugincontrolinterface->initControl(control);
     else
@@ -229,6 +433,9 @@ bool QDltPlugin::initControl(QDltControl *control)
 
 bool QDltPlugin::initConnections(QStringList list)
 {
+    connections = list;
+    connectionsSet = true;
+
     if(plugincontrolinterface)
         return plugincontrolinterface->initConnections(list);
     else
@@ -4,8 +4,13 @@
 #include "plugininterface.h"
 
 #include <QDir>
+#include <QAtomicInt>
+#include <QMutex>
+#include <QJsonObject>
+#include <QStringList>
 
 #include "export_rules.h"
+#include "qdltmetrics.h"
 
 class QDLTPluginInterface;
 class QDLTPluginDecoderInterface;
@@ -16,6 +21,9 @@ class QDltPluginCommandInterface;
 //! Access class to a DLT Plugin to decode, view and control DLT messages
 /*!
   This class loads a DLT Viewer Plugin library and provides functions to access the plugin.
+  A plugin with metadata is only loaded on first use, e.g. when it is enabled or a
+  command is executed. Until then name and interfaces are taken from the metadata
+  and all plugin functions do nothing.
 */
 class QDLT_EXPORT QDltPlugin
 {
@@ -33,6 +41,37 @@ public:
     //! Load the plugin by attaching the interfaces
     void loadPlugin(QObject *plugin);
 
+    //! Set the plugin library and its metadata without loading the library
+    /*!
+      The metadata is the "MetaData" object of the JSON file of Q_PLUGIN_METADATA:
+      - "name": the name of the plugin, the plugin is only loaded on first use if the name is set
+      - "version": the plugin version
+      - "interfaceVersion": the plugin interface version
+      - "interfaces": list of "viewer", "decoder", "control" and "command"
+      \param path The complete path of the plugin library.
+      \param metaData The metadata of the plugin, can be empty.
+    */
+    void setMetaData(const QString &path, const QJsonObject &metaData);
+
+    //! Check if the plugin can be loaded on first use
+    bool hasMetaData() const { return !metaName.isEmpty(); }
+
+    //! Load the plugin library and attach the interfaces, if not loaded yet
+    /*!
+      The load time is measured in the histogram "pluginload.<name>".
+      \return true if the plugin is loaded, false if an error occurred.
+    */
+    bool load();
+
+    //! Check if the plugin library is loaded
+    bool isLoaded() const { return plugininterface != 0; }
+
+    //! Get and reset the error of the last failed load
+    QString takeLoadError();
+
+    //! Get the time in ms needed to load the plugin, -1 if not loaded
+    qint64 getLoadTime() const { return loadTime; }
+
     //! Get the name of the plugin
     QString getName();
 
@@ -62,6 +101,7 @@ public:
 
     //! Decode plugin if enabled and messages matches the decoder
     /*!
+      Plugins are not reentrant, calls from several threads are serialized per plugin.
       \return True if decoded, false if not decoded
     */
     bool decodeMsg(QDltMsg &msg, int triggeredByUser);
@@ -72,12 +112,37 @@ public:
     */
     bool isDecoder();
 
+    //! Get the messages handled by a decoder plugin
+    /*!
+      \param interest The criteria of the handled messages.
+      \return True if the plugin declared its interest, false if it must check all messages
+    */
+    bool getDecoderInterest(QDltDecoderInterest &interest);
+
+    //! Get the counter of changes of mode, configuration or interest of all plugins
+    /*!
+      The counter is used to detect that the decoder dispatch index must be updated.
+    */
+    static int getConfigGeneration();
+
     //! Check if this is a viewer plugin
     /*!
       \return True if it is a viewer plugin
     */
     bool isViewer();
 
+    //! Check if this is a viewer plugin processing messages in batches
+    /*!
+      \return True if it is a viewer plugin implementing the batch interface
+    */
+    bool isViewerBatch();
+
+    //! Check if this is a viewer plugin running the batch callbacks in a worker thread
+    /*!
+      \return True if it is a viewer plugin implementing the batch and the worker interface and requesting a worker thread
+    */
+    bool isViewerWorker();
+
     //! Check if this is a control plugin
     /*!
       \return True if it is a control plugin
@@ -108,6 +173,12 @@ public:
     void selectedIdxMsg(int index, QDltMsg &msg);
     void selectedIdxMsgDecoded(int index, QDltMsg &msg);
 
+    // viewer plugin batch interfaces
+    void initMsgs(const QDltMsgBatch &batch);
+    void initMsgsDecoded(const QDltMsgBatch &batch);
+    void updateMsgs(const QDltMsgBatch &batch);
+    void updateMsgsDecoded(const QDltMsgBatch &batch);
+
     // control plugin interfaces
     bool initControl(QDltControl *control);
     bool initConnections(QStringList list);
@@ -123,6 +194,20 @@ private:
     //! The complete filename of the plugin including path
     QString filename;
 
+    //! The plugin library and its metadata
+    QString path;
+    QString metaName;
+    QString metaVersion;
+    QString metaInterfaceVersion;
+    QStringList metaInterfaces;
+    QString loadError;
+    qint64 loadTime;
+
+    //! Control interface and connections, passed to the plugin when it is loaded
+    QDltControl *control;
+    QStringList connections;
+    bool connectionsSet;
+
     //! The running status of the plugin
     Mode mode;
 
@@ -133,8 +218,28 @@ private:
     QDLTPluginInterface *plugininterface;
     QDLTPluginDecoderInterface *plugindecoderinterface;
     QDltPluginViewerInterface  *pluginviewerinterface;
+    QDltPluginViewerBatchInterface *pluginviewerbatchinterface;
+    QDltPluginViewerWorkerInterface *pluginviewerworkerinterface;
     QDltPluginControlInterface *plugincontrolinterface;
     QDltPluginCommandInterface *plugincommandinterface;
+    QDltPluginDecoderInterestInterface *plugindecoderinterestinterface;
+
+    //! Serializes the calls of the decoder interface from several threads
+    QMutex decodeMutex;
+
+    //! Counter of changes of all plugins
+    static QAtomicInt configGeneration;
+
+    //! Histograms of the time spent in the plugin, created when the plugin is loaded.
+    QDltMetricHistogram *decodeTime;
+    QDltMetricHistogram *initMsgTime;
+    QDltMetricHistogram *initMsgDecodedTime;
+    QDltMetricHistogram *updateMsgTime;
+    QDltMetricHistogram *updateMsgDecodedTime;
+    QDltMetricHistogram *initMsgsTime;
+    QDltMetricHistogram *initMsgsDecodedTime;
+    QDltMetricHistogram *updateMsgsTime;
+    QDltMetricHistogram *updateMsgsDecodedTime;
 
 };
 
@@ -6,11 +6,23 @@
 //#include <QMessageBox>
 #include <QTextStream>
 #include <QString>
+#include <QMutexLocker>
+#include <QJsonObject>
+#include <QElapsedTimer>
+#include <QDebug>
+
+#include <algorithm>
 
 QDltPluginManager::QDltPluginManager()
 {
 }
 
+QDltPluginManager::~QDltPluginManager()
+{
+    delete dispatchTable.loadAcquire();
+    qDeleteAll(retiredDispatchTables);
+}
+
 int QDltPluginManager::size() const
 {
     return plugins.size();
@@ -32,6 +44,8 @@ QStringList QDltPluginManager::loadPlugins(const QString &settingsPluginPath)
 {
     QDir pluginsDir;
     QStringList errorStrings;
+    QElapsedTimer timer;
+    timer.start();
     /* The viewer looks in the relativ to the executable in the ./plugins directory */
     pluginsDir.setPath(QCoreApplication::applicationDirPath());
     if(pluginsDir.cd("plugins"))
@@ -56,6 +70,8 @@ QStringList QDltPluginManager::loadPlugins(const QString &settingsPluginPath)
         errorStrings << loadPluginsPath(pluginsDir);
     }
 
+    qDebug() << "Found" << plugins.size() << "plugins in" << timer.elapsed() << "ms";
+
     return errorStrings;
 }
 
@@ -69,48 +85,46 @@ QStringList QDltPluginManager::loadPluginsPath(QDir &dir)
     /* iterate through all plugins */
     foreach (QString fileName, dir.entryList(QDir::Files))
     {
-        QPluginLoader pluginLoader(dir.absoluteFilePath(fileName));
-        QObject *plugin = pluginLoader.instance();
-        if (plugin)
+        QString path = dir.absoluteFilePath(fileName);
+
+        /* the metadata is read without loading the library */
+        QElapsedTimer timer;
+        timer.start();
+        QPluginLoader pluginLoader(path);
+        QJsonObject metaData = pluginLoader.metaData().value("MetaData").toObject();
+
+        QDltPlugin* item = new QDltPlugin();
+        item->setMetaData(path,metaData);
+
+        if(item->hasMetaData())
         {
-            QDLTPluginInterface *plugininterface = qobject_cast<QDLTPluginInterface *>(plugin);
-            if (plugininterface)
+            /* the plugin is loaded on first use */
+            if(!item->getPluginInterfaceVersion().isEmpty() && item->getPluginInterfaceVersion() != PLUGIN_INTERFACE_VERSION)
             {
-                if(QString::compare( plugininterface->pluginInterfaceVersion(),PLUGIN_INTERFACE_VERSION, Qt::CaseSensitive) == 0){
-
-                    QDltPlugin* item = new QDltPlugin();
-                    item->loadPlugin(plugin);
-                    plugins.append(item);
-
-                    //project.plugin->addTopLevelItem(item);
-
-                } else {
-
-                    // This is an abomination - it's unreadable 425+ chars long
-                    // QMessageBox::warning(0, QString("DLT Viewer"),QString("Error: Plugin could not be loaded!\nMismatch with plugin interface version of DLT Viewer.\n\nPlugin name: %1\nPlugin version: %2\nPlugin interface version: %3\nPlugin path: %4\n\nDLT Viewer - Plugin interface version: %5").arg(plugininterface->name()).arg(plugininterface->pluginVersion()).arg(plugininterface->pluginInterfaceVersion()).arg(dir.absolutePath()).arg(PLUGIN_INTERFACE_VERSION));
-
-                    QTextStream errStr;
-                    errStr << "-------------"
-                           << "Error: Plugin could not be loaded!\n"
-                           << "Mismatch with plugin interface version of DLT Viewer.\n\n"
-                           << "Plugin name: " << plugininterface->name() << "\n"
-                           << "Plugin version: " << plugininterface->pluginVersion() << "\n"
-                           << "Plugin interface version: " << plugininterface->pluginInterfaceVersion() << "\n"
-                           << "Plugin path: " << dir.absolutePath() << "\n\n"
-                           << "DLT Viewer - Plugin interface version: " << PLUGIN_INTERFACE_VERSION  << "\n";
-                    errorStrings.append(*(errStr.string()));
-                }
+                errorStrings.append(QString("Error: Plugin could not be loaded!\n"
+                                            "Mismatch with plugin interface version of DLT Viewer.\n\n"
+                                            "Plugin name: %1\n"
+                                            "Plugin interface version: %2\n"
+                                            "Plugin path: %3\n\n"
+                                            "DLT Viewer - Plugin interface version: %4\n")
+                                    .arg(item->getName()).arg(item->getPluginInterfaceVersion()).arg(path).arg(PLUGIN_INTERFACE_VERSION));
+                delete item;
+                continue;
             }
+            qDebug() << "Found plugin" << item->getName() << "in" << timer.elapsed() << "ms";
+            plugins.append(item);
         }
-        else {
-            //QMessageBox::warning(0, QString("DLT Viewer"),QString("The plugin %1 cannot be loaded.\n\nError: %2").arg(dir.absoluteFilePath(fileName)).arg(pluginLoader.errorString()));
-
-             QTextStream  errStr;
-             errStr << "-------------"
-                    << "The plugin " << dir.absoluteFilePath(fileName) << "cannot be loaded.\n\n"
-                    << "Error: " << pluginLoader.errorString() << "\n";
-             errorStrings.append(*(errStr.string()));
-
+        else if(item->load())
+        {
+            /* plugins without metadata are loaded immediately */
+            plugins.append(item);
+        }
+        else
+        {
+            QString error = item->takeLoadError();
+            if(!error.isEmpty())
+                errorStrings.append(error);
+            delete item;
         }
     }
     return errorStrings;
@@ -127,16 +141,194 @@ void QDltPluginManager::loadConfig(QString pluginName,QString filename)
 }
 
 
-void QDltPluginManager::decodeMsg(QDltMsg &msg, int triggeredByUser)
+bool QDltPluginManager::decodeMsgCached(QDltMsg &msg, int index, int triggeredByUser)
 {
+    static QDltMetricCounter *cacheHits = QDltMetrics::instance()->counter("decodecache.hit");
+    static QDltMetricCounter *cacheMisses = QDltMetrics::instance()->counter("decodecache.miss");
+
+    switch(decodedMsgCache.lookup(index, msg))
+    {
+    case QDltDecodedMsgCache::CacheDecoded:
+        cacheHits->add();
+        return true;
+    case QDltDecodedMsgCache::CacheNotDecoded:
+        cacheHits->add();
+        return false;
+    case QDltDecodedMsgCache::CacheMiss:
+        cacheMisses->add();
+        break;
+    }
+
+    bool decoded = decodeMsg(msg, triggeredByUser);
+
+    if(decoded && decodedMsgCache.isRecording())
+        decodedMsgCache.store(index, msg);
+
+    return decoded;
+}
+
+bool QDltPluginManager::decodeMsg(QDltMsg &msg, int triggeredByUser)
+{
+    /* time of the dispatch including all asked plugins */
+    static QDltMetricHistogram *dispatchTime = QDltMetrics::instance()->histogram("pluginmanager.decode");
+    QDltMetricTimer timer(dispatchTime);
+
+    const DispatchTable *table = getDispatchTable();
+    const QVector<int> &decodersAnyApid = table->decodersAnyApid;
+
+    /* plugins interested in the application id of the message */
+    const QVector<int> *byApid = 0;
+    if(!table->decodersByApid.isEmpty())
+    {
+        QHash<QString, QVector<int> >::const_iterator it = table->decodersByApid.constFind(msg.getApid());
+        if(it != table->decodersByApid.constEnd())
+            byApid = &it.value();
+    }
+
+    /* merge with the plugins interested in all application ids, keeping the plugin order */
+    int posApid = 0, posAny = 0;
+    while(true)
+    {
+        int num;
+        if(byApid && posApid < byApid->size() && (posAny >= decodersAnyApid.size() || (*byApid)[posApid] < decodersAnyApid[posAny]))
+            num = (*byApid)[posApid++];
+        else if(posAny < decodersAnyApid.size())
+            num = decodersAnyApid[posAny++];
+        else
+            break;
+
+        const DecoderEntry &entry = table->decoders[num];
+        if(!entry.matches(msg))
+            continue;
+
+        if(entry.plugin->decodeMsg(msg,triggeredByUser))
+        {
+            timer.setHit();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool QDltPluginManager::DecoderEntry::matches(const QDltMsg &msg) const
+{
+    if(msg.getMode() == QDltMsg::DltModeVerbose ? !verbose : !nonVerbose)
+        return false;
+
+    if(typeMask && (msg.getType() < 0 || !(typeMask & (1u << msg.getType()))))
+        return false;
+
+    if(!ctids.isEmpty() && !ctids.contains(msg.getCtid()))
+        return false;
+
+    if(!messageIdRanges.isEmpty() && msg.getMode() == QDltMsg::DltModeNonVerbose)
+    {
+        /* binary search in the sorted ranges */
+        unsigned int id = msg.getMessageId();
+        int first = 0, last = messageIdRanges.size() - 1;
+        while(first <= last)
+        {
+            int mid = (first + last) / 2;
+            if(id < messageIdRanges[mid].first)
+                last = mid - 1;
+            else if(id > messageIdRanges[mid].second)
+                first = mid + 1;
+            else
+                return true;
+        }
+        return false;
+    }
+
+    return true;
+}
+
+void QDltPluginManager::releaseRetiredDispatchTables()
+{
+    QMutexLocker locker(&dispatchMutex);
+
+    qDeleteAll(retiredDispatchTables);
+    retiredDispatchTables.clear();
+}
+
+const QDltPluginManager::DispatchTable *QDltPluginManager::getDispatchTable()
+{
+    int generation = QDltPlugin::getConfigGeneration();
+    const DispatchTable *current = dispatchTable.loadAcquire();
+    if(current && current->generation == generation)
+        return current;
+
+    QMutexLocker locker(&dispatchMutex);
+
+    /* another thread could have published a new table meanwhile */
+    current = dispatchTable.loadAcquire();
+    if(current && current->generation == generation)
+        return current;
+
+    DispatchTable *table = new DispatchTable();
+    table->generation = generation;
+    QVector<DecoderEntry> &decoders = table->decoders;
+    QHash<QString, QVector<int> > &decodersByApid = table->decodersByApid;
+    QVector<int> &decodersAnyApid = table->decodersAnyApid;
+
     for(int num=0;num<plugins.size();num++)
     {
         QDltPlugin *plugin = plugins[num];
 
-        if(plugin->decodeMsg(msg,triggeredByUser))
-            break;
+        if(!plugin->isDecoder() || plugin->getMode() == QDltPlugin::ModeDisable)
+            continue;
+
+        DecoderEntry entry;
+        QDltDecoderInterest interest;
+        entry.plugin = plugin;
+
+        if(plugin->getDecoderInterest(interest))
+        {
+            entry.verbose = interest.verbose;
+            entry.nonVerbose = interest.nonVerbose;
+            foreach(QDltMsg::DltTypeDef type, interest.types)
+            {
+                if(type >= 0 && type < 32)
+                    entry.typeMask |= (1u << type);
+            }
+            entry.ctids = interest.ctids.toSet();
 
+            /* sort and merge overlapping ranges for the binary search */
+            QVector<QPair<unsigned int,unsigned int> > ranges = interest.messageIdRanges.toVector();
+            std::sort(ranges.begin(), ranges.end());
+            for(int range=0;range<ranges.size();range++)
+            {
+                if(!entry.messageIdRanges.isEmpty() && ranges[range].first <= entry.messageIdRanges.last().second)
+                    entry.messageIdRanges.last().second = qMax(entry.messageIdRanges.last().second, ranges[range].second);
+                else
+                    entry.messageIdRanges.append(ranges[range]);
+            }
+
+            if(!interest.apids.isEmpty())
+            {
+                foreach(QString apid, interest.apids.toSet())
+                    decodersByApid[apid].append(decoders.size());
+            }
+            else
+            {
+                decodersAnyApid.append(decoders.size());
+            }
+        }
+        else
+        {
+            /* old plugins get all messages */
+            decodersAnyApid.append(decoders.size());
+        }
+
+        decoders.append(entry);
     }
+
+    /* decoding threads may still use the old table, it is deleted when no decoding runs */
+    if(current)
+        retiredDispatchTables.append(current);
+    dispatchTable.storeRelease(table);
+
+    return table;
 }
 
 QDltPlugin* QDltPluginManager::findPlugin(QString &name)
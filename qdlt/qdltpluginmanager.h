@@ -2,8 +2,15 @@
 #define QDLTPLUGINMANAGER_H
 
 #include "plugininterface.h"
+#include "qdltdecodedmsgcache.h"
+#include "qdltmetrics.h"
 
 #include <QDir>
+#include <QHash>
+#include <QVector>
+#include <QSet>
+#include <QMutex>
+#include <QAtomicPointer>
 
 #include "export_rules.h"
 
@@ -21,6 +28,9 @@ public:
     //! Constructor
     QDltPluginManager();
 
+    //! Destructor
+    ~QDltPluginManager();
+
     //! The number of plugins
     /*!
       \return the number of loaded plugins.
@@ -39,6 +49,9 @@ public:
       - ./plugin
       - settingsPluginPath
       - /usr/share/dlt-viewer/plugins
+
+      Only the metadata of the plugins is read, a plugin with a name in its metadata
+      is loaded on first use. Plugins without metadata are loaded immediately.
       \param settingsPluginPath Full path name.
     */
     QStringList loadPlugins(const QString &settingsPluginPath);
@@ -52,9 +65,35 @@ public:
 
     //! Decode message by decoding through all loaded an activated decoder plugins
     /*!
+      Only decoder plugins with a matching declared interest are asked,
+      the first plugin handling the message decodes it.
+      \param msg The message to be decoded.
+      \return True if a plugin decoded the message.
+    */
+    bool decodeMsg(QDltMsg &msg,int triggeredByUser);
+
+    //! Decode message using the decoded message cache
+    /*!
+      If the decoded message cache covers the message, the cached result is used
+      instead of running the decoder plugins. While the cache is recording,
+      the result of the decoder plugins is stored in the cache.
+      The cache is bypassed after a decoder plugin changed, see QDltDecodedMsgCache::isComplete().
       \param msg The message to be decoded.
+      \param index The index of the message in the log file.
+      \return True if the message is decoded.
     */
-    void decodeMsg(QDltMsg &msg,int triggeredByUser);
+    bool decodeMsgCached(QDltMsg &msg,int index,int triggeredByUser);
+
+    //! Get the cache of decoded messages of the currently opened log file
+    QDltDecodedMsgCache &getDecodedMsgCache() { return decodedMsgCache; }
+
+    //! Delete the dispatch tables replaced after configuration changes.
+    /*!
+      Decoding threads read the dispatch table without locking, so a replaced
+      table is kept until this function is called.
+      It must only be called while no thread decodes messages, e.g. before the indexer is started.
+    */
+    void releaseRetiredDispatchTables();
 
     //! Get the list of pointers to all loaded plugins
     QList<QDltPlugin*> getPlugins() { return plugins; }
@@ -80,9 +119,62 @@ public:
 
 private:
 
+    //! A decoder plugin with its declared interest.
+    class DecoderEntry
+    {
+    public:
+        DecoderEntry() { plugin = 0; verbose = true; nonVerbose = true; typeMask = 0; }
+
+        //! Check the criteria of the interest apart from the application id.
+        bool matches(const QDltMsg &msg) const;
+
+        QDltPlugin *plugin;
+        bool verbose;
+        bool nonVerbose;
+        unsigned int typeMask;
+        QSet<QString> ctids;
+        QVector<QPair<unsigned int,unsigned int> > messageIdRanges;
+    };
+
+    //! Dispatch index of the decoder plugins.
+    /*!
+      A table is never changed after it is published, a configuration change
+      publishes a new table, so decoding threads read it without locking.
+    */
+    class DispatchTable
+    {
+    public:
+        DispatchTable() { generation = -1; }
+
+        //! Enabled decoder plugins in plugin order.
+        QVector<DecoderEntry> decoders;
+
+        //! Index into decoders of plugins interested in specific application ids.
+        QHash<QString, QVector<int> > decodersByApid;
+
+        //! Index into decoders of plugins interested in all application ids.
+        QVector<int> decodersAnyApid;
+
+        //! Plugin configuration generation the table was built for.
+        int generation;
+    };
+
+    //! Get the dispatch table, a new table is built if the plugin configuration changed.
+    const DispatchTable *getDispatchTable();
+
     //! The list of pointers to all loaded plugins
     QList<QDltPlugin*> plugins;
 
+    //! The currently published dispatch table.
+    QAtomicPointer<const DispatchTable> dispatchTable;
+
+    //! Replaced tables, which may still be used by a running decode, see releaseRetiredDispatchTables().
+    QList<const DispatchTable*> retiredDispatchTables;
+    QMutex dispatchMutex;
+
+    //! Decoding results of the currently opened log file.
+    QDltDecodedMsgCache decodedMsgCache;
+
     //! Loads all plugins from a special directory
     QStringList loadPluginsPath(QDir &dir);
 
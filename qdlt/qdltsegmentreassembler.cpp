@@ -0,0 +1,354 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltsegmentreassembler.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include "qdlt.h"
+#include "qdltsegmentreassembler.h"
+
+QDltSegmentReassembler::QDltSegmentReassembler()
+{
+    memory = 0;
+    maxMemory = QDLT_SEGMENT_MAX_MEMORY;
+    maxMessageSize = QDLT_SEGMENT_MAX_MESSAGE_SIZE;
+    maxAge = QDLT_SEGMENT_MAX_AGE;
+    lastEvictionTime = 0;
+    order = 0;
+    evicted = 0;
+    lastIndex = -1;
+}
+
+void QDltSegmentReassembler::setMaxMemory(qint64 bytes)
+{
+    QMutexLocker locker(&mutex);
+
+    maxMemory = bytes;
+    evictMemory(0);
+}
+
+void QDltSegmentReassembler::setMaxMessageSize(quint32 bytes)
+{
+    QMutexLocker locker(&mutex);
+
+    maxMessageSize = bytes;
+}
+
+void QDltSegmentReassembler::setMaxAge(int seconds)
+{
+    QMutexLocker locker(&mutex);
+
+    maxAge = seconds;
+}
+
+QDltSegmentReassembler::SegmentResult QDltSegmentReassembler::add(int index, QDltMsg &msg)
+{
+    QMutexLocker locker(&mutex);
+
+    /* the message was already added before a reload */
+    if(index >= 0)
+    {
+        if(index <= lastIndex)
+            return SegmentSkipped;
+        lastIndex = index;
+    }
+
+    QDltArgument argument;
+    if(msg.getNumberOfArguments() < 2 || !msg.getArgument(0,argument) || argument.getTypeInfo() != QDltArgument::DltTypeInfoStrg)
+        return SegmentNone;
+
+    qint64 time = msg.getTime();
+    if(time != lastEvictionTime)
+    {
+        evictAged(time);
+        lastEvictionTime = time;
+    }
+
+    QString str = argument.getValue().toString();
+    if(str == "NWST")
+        return addStart(msg,time);
+    else if(str == "NWCH")
+        return addChunk(msg,time);
+    else if(str == "NWEN")
+        return addEnd(msg,time);
+
+    return SegmentNone;
+}
+
+/* get an unsigned argument, returns false on type error */
+static bool getUInt(QDltMsg &msg, int index, quint32 &value)
+{
+    QDltArgument argument;
+    if(!msg.getArgument(index,argument) || argument.getTypeInfo() != QDltArgument::DltTypeInfoUInt)
+        return false;
+    value = argument.getValue().toUInt();
+    return true;
+}
+
+QDltSegmentReassembler::SegmentResult QDltSegmentReassembler::addStart(QDltMsg &msg, qint64 time)
+{
+    quint32 handle;
+    QDltArgument header;
+    Entry entry;
+
+    if(msg.getNumberOfArguments() != 6 ||
+       !getUInt(msg,1,handle) ||
+       !msg.getArgument(2,header) || header.getTypeInfo() != QDltArgument::DltTypeInfoRawd ||
+       !getUInt(msg,3,entry.size) ||
+       !getUInt(msg,4,entry.chunks) ||
+       !getUInt(msg,5,entry.chunkSize))
+    {
+        error = "Invalid start segment message";
+        return SegmentError;
+    }
+
+    /* the chunks must cover exactly the declared size, so every chunk is copied inside the payload */
+    if(entry.size > maxMessageSize || !entry.isValidLayout())
+    {
+        error = QString("Invalid size of segmented message %1: Size = %2, Chunks = %3, Chunk size = %4").arg(handle).arg(entry.size).arg(entry.chunks).arg(entry.chunkSize);
+        return SegmentError;
+    }
+
+    /* the handle is reused by a new message */
+    remove(handle);
+
+    entry.header = header.getData();
+    if(!evictMemory(entry.getMemory()))
+    {
+        error = QString("Segmented message %1 exceeds the memory limit").arg(handle);
+        return SegmentError;
+    }
+
+    /* the payload is allocated once, the chunks are copied directly to their position */
+    entry.payload.resize(entry.size);
+    entry.received.resize(entry.chunks);
+    entry.lastTime = time;
+    entry.order = ++order;
+    memory += entry.getMemory();
+    entries.insert(handle,entry);
+
+    return SegmentAdded;
+}
+
+QDltSegmentReassembler::SegmentResult QDltSegmentReassembler::addChunk(QDltMsg &msg, qint64 time)
+{
+    quint32 handle,sequence;
+    QDltArgument data;
+
+    if(msg.getNumberOfArguments() != 4 ||
+       !getUInt(msg,1,handle) ||
+       !getUInt(msg,2,sequence) ||
+       !msg.getArgument(3,data) || data.getTypeInfo() != QDltArgument::DltTypeInfoRawd)
+    {
+        error = "Invalid chunk segment message";
+        return SegmentError;
+    }
+
+    QHash<quint32,Entry>::iterator it = entries.find(handle);
+    if(it == entries.end())
+    {
+        error = QString("Chunk of unknown segmented message %1").arg(handle);
+        return SegmentError;
+    }
+    Entry &entry = it.value();
+
+    if(sequence >= entry.chunks)
+    {
+        error = QString("Sequence bigger than number of chunks: Sequence = %1, Chunks = %2").arg(sequence).arg(entry.chunks);
+        return SegmentError;
+    }
+
+    entry.lastTime = time;
+    entry.order = ++order;
+
+    /* repeated chunks are ignored */
+    if(entry.received.testBit(sequence))
+        return SegmentAdded;
+
+    quint64 offset = (quint64) sequence * entry.chunkSize;
+    if(offset < entry.size && data.getDataSize() > 0)
+    {
+        int length = (int) qMin((quint64) data.getDataSize(), entry.size - offset);
+        memcpy(entry.payload.data() + offset, data.getData().constData(), length);
+    }
+
+    entry.received.setBit(sequence);
+    entry.chunksReceived++;
+
+    return SegmentAdded;
+}
+
+QDltSegmentReassembler::SegmentResult QDltSegmentReassembler::addEnd(QDltMsg &msg, qint64 time)
+{
+    quint32 handle;
+
+    if(msg.getNumberOfArguments() != 2 || !getUInt(msg,1,handle))
+    {
+        error = "Invalid end segment message";
+        return SegmentError;
+    }
+
+    QHash<quint32,Entry>::iterator it = entries.find(handle);
+    if(it == entries.end())
+    {
+        error = QString("End of unknown segmented message %1").arg(handle);
+        return SegmentError;
+    }
+    Entry &entry = it.value();
+
+    entry.lastTime = time;
+    entry.order = ++order;
+
+    if(entry.chunksReceived != entry.chunks)
+    {
+        error = QString("Number of chunks mismatch: Received = %1, Total = %2").arg(entry.chunksReceived).arg(entry.chunks);
+        return SegmentError;
+    }
+
+    entry.complete = true;
+
+    return SegmentComplete;
+}
+
+void QDltSegmentReassembler::evictAged(qint64 time)
+{
+    QList<quint32> aged;
+
+    for(QHash<quint32,Entry>::const_iterator it = entries.constBegin(); it != entries.constEnd(); ++it)
+    {
+        if(!it.value().complete && time - it.value().lastTime > maxAge)
+            aged.append(it.key());
+    }
+
+    for(int num = 0; num < aged.size(); num++)
+        remove(aged[num]);
+
+    if(!aged.isEmpty())
+    {
+        evicted += aged.size();
+        QDltMetrics::instance()->counter("reassembly.evicted")->add(aged.size());
+    }
+}
+
+bool QDltSegmentReassembler::evictMemory(qint64 size)
+{
+    if(size > maxMemory)
+        return false;
+
+    while(memory + size > maxMemory && !entries.isEmpty())
+    {
+        /* remove the oldest completed message, if there is none the oldest incomplete message */
+        QHash<quint32,Entry>::const_iterator oldest = entries.constEnd();
+        for(QHash<quint32,Entry>::const_iterator it = entries.constBegin(); it != entries.constEnd(); ++it)
+        {
+            if(oldest == entries.constEnd() ||
+               (it.value().complete && !oldest.value().complete) ||
+               (it.value().complete == oldest.value().complete && it.value().order < oldest.value().order))
+                oldest = it;
+        }
+
+        remove(oldest.key());
+        evicted++;
+        QDltMetrics::instance()->counter("reassembly.evicted")->add();
+    }
+
+    return true;
+}
+
+void QDltSegmentReassembler::remove(quint32 handle)
+{
+    QHash<quint32,Entry>::iterator it = entries.find(handle);
+    if(it == entries.end())
+        return;
+
+    memory -= it.value().getMemory();
+    entries.erase(it);
+}
+
+bool QDltSegmentReassembler::contains(quint32 handle) const
+{
+    QMutexLocker locker(&mutex);
+
+    return entries.contains(handle);
+}
+
+bool QDltSegmentReassembler::isComplete(quint32 handle) const
+{
+    QMutexLocker locker(&mutex);
+
+    QHash<quint32,Entry>::const_iterator it = entries.find(handle);
+    return it != entries.constEnd() && it.value().complete;
+}
+
+QByteArray QDltSegmentReassembler::getMessage(quint32 handle) const
+{
+    QMutexLocker locker(&mutex);
+
+    QHash<quint32,Entry>::const_iterator it = entries.find(handle);
+    if(it == entries.constEnd() || !it.value().complete)
+        return QByteArray();
+
+    return it.value().header + it.value().payload;
+}
+
+void QDltSegmentReassembler::clear()
+{
+    QMutexLocker locker(&mutex);
+
+    entries.clear();
+    memory = 0;
+    lastEvictionTime = 0;
+    order = 0;
+    lastIndex = -1;
+    error.clear();
+}
+
+int QDltSegmentReassembler::getLastIndex() const
+{
+    QMutexLocker locker(&mutex);
+
+    return lastIndex;
+}
+
+qint64 QDltSegmentReassembler::getMemory() const
+{
+    QMutexLocker locker(&mutex);
+
+    return memory;
+}
+
+int QDltSegmentReassembler::size() const
+{
+    QMutexLocker locker(&mutex);
+
+    return entries.size();
+}
+
+qint64 QDltSegmentReassembler::getEvicted() const
+{
+    QMutexLocker locker(&mutex);
+
+    return evicted;
+}
+
+QString QDltSegmentReassembler::getError() const
+{
+    QMutexLocker locker(&mutex);
+
+    return error;
+}
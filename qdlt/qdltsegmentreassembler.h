@@ -0,0 +1,175 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltsegmentreassembler.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_SEGMENT_REASSEMBLER_H
+#define QDLT_SEGMENT_REASSEMBLER_H
+
+#include <QString>
+#include <QByteArray>
+#include <QBitArray>
+#include <QHash>
+#include <QMutex>
+
+#include "export_rules.h"
+
+class QDltMsg;
+
+//! Default maximum memory in bytes used by all reassembled messages.
+#define QDLT_SEGMENT_MAX_MEMORY (128*1024*1024)
+
+//! Default maximum size in bytes of a single segmented message.
+#define QDLT_SEGMENT_MAX_MESSAGE_SIZE (16*1024*1024)
+
+//! Default time in seconds after which an incomplete segmented message is discarded.
+#define QDLT_SEGMENT_MAX_AGE 60
+
+//! Reassemble segmented network messages with bounded memory.
+/*!
+  A segmented network message is sent as a start message NWST (handle, header,
+  size, number of chunks, chunk size), several chunk messages NWCH (handle,
+  sequence, data) and an end message NWEN (handle).
+  The payload of each message is allocated once with the declared size and the
+  chunks are copied directly to their position. A bitmap per handle stores the
+  received chunks, so repeated chunks are ignored.
+
+  Incomplete messages are discarded when no segment was received for
+  setMaxAge() seconds of log time. When the memory limit is reached the oldest
+  messages are discarded, completed messages first.
+  The messages are added with their index in the log file, messages up to the
+  last added index are skipped. So the state can be kept when the same log
+  file is loaded again, without parsing the segments again.
+  This class is thread safe, so a decoder plugin can add messages in the
+  viewer callbacks and look them up while decoding.
+*/
+class QDLT_EXPORT QDltSegmentReassembler
+{
+public:
+    //! Result of adding a message
+    typedef enum { SegmentNone, SegmentSkipped, SegmentAdded, SegmentComplete, SegmentError } SegmentResult;
+
+    //! Constructor.
+    QDltSegmentReassembler();
+
+    //! Set the maximum memory in bytes used by all messages.
+    void setMaxMemory(qint64 bytes);
+
+    //! Set the maximum size in bytes of a single message, larger messages are rejected.
+    void setMaxMessageSize(quint32 bytes);
+
+    //! Set the time in seconds of log time after which an incomplete message is discarded.
+    void setMaxAge(int seconds);
+
+    //! Add a segment of a segmented network message.
+    /*!
+      \param index The index of the message in the log file, -1 if the message is not part of a log file.
+      \param msg The message, the first argument must be NWST, NWCH or NWEN.
+      \return SegmentNone if the message is no segment, SegmentSkipped if the index was already added,
+      SegmentComplete if the end message completed the message, SegmentError if the segment was rejected.
+    */
+    SegmentResult add(int index, QDltMsg &msg);
+
+    //! Check if a message with this handle is known.
+    bool contains(quint32 handle) const;
+
+    //! Check if the message with this handle is complete.
+    bool isComplete(quint32 handle) const;
+
+    //! Get the complete message, header followed by payload.
+    /*!
+      \param handle The handle of the message.
+      \return The message data, empty if the message is unknown or not complete.
+    */
+    QByteArray getMessage(quint32 handle) const;
+
+    //! Remove all messages and reset the last added index.
+    void clear();
+
+    //! Get the index of the last added message, -1 if none.
+    int getLastIndex() const;
+
+    //! Get the memory in bytes used by all messages.
+    qint64 getMemory() const;
+
+    //! Get the number of messages.
+    int size() const;
+
+    //! Get the number of messages discarded because of age or memory limits.
+    qint64 getEvicted() const;
+
+    //! Get error string of the last rejected segment.
+    QString getError() const;
+
+private:
+    //! One segmented message.
+    class Entry
+    {
+    public:
+        Entry() : size(0), chunks(0), chunkSize(0), chunksReceived(0), lastTime(0), order(0), complete(false) {}
+
+        //! Memory used by the message including the bitmap of received chunks.
+        qint64 getMemory() const { return header.size() + (qint64) size + (chunks + 7) / 8; }
+
+        //! Check if the number of chunks matches the declared size and chunk size.
+        bool isValidLayout() const { return chunkSize > 0 && chunks == ((quint64) size + chunkSize - 1) / chunkSize; }
+
+        QByteArray header;
+        QByteArray payload;
+        QBitArray received;
+        quint32 size;
+        quint32 chunks;
+        quint32 chunkSize;
+        quint32 chunksReceived;
+
+        //! Log time in seconds of the last segment.
+        qint64 lastTime;
+
+        //! Sequence number of the last segment, used to find the oldest message.
+        qint64 order;
+
+        bool complete;
+    };
+
+    SegmentResult addStart(QDltMsg &msg, qint64 time);
+    SegmentResult addChunk(QDltMsg &msg, qint64 time);
+    SegmentResult addEnd(QDltMsg &msg, qint64 time);
+
+    //! Discard incomplete messages older than maxAge, must be called with locked mutex.
+    void evictAged(qint64 time);
+
+    //! Discard the oldest messages until the size fits into the memory limit, must be called with locked mutex.
+    bool evictMemory(qint64 size);
+
+    void remove(quint32 handle);
+
+    QHash<quint32,Entry> entries;
+    qint64 memory;
+    qint64 maxMemory;
+    quint32 maxMessageSize;
+    int maxAge;
+    qint64 lastEvictionTime;
+    qint64 order;
+    qint64 evicted;
+    int lastIndex;
+    QString error;
+    mutable QMutex mutex;
+};
+
+#endif // QDLT_SEGMENT_REASSEMBLER_H
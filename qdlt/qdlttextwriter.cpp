@@ -0,0 +1,189 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdlttextwriter.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include "qdlt.h"
+
+static const char textWriterHexDigits[16] = {'0','1','2','3','4','5','6','7','8','9','a','b','c','d','e','f'};
+
+void QDltTextWriter::appendLatin1(QString &text, const char *str, int size)
+{
+    text.append(QLatin1String(str, size));
+}
+
+void QDltTextWriter::appendInt(QString &text, qlonglong value)
+{
+    if(value < 0)
+    {
+        text.append(QLatin1Char('-'));
+        /* negate in unsigned arithmetic, so the minimum value does not overflow */
+        appendUInt(text, 0 - (qulonglong) value);
+    }
+    else
+    {
+        appendUInt(text, (qulonglong) value);
+    }
+}
+
+void QDltTextWriter::appendUInt(QString &text, qulonglong value, int width, char fill)
+{
+    char buffer[24];
+    char *end = buffer + sizeof(buffer);
+    char *pos = end;
+
+    do
+    {
+        *--pos = '0' + (char)(value % 10);
+        value /= 10;
+    } while(value);
+
+    for(int num = (int)(end - pos); num < width; num++)
+        text.append(QLatin1Char(fill));
+
+    text.append(QLatin1String(pos, (int)(end - pos)));
+}
+
+void QDltTextWriter::appendHex(QString &text, qulonglong value, int digits)
+{
+    char buffer[16];
+    char *end = buffer + sizeof(buffer);
+    char *pos = end;
+
+    do
+    {
+        *--pos = textWriterHexDigits[value & 0xf];
+        value >>= 4;
+    } while(value);
+
+    for(int num = (int)(end - pos); num < digits; num++)
+        text.append(QLatin1Char('0'));
+
+    text.append(QLatin1String(pos, (int)(end - pos)));
+}
+
+void QDltTextWriter::appendBinary(QString &text, qulonglong value, int digits)
+{
+    char buffer[80];
+    int size = 0;
+
+    if(digits > 64)
+        digits = 64;
+
+    for(int num = digits - 1; num >= 0; num--)
+    {
+        buffer[size++] = (value >> num) & 1 ? '1' : '0';
+        if(num != 0 && (num % 4) == 0)
+            buffer[size++] = ' ';
+    }
+
+    text.append(QLatin1String(buffer, size));
+}
+
+void QDltTextWriter::appendHexBytes(QString &text, const QByteArray &bytes)
+{
+    const int size = bytes.size();
+    if(size == 0)
+        return;
+
+    int start = text.size();
+    text.resize(start + size * 3 - 1);
+    QChar *dst = text.data() + start;
+    const char *src = bytes.constData();
+
+    for(int num = 0; num < size; num++)
+    {
+        if(num != 0)
+            *dst++ = QLatin1Char(' ');
+        *dst++ = QLatin1Char(textWriterHexDigits[(src[num] & 0xf0) >> 4]);
+        *dst++ = QLatin1Char(textWriterHexDigits[src[num] & 0x0f]);
+    }
+}
+
+void QDltTextWriter::appendDouble(QString &text, double value)
+{
+    /* same format as QString::arg(double), independent of the C locale */
+    text.append(QString::number(value, 'g', 6));
+}
+
+void QDltTextWriter::appendSimplified(QString &text, const QString &str)
+{
+    const int start = text.size();
+    const QChar *src = str.constData();
+    const QChar *srcEnd = src + str.size();
+
+    text.resize(start + str.size());
+    QChar *begin = text.data() + start;
+    QChar *dst = begin;
+    bool space = false;
+
+    for(; src < srcEnd; src++)
+    {
+        if(src->isSpace())
+        {
+            space = (dst != begin);
+        }
+        else
+        {
+            if(space)
+                *dst++ = QLatin1Char(' ');
+            space = false;
+            *dst++ = *src;
+        }
+    }
+
+    text.resize(start + (int)(dst - begin));
+}
+
+void QDltTextWriter::appendCSVValue(QString &text, const QString &value, bool simplified)
+{
+    const QChar *src = value.constData();
+    const QChar *srcEnd = src + value.size();
+    int quotes = 0;
+
+    for(const QChar *pos = src; pos < srcEnd; pos++)
+        if(*pos == QLatin1Char('"'))
+            quotes++;
+
+    /* the escaped value can only be shorter than this */
+    const int start = text.size();
+    text.resize(start + value.size() + quotes + 2);
+    QChar *begin = text.data() + start;
+    QChar *dst = begin;
+    bool space = false;
+
+    *dst++ = QLatin1Char('"');
+    for(; src < srcEnd; src++)
+    {
+        if(simplified && src->isSpace())
+        {
+            space = (dst != begin + 1);
+            continue;
+        }
+        if(space)
+            *dst++ = QLatin1Char(' ');
+        space = false;
+        if(*src == QLatin1Char('"'))
+            *dst++ = QLatin1Char('"');
+        *dst++ = *src;
+    }
+    *dst++ = QLatin1Char('"');
+
+    text.resize(start + (int)(dst - begin));
+}
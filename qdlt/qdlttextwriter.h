@@ -0,0 +1,93 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdlttextwriter.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_TEXT_WRITER_H
+#define QDLT_TEXT_WRITER_H
+
+#include <QString>
+#include <QByteArray>
+
+#include "export_rules.h"
+
+//! Append formatted values to a text buffer.
+/*!
+  The functions append directly to a caller provided buffer without creating
+  temporary strings or parsing format strings as QString::arg() does.
+  The output is the same as the output of the corresponding QString::arg()
+  and QString::simplified() calls, so the formatting of messages does not change.
+  When the buffer is reused for several messages, no allocation is needed at all.
+*/
+class QDLT_EXPORT QDltTextWriter
+{
+public:
+    //! Append a Latin-1 string.
+    static void appendLatin1(QString &text, const char *str, int size);
+
+    //! Append a signed integer in decimal format.
+    static void appendInt(QString &text, qlonglong value);
+
+    //! Append an unsigned integer in decimal format.
+    /*!
+      \param text The buffer.
+      \param value The value.
+      \param width Minimum number of characters, the value is padded at the front.
+      \param fill The fill character used for padding.
+    */
+    static void appendUInt(QString &text, qulonglong value, int width = 0, char fill = '0');
+
+    //! Append an unsigned integer in lower case hex format without prefix.
+    /*!
+      \param text The buffer.
+      \param value The value.
+      \param digits Minimum number of digits, the value is padded with zeros.
+    */
+    static void appendHex(QString &text, qulonglong value, int digits = 0);
+
+    //! Append an unsigned integer in binary format, groups of four digits are separated by a space.
+    /*!
+      \param text The buffer.
+      \param value The value.
+      \param digits Number of digits.
+    */
+    static void appendBinary(QString &text, qulonglong value, int digits);
+
+    //! Append bytes in hex format separated by spaces.
+    static void appendHexBytes(QString &text, const QByteArray &bytes);
+
+    //! Append a floating point value as QString::arg(double) does.
+    static void appendDouble(QString &text, double value);
+
+    //! Append a string with white space removed from start and end and each inner sequence replaced by a single space.
+    /*!
+      This is the same as appending QString::simplified(), without the temporary string.
+    */
+    static void appendSimplified(QString &text, const QString &str);
+
+    //! Append a value quoted for CSV, double quotes in the value are escaped with another double quote.
+    /*!
+      \param text The buffer.
+      \param value The value.
+      \param simplified White space in the value is handled as by appendSimplified().
+    */
+    static void appendCSVValue(QString &text, const QString &value, bool simplified = false);
+};
+
+#endif // QDLT_TEXT_WRITER_H
@@ -0,0 +1,154 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdlttimecache.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QThreadStorage>
+
+#include "qdlt.h"
+
+/* Marks an entry of the local time cache, UTC offsets are always smaller */
+#define QDLT_TIME_CACHE_LOCAL ((qlonglong) 0x7fffffffffffffffLL)
+
+/* One remembered second */
+class QDltTimeCacheEntry
+{
+public:
+    QDltTimeCacheEntry() : time(0), offset(0), valid(false) {}
+
+    time_t time;
+    qlonglong offset;
+    bool valid;
+    QString text;
+};
+
+/* Direct mapped cache of one thread */
+class QDltTimeCacheTable
+{
+public:
+    QDltTimeCacheEntry entries[QDLT_TIME_CACHE_SIZE];
+
+    QDltTimeCacheEntry &entry(time_t time, qlonglong offset)
+    {
+        quint64 hash = (quint64) time ^ ((quint64) offset * 31);
+        return entries[hash % QDLT_TIME_CACHE_SIZE];
+    }
+};
+
+static QThreadStorage<QDltTimeCacheTable*> timeCacheTables;
+
+static QDltTimeCacheTable *timeCacheTable()
+{
+    if(!timeCacheTables.hasLocalData())
+        timeCacheTables.setLocalData(new QDltTimeCacheTable());
+    return timeCacheTables.localData();
+}
+
+/* thread safe variants of localtime and gmtime */
+static bool timeCacheLocalTime(time_t time, struct tm &time_tm)
+{
+#if defined(Q_OS_WIN)
+    return localtime_s(&time_tm, &time) == 0;
+#else
+    return localtime_r(&time, &time_tm) != NULL;
+#endif
+}
+
+static bool timeCacheGmTime(time_t time, struct tm &time_tm)
+{
+#if defined(Q_OS_WIN)
+    return gmtime_s(&time_tm, &time) == 0;
+#else
+    return gmtime_r(&time, &time_tm) != NULL;
+#endif
+}
+
+QString QDltTimeCache::formatTime(const struct tm &time_tm)
+{
+    char text[32];
+    int year = time_tm.tm_year + 1900;
+    int pos = 0;
+
+    if(year < 0 || year > 9999)
+        year = 0;
+
+    text[pos++] = '0' + (year / 1000);
+    text[pos++] = '0' + (year / 100) % 10;
+    text[pos++] = '0' + (year / 10) % 10;
+    text[pos++] = '0' + year % 10;
+    text[pos++] = '/';
+    text[pos++] = '0' + (time_tm.tm_mon + 1) / 10;
+    text[pos++] = '0' + (time_tm.tm_mon + 1) % 10;
+    text[pos++] = '/';
+    text[pos++] = '0' + time_tm.tm_mday / 10;
+    text[pos++] = '0' + time_tm.tm_mday % 10;
+    text[pos++] = ' ';
+    text[pos++] = '0' + time_tm.tm_hour / 10;
+    text[pos++] = '0' + time_tm.tm_hour % 10;
+    text[pos++] = ':';
+    text[pos++] = '0' + time_tm.tm_min / 10;
+    text[pos++] = '0' + time_tm.tm_min % 10;
+    text[pos++] = ':';
+    text[pos++] = '0' + time_tm.tm_sec / 10;
+    text[pos++] = '0' + time_tm.tm_sec % 10;
+
+    return QString::fromLatin1(text, pos);
+}
+
+QString QDltTimeCache::localTimeString(time_t time)
+{
+    QDltTimeCacheEntry &entry = timeCacheTable()->entry(time, QDLT_TIME_CACHE_LOCAL);
+
+    if(!entry.valid || entry.time != time || entry.offset != QDLT_TIME_CACHE_LOCAL)
+    {
+        struct tm time_tm;
+
+        entry.time = time;
+        entry.offset = QDLT_TIME_CACHE_LOCAL;
+        entry.valid = true;
+        if(timeCacheLocalTime(time, time_tm))
+            entry.text = formatTime(time_tm);
+        else
+            entry.text = QString();
+    }
+
+    /* implicitly shared, no copy of the text is made */
+    return entry.text;
+}
+
+QString QDltTimeCache::gmTimeWithOffsetString(time_t time, qlonglong utcOffsetInSeconds, bool dst)
+{
+    qlonglong offset = utcOffsetInSeconds + (dst ? 3600 : 0);
+    QDltTimeCacheEntry &entry = timeCacheTable()->entry(time, offset);
+
+    if(!entry.valid || entry.time != time || entry.offset != offset)
+    {
+        struct tm time_tm;
+
+        entry.time = time;
+        entry.offset = offset;
+        entry.valid = true;
+        if(timeCacheGmTime((time_t) (time + offset), time_tm))
+            entry.text = formatTime(time_tm);
+        else
+            entry.text = QString("Invalid date");
+    }
+
+    return entry.text;
+}
@@ -0,0 +1,65 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdlttimecache.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_TIME_CACHE_H
+#define QDLT_TIME_CACHE_H
+
+#include <QString>
+#include <time.h>
+
+#include "export_rules.h"
+
+//! Number of seconds remembered per thread and time mode.
+#define QDLT_TIME_CACHE_SIZE 64
+
+//! Cached conversion of storage header time to calendar time text.
+/*!
+  Converting a time to "yyyy/MM/dd hh:mm:ss" needs a time zone lookup and
+  formatting, but neighbouring messages mostly share the same second.
+  The rendered text is remembered per second, separately for local time and
+  for each UTC offset and DST setting, so the conversion is done only once per second.
+  Each thread uses its own cache, so the functions are thread safe and lock free
+  and can be used by the parallel indexer threads.
+*/
+class QDLT_EXPORT QDltTimeCache
+{
+public:
+    //! Get the local time text of a time.
+    /*!
+      \param time Seconds since 1.1.1970 UTC.
+      \return The text in format "yyyy/MM/dd hh:mm:ss", empty if the time cannot be converted.
+    */
+    static QString localTimeString(time_t time);
+
+    //! Get the time text of a time with a fixed UTC offset.
+    /*!
+      \param time Seconds since 1.1.1970 UTC.
+      \param utcOffsetInSeconds Offset added to UTC.
+      \param dst One hour is added for daylight saving time.
+      \return The text in format "yyyy/MM/dd hh:mm:ss", "Invalid date" if the time cannot be converted.
+    */
+    static QString gmTimeWithOffsetString(time_t time, qlonglong utcOffsetInSeconds, bool dst);
+
+    //! Format a broken down time as "yyyy/MM/dd hh:mm:ss".
+    static QString formatTime(const struct tm &time_tm);
+};
+
+#endif // QDLT_TIME_CACHE_H
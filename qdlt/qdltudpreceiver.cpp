@@ -0,0 +1,251 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltudpreceiver.cpp
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#include <QtDebug>
+
+#if defined(Q_OS_LINUX)
+#include <unistd.h>
+#include <poll.h>
+#include <errno.h>
+#include <string.h>
+#include <sys/socket.h>
+#endif
+
+#include "qdltudpreceiver.h"
+
+//! Maximum size of a UDP datagram.
+#define QDLT_UDP_RECEIVER_DATAGRAM_SIZE 65536
+
+//! Time in ms after which the receiver thread checks for a stop request.
+#define QDLT_UDP_RECEIVER_POLL_TIMEOUT 100
+
+QDltUDPReceiver::QDltUDPReceiver(QObject *parent)
+    : QThread(parent)
+{
+    fd = -1;
+    stopRequested = false;
+    signalPending = false;
+    dropsTotal = 0;
+    dropsTaken = 0;
+    dropsOverflow = 0;
+    datagrams = 0;
+    pendingGauge = QDltMetrics::instance()->gauge("receive.udp.pending");
+    overflowCounter = QDltMetrics::instance()->counter("receive.udp.overflow");
+}
+
+QDltUDPReceiver::~QDltUDPReceiver()
+{
+    close();
+}
+
+bool QDltUDPReceiver::isSupported()
+{
+#if defined(Q_OS_LINUX) && defined(SO_RXQ_OVFL)
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool QDltUDPReceiver::open(qintptr socketDescriptor)
+{
+    close();
+
+#if defined(Q_OS_LINUX) && defined(SO_RXQ_OVFL)
+    fd = dup(socketDescriptor);
+    if(fd < 0)
+    {
+        qDebug() << "QDltUDPReceiver: cannot duplicate socket" << strerror(errno);
+        return false;
+    }
+
+    /* a large buffer in the kernel bridges the time the thread is not scheduled,
+       SO_RCVBUFFORCE is only allowed with CAP_NET_ADMIN, SO_RCVBUF is limited by rmem_max */
+    int size = QDLT_UDP_RECEIVER_BUFFER_SIZE;
+    if(setsockopt(fd, SOL_SOCKET, SO_RCVBUFFORCE, &size, sizeof(size)) < 0)
+        setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+
+    /* report the number of dropped datagrams with each received datagram */
+    int enable = 1;
+    if(setsockopt(fd, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable)) < 0)
+        qDebug() << "QDltUDPReceiver: drop counter not available" << strerror(errno);
+
+    mutex.lock();
+    data.clear();
+    signalPending = false;
+    dropsTotal = 0;
+    dropsTaken = 0;
+    dropsOverflow = 0;
+    datagrams = 0;
+    stopRequested = false;
+    mutex.unlock();
+
+    QThread::start();
+    return true;
+#else
+    Q_UNUSED(socketDescriptor);
+    return false;
+#endif
+}
+
+void QDltUDPReceiver::close()
+{
+    if(fd < 0)
+        return;
+
+    mutex.lock();
+    stopRequested = true;
+    mutex.unlock();
+
+    wait();
+
+#if defined(Q_OS_LINUX)
+    ::close(fd);
+#endif
+    fd = -1;
+}
+
+QByteArray QDltUDPReceiver::takeData()
+{
+    QMutexLocker locker(&mutex);
+
+    QByteArray result;
+    result.swap(data);
+    signalPending = false;
+    pendingGauge->set(0);
+
+    return result;
+}
+
+quint64 QDltUDPReceiver::takeDrops()
+{
+    QMutexLocker locker(&mutex);
+
+    /* the counter of the kernel wraps around */
+    quint64 result = (quint32) (dropsTotal - dropsTaken) + dropsOverflow;
+    dropsTaken = dropsTotal;
+    dropsOverflow = 0;
+
+    return result;
+}
+
+quint64 QDltUDPReceiver::getDatagrams()
+{
+    QMutexLocker locker(&mutex);
+
+    return datagrams;
+}
+
+void QDltUDPReceiver::run()
+{
+#if defined(Q_OS_LINUX) && defined(SO_RXQ_OVFL)
+    QByteArray buffer(QDLT_UDP_RECEIVER_BATCH * QDLT_UDP_RECEIVER_DATAGRAM_SIZE, 0);
+    struct mmsghdr msgs[QDLT_UDP_RECEIVER_BATCH];
+    struct iovec iovecs[QDLT_UDP_RECEIVER_BATCH];
+    /* the control buffers must be aligned for struct cmsghdr */
+    quint64 control[QDLT_UDP_RECEIVER_BATCH][(CMSG_SPACE(sizeof(quint32)) + sizeof(quint64) - 1) / sizeof(quint64)];
+    QByteArray batch;
+
+    while(true)
+    {
+        mutex.lock();
+        bool stop = stopRequested;
+        mutex.unlock();
+        if(stop)
+            break;
+
+        struct pollfd pfd;
+        pfd.fd = fd;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        if(poll(&pfd, 1, QDLT_UDP_RECEIVER_POLL_TIMEOUT) <= 0)
+            continue;
+
+        /* the buffers are set again for each call, recvmmsg changes the lengths */
+        for(int num = 0; num < QDLT_UDP_RECEIVER_BATCH; num++)
+        {
+            iovecs[num].iov_base = buffer.data() + num * QDLT_UDP_RECEIVER_DATAGRAM_SIZE;
+            iovecs[num].iov_len = QDLT_UDP_RECEIVER_DATAGRAM_SIZE;
+            memset(&msgs[num], 0, sizeof(msgs[num]));
+            msgs[num].msg_hdr.msg_iov = &iovecs[num];
+            msgs[num].msg_hdr.msg_iovlen = 1;
+            msgs[num].msg_hdr.msg_control = control[num];
+            msgs[num].msg_hdr.msg_controllen = sizeof(control[num]);
+        }
+
+        int count = recvmmsg(fd, msgs, QDLT_UDP_RECEIVER_BATCH, MSG_DONTWAIT, NULL);
+        if(count <= 0)
+        {
+            if(count < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                qDebug() << "QDltUDPReceiver: receive failed" << strerror(errno);
+                msleep(QDLT_UDP_RECEIVER_POLL_TIMEOUT);
+            }
+            continue;
+        }
+
+        /* only this thread adds data, so the space can only grow until the data is appended */
+        mutex.lock();
+        qint64 space = QDLT_UDP_RECEIVER_MAX_PENDING - data.size();
+        mutex.unlock();
+
+        batch.resize(0);
+        quint32 dropCounter = 0;
+        bool dropCounterFound = false;
+        quint64 overflow = 0;
+        for(int num = 0; num < count; num++)
+        {
+            /* whole datagrams are dropped, so the messages in the collected data stay intact */
+            if(batch.size() + (qint64) msgs[num].msg_len <= space)
+                batch.append((const char*) iovecs[num].iov_base, msgs[num].msg_len);
+            else
+                overflow++;
+
+            for(struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msgs[num].msg_hdr); cmsg != NULL; cmsg = CMSG_NXTHDR(&msgs[num].msg_hdr, cmsg))
+            {
+                if(cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SO_RXQ_OVFL)
+                {
+                    memcpy(&dropCounter, CMSG_DATA(cmsg), sizeof(dropCounter));
+                    dropCounterFound = true;
+                }
+            }
+        }
+
+        if(overflow > 0)
+            overflowCounter->add(overflow);
+
+        mutex.lock();
+        data.append(batch);
+        datagrams += count;
+        dropsOverflow += overflow;
+        pendingGauge->set(data.size());
+        if(dropCounterFound)
+            dropsTotal = dropCounter;
+        bool notify = !signalPending;
+        signalPending = true;
+        mutex.unlock();
+
+        /* the receiver of the signal takes all collected data at once */
+        if(notify)
+            emit dataReceived();
+    }
+#endif
+}
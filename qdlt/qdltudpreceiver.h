@@ -0,0 +1,120 @@
+/**
+ * @licence app begin@
+ * Copyright (C) 2011-2014  BMW AG
+ *
+ * This file is part of GENIVI Project Dlt Viewer.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * \author Alexander Wenzel <alexander.aw.wenzel@bmw.de> 2011-2012
+ *
+ * \file qdltudpreceiver.h
+ * For further information see http://www.genivi.org/.
+ * @licence end@
+ */
+
+#ifndef QDLT_UDP_RECEIVER_H
+#define QDLT_UDP_RECEIVER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QByteArray>
+
+#include "export_rules.h"
+#include "qdltmetrics.h"
+
+//! Number of datagrams received with one system call.
+#define QDLT_UDP_RECEIVER_BATCH 64
+
+//! Requested size of the socket receive buffer in the kernel.
+#define QDLT_UDP_RECEIVER_BUFFER_SIZE (8*1024*1024)
+
+//! Maximum number of bytes collected and not taken yet, further datagrams are dropped.
+#define QDLT_UDP_RECEIVER_MAX_PENDING (64*1024*1024)
+
+//! Receive UDP datagrams of a socket in a background thread.
+/*!
+  On Linux the datagrams are received in batches with recvmmsg(), the socket
+  receive buffer is enlarged and the number of datagrams dropped by the kernel
+  is counted with SO_RXQ_OVFL.
+  The data of all received datagrams is collected until it is taken by
+  takeData(), dataReceived() is emitted once for each collected batch.
+  If the collected data is not taken and reaches QDLT_UDP_RECEIVER_MAX_PENDING,
+  further datagrams are dropped and counted like the drops of the kernel.
+  On other systems isSupported() returns false and the socket has to be read
+  in the event loop.
+*/
+class QDLT_EXPORT QDltUDPReceiver : public QThread
+{
+    Q_OBJECT
+public:
+    //! Constructor.
+    QDltUDPReceiver(QObject *parent = 0);
+
+    //! Destructor, stops the receiver thread.
+    ~QDltUDPReceiver();
+
+    //! Check if the receiver is supported on this system.
+    static bool isSupported();
+
+    //! Start receiving from a socket.
+    /*!
+      The socket descriptor is duplicated, the socket stays owned by the caller.
+      \param socketDescriptor The descriptor of a bound or connected UDP socket.
+      \return true if the operation was successful, false if an error occurred.
+    */
+    bool open(qintptr socketDescriptor);
+
+    //! Stop receiving and close the duplicated socket.
+    void close();
+
+    //! Check if the receiver is active.
+    bool isOpen() const { return fd >= 0; }
+
+    //! Take the data received since the last call, this function is thread safe.
+    QByteArray takeData();
+
+    //! Take the number of datagrams dropped by the kernel or the receiver since the last call.
+    quint64 takeDrops();
+
+    //! Get the number of received datagrams.
+    quint64 getDatagrams();
+
+signals:
+    //! New data was received, it is signaled again after takeData() was called.
+    void dataReceived();
+
+protected:
+    void run();
+
+private:
+    int fd;
+    bool stopRequested;
+
+    QMutex mutex;
+    QByteArray data;
+    bool signalPending;
+
+    //! Drop counter of the socket reported by the kernel and the part already taken.
+    quint32 dropsTotal;
+    quint32 dropsTaken;
+
+    //! Datagrams dropped because the collected data reached the limit and not taken yet.
+    quint64 dropsOverflow;
+
+    quint64 datagrams;
+
+    //! Number of bytes collected and not taken yet.
+    QDltMetricGauge *pendingGauge;
+
+    //! Number of datagrams dropped because the collected data reached the limit.
+    QDltMetricCounter *overflowCounter;
+};
+
+#endif // QDLT_UDP_RECEIVER_H
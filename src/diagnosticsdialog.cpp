@@ -0,0 +1,216 @@
+#include <QTreeWidget>
+#include <QHeaderView>
+#include <QLineEdit>
+#include <QSpinBox>
+#include <QLabel>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+#include <QFileDialog>
+#include <QDateTime>
+
+#include "diagnosticsdialog.h"
+#include "dltsettingsmanager.h"
+#include "qdltmetrics.h"
+
+DiagnosticsDialog::DiagnosticsDialog(QWidget *parent) :
+    QDialog(parent)
+{
+    setWindowTitle("Performance Diagnostics");
+    resize(700, 500);
+
+    tree = new QTreeWidget(this);
+    tree->setColumnCount(7);
+    tree->setHeaderLabels(QStringList() << "Metric" << "Value" << "Rate/s" << "Mean us" << "P50 us" << "P99 us" << "Max us");
+    tree->header()->setSectionResizeMode(0, QHeaderView::ResizeToContents);
+    tree->setSortingEnabled(true);
+    tree->sortByColumn(0, Qt::AscendingOrder);
+
+    lineEditDumpFile = new QLineEdit(this);
+    lineEditDumpFile->setText(DltSettingsManager::getInstance()->value("startup/metricsDumpFile", QString()).toString());
+    QPushButton *buttonBrowse = new QPushButton("...", this);
+
+    spinBoxDumpInterval = new QSpinBox(this);
+    spinBoxDumpInterval->setRange(0, 3600);
+    spinBoxDumpInterval->setSuffix(" s");
+    spinBoxDumpInterval->setSpecialValueText("off");
+    spinBoxDumpInterval->setValue(DltSettingsManager::getInstance()->value("startup/metricsDumpInterval", 0).toInt());
+
+    labelStatus = new QLabel(this);
+    QPushButton *buttonClose = new QPushButton("Close", this);
+
+    QHBoxLayout *dumpLayout = new QHBoxLayout();
+    dumpLayout->addWidget(new QLabel("JSON dump file:", this));
+    dumpLayout->addWidget(lineEditDumpFile);
+    dumpLayout->addWidget(buttonBrowse);
+    dumpLayout->addWidget(new QLabel("Interval:", this));
+    dumpLayout->addWidget(spinBoxDumpInterval);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addWidget(labelStatus, 1);
+    buttonLayout->addWidget(buttonClose);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(tree);
+    layout->addLayout(dumpLayout);
+    layout->addLayout(buttonLayout);
+
+    connect(buttonBrowse, SIGNAL(clicked()), this, SLOT(browseDumpFile()));
+    connect(buttonClose, SIGNAL(clicked()), this, SLOT(close()));
+    connect(lineEditDumpFile, SIGNAL(editingFinished()), this, SLOT(dumpSettingsChanged()));
+    connect(spinBoxDumpInterval, SIGNAL(valueChanged(int)), this, SLOT(dumpSettingsChanged()));
+
+    secondsSinceDump = 0;
+    timingRequested = false;
+    connect(&timer, SIGNAL(timeout()), this, SLOT(sample()));
+    timer.start(1000);
+
+    updateTimingEnabled();
+}
+
+void DiagnosticsDialog::showEvent(QShowEvent *event)
+{
+    QDialog::showEvent(event);
+
+    updateTimingEnabled();
+    updateTree(QDltMetrics::instance()->snapshot());
+}
+
+void DiagnosticsDialog::hideEvent(QHideEvent *event)
+{
+    QDialog::hideEvent(event);
+
+    updateTimingEnabled();
+}
+
+void DiagnosticsDialog::sample()
+{
+    int interval = spinBoxDumpInterval->value();
+    bool dump = interval > 0 && !lineEditDumpFile->text().isEmpty();
+
+    /* nothing to do as long as nobody looks at the metrics */
+    if(!isVisible() && !dump)
+        return;
+
+    QDltMetrics::instance()->sample();
+
+    if(isVisible())
+        updateTree(QDltMetrics::instance()->snapshot());
+
+    if(dump && ++secondsSinceDump >= interval)
+    {
+        secondsSinceDump = 0;
+        if(QDltMetrics::instance()->dumpJson(lineEditDumpFile->text()))
+            labelStatus->setText(QString("Written %1").arg(QDateTime::currentDateTime().toString("hh:mm:ss")));
+        else
+            labelStatus->setText(QString("Cannot write %1").arg(lineEditDumpFile->text()));
+    }
+}
+
+void DiagnosticsDialog::browseDumpFile()
+{
+    QString fileName = QFileDialog::getSaveFileName(this, "Metrics JSON dump file", lineEditDumpFile->text(), "JSON (*.json);;All files (*.*)");
+    if(fileName.isEmpty())
+        return;
+
+    lineEditDumpFile->setText(fileName);
+    dumpSettingsChanged();
+}
+
+void DiagnosticsDialog::dumpSettingsChanged()
+{
+    DltSettingsManager::getInstance()->setValue("startup/metricsDumpFile", lineEditDumpFile->text());
+    DltSettingsManager::getInstance()->setValue("startup/metricsDumpInterval", spinBoxDumpInterval->value());
+
+    secondsSinceDump = 0;
+    labelStatus->clear();
+    updateTimingEnabled();
+}
+
+void DiagnosticsDialog::updateTimingEnabled()
+{
+    bool dump = spinBoxDumpInterval->value() > 0 && !lineEditDumpFile->text().isEmpty();
+
+    bool timing = isVisible() || dump;
+    if(timing != timingRequested)
+    {
+        QDltMetrics::requestTiming(timing);
+        timingRequested = timing;
+    }
+}
+
+void DiagnosticsDialog::updateTree(const QJsonObject &snapshot)
+{
+    QJsonObject counters = snapshot["counters"].toObject();
+    QTreeWidgetItem *group = groupItem("Counters");
+    for(QJsonObject::const_iterator it = counters.constBegin(); it != counters.constEnd(); ++it)
+    {
+        QJsonObject counter = it.value().toObject();
+        setItem(group, it.key(), QStringList()
+                << QString("%L1").arg((qint64) counter["value"].toDouble())
+                << QString("%L1").arg(counter["rate"].toDouble(), 0, 'f', 1));
+    }
+
+    QJsonObject hitRates = snapshot["hitRates"].toObject();
+    group = groupItem("Hit rates");
+    for(QJsonObject::const_iterator it = hitRates.constBegin(); it != hitRates.constEnd(); ++it)
+    {
+        setItem(group, it.key(), QStringList() << QString("%1 %").arg(it.value().toDouble() * 100, 0, 'f', 1));
+    }
+
+    QJsonObject gauges = snapshot["gauges"].toObject();
+    group = groupItem("Gauges");
+    for(QJsonObject::const_iterator it = gauges.constBegin(); it != gauges.constEnd(); ++it)
+    {
+        setItem(group, it.key(), QStringList() << QString("%L1").arg((qint64) it.value().toDouble()));
+    }
+
+    QJsonObject histograms = snapshot["histograms"].toObject();
+    group = groupItem("Durations");
+    for(QJsonObject::const_iterator it = histograms.constBegin(); it != histograms.constEnd(); ++it)
+    {
+        QJsonObject histogram = it.value().toObject();
+        setItem(group, it.key(), QStringList()
+                << QString("%L1").arg((qint64) histogram["count"].toDouble())
+                << QString()
+                << QString::number(histogram["meanUs"].toDouble(), 'f', 2)
+                << QString::number(histogram["p50Us"].toDouble(), 'f', 1)
+                << QString::number(histogram["p99Us"].toDouble(), 'f', 1)
+                << QString::number(histogram["maxUs"].toDouble(), 'f', 1));
+    }
+
+    if(!QDltMetrics::isTimingEnabled())
+        labelStatus->setText("Durations are only measured while this dialog is open or the dump is active");
+}
+
+QTreeWidgetItem *DiagnosticsDialog::groupItem(const QString &name)
+{
+    for(int num = 0; num < tree->topLevelItemCount(); num++)
+    {
+        if(tree->topLevelItem(num)->text(0) == name)
+            return tree->topLevelItem(num);
+    }
+
+    QTreeWidgetItem *item = new QTreeWidgetItem(tree, QStringList() << name);
+    item->setExpanded(true);
+    return item;
+}
+
+void DiagnosticsDialog::setItem(QTreeWidgetItem *group, const QString &name, const QStringList &values)
+{
+    /* keep existing items, so the selection and scroll position stay while refreshing */
+    QTreeWidgetItem *item = 0;
+    for(int num = 0; num < group->childCount(); num++)
+    {
+        if(group->child(num)->text(0) == name)
+        {
+            item = group->child(num);
+            break;
+        }
+    }
+    if(!item)
+        item = new QTreeWidgetItem(group, QStringList() << name);
+
+    for(int column = 0; column < values.size(); column++)
+        item->setText(column + 1, values[column]);
+}
@@ -0,0 +1,49 @@
+#ifndef DIAGNOSTICSDIALOG_H
+#define DIAGNOSTICSDIALOG_H
+
+#include <QDialog>
+#include <QTimer>
+#include <QJsonObject>
+
+class QTreeWidget;
+class QTreeWidgetItem;
+class QLineEdit;
+class QSpinBox;
+class QLabel;
+
+/* Shows the performance metrics of QDltMetrics and dumps them periodically to a JSON file.
+ * The dialog is created once at startup, so the dump also runs while it is hidden.
+ * Durations are only measured while the dialog is visible or the dump is active. */
+class DiagnosticsDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit DiagnosticsDialog(QWidget *parent = 0);
+
+protected:
+    void showEvent(QShowEvent *event);
+    void hideEvent(QHideEvent *event);
+
+private slots:
+    void sample();
+    void browseDumpFile();
+    void dumpSettingsChanged();
+
+private:
+    void updateTree(const QJsonObject &snapshot);
+    void updateTimingEnabled();
+    QTreeWidgetItem *groupItem(const QString &name);
+    void setItem(QTreeWidgetItem *group, const QString &name, const QStringList &values);
+
+    QTreeWidget *tree;
+    QLineEdit *lineEditDumpFile;
+    QSpinBox *spinBoxDumpInterval;
+    QLabel *labelStatus;
+
+    QTimer timer;
+    int secondsSinceDump;
+    bool timingRequested;
+};
+
+#endif // DIAGNOSTICSDIALOG_H
@@ -4,7 +4,7 @@
 #include <QClipboard>
 
 #include "dltexporter.h"
-#include "fieldnames.h"
+#include "dltexporterthread.h"
 #include "project.h"
 #include "optmanager.h"
 
@@ -18,54 +18,32 @@ DltExporter::DltExporter(QObject *parent) :
     selection = NULL;
     exportFormat = FormatDlt;
     exportSelection = SelectionAll;
-}
-
-QString DltExporter::escapeCSVValue(QString arg)
-{
-    QString retval = arg.replace(QChar('\"'), QString("\"\""));
-    retval = QString("\"%1\"").arg(retval);
-    return retval;
+    silentMode = false;
+    nextSequence = 0;
+    nextWriteSequence = 0;
+    pipelineStop = false;
 }
 
 bool DltExporter::writeCSVHeader(QFile *file)
 {
-    QString header("\"%1\",\"%2\",\"%3\",\"%4\",\"%5\",\"%6\",\"%7\",\"%8\",\"%9\",\"%10\",\"%11\",\"%12\",\"%13\"\n");
-    header = header.arg(FieldNames::getName(FieldNames::Index))
-                    .arg(FieldNames::getName(FieldNames::Time))
-                    .arg(FieldNames::getName(FieldNames::TimeStamp))
-                    .arg(FieldNames::getName(FieldNames::Counter))
-                    .arg(FieldNames::getName(FieldNames::EcuId))
-                    .arg(FieldNames::getName(FieldNames::AppId))
-                    .arg(FieldNames::getName(FieldNames::ContextId))
-                    .arg(FieldNames::getName(FieldNames::SessionId))
-                    .arg(FieldNames::getName(FieldNames::Type))
-                    .arg(FieldNames::getName(FieldNames::Subtype))
-                    .arg(FieldNames::getName(FieldNames::Mode))
-                    .arg(FieldNames::getName(FieldNames::ArgCount))
-                    .arg(FieldNames::getName(FieldNames::Payload));
-    return file->write(header.toLatin1().constData()) < 0 ? false : true;
+    return file->write(QDltExportFormatter::csvHeader().toLatin1().constData()) < 0 ? false : true;
 }
 
-void DltExporter::writeCSVLine(int index, QFile *to, QDltMsg msg)
+QDltExportFormatter::Format DltExporter::formatterFormat() const
 {
-    QString text("");
-
-    text += escapeCSVValue(QString("%1").arg(index)).append(",");
-    text += escapeCSVValue(QString("%1.%2").arg(msg.getTimeString()).arg(msg.getMicroseconds(),6,10,QLatin1Char('0'))).append(",");
-    text += escapeCSVValue(QString("%1.%2").arg(msg.getTimestamp()/10000).arg(msg.getTimestamp()%10000,4,10,QLatin1Char('0'))).append(",");
-    text += escapeCSVValue(QString("%1").arg(msg.getMessageCounter())).append(",");
-    text += escapeCSVValue(QString("%1").arg(msg.getEcuid())).append(",");
-    text += escapeCSVValue(QString("%1").arg(msg.getApid())).append(",");
-    text += escapeCSVValue(QString("%1").arg(msg.getCtid())).append(",");
-    text += escapeCSVValue(QString("%1").arg(msg.getSessionid())).append(",");
-    text += escapeCSVValue(QString("%1").arg(msg.getTypeString())).append(",");
-    text += escapeCSVValue(QString("%1").arg(msg.getSubtypeString())).append(",");
-    text += escapeCSVValue(QString("%1").arg(msg.getModeString())).append(",");
-    text += escapeCSVValue(QString("%1").arg(msg.getNumberOfArguments())).append(",");
-    text += escapeCSVValue(msg.toStringPayload().simplified());
-    text += "\n";
-
-    to->write(text.toLatin1().constData());
+    switch(exportFormat)
+    {
+    case DltExporter::FormatDlt:
+        return QDltExportFormatter::FormatDlt;
+    case DltExporter::FormatCsv:
+        return QDltExportFormatter::FormatCsv;
+    case DltExporter::FormatDltDecoded:
+        return QDltExportFormatter::FormatDltDecoded;
+    case DltExporter::FormatUTF8:
+        return QDltExportFormatter::FormatUTF8;
+    default:
+        return QDltExportFormatter::FormatAscii;
+    }
 }
 
 bool DltExporter::start()
@@ -197,56 +175,263 @@ bool DltExporter::getMsg(int num,QDltMsg &msg,QByteArray &buf)
     return msg.setMsg(buf);
 }
 
+int DltExporter::getMsgIndex(int num)
+{
+    if(exportSelection == DltExporter::SelectionAll)
+        return num;
+    else if(exportSelection == DltExporter::SelectionFiltered)
+        return from->getMsgFilterPos(num);
+    else if(exportSelection == DltExporter::SelectionSelected)
+        return from->getMsgFilterPos(selectedRows[num]);
+    else
+        return -1;
+}
+
 bool DltExporter::exportMsg(int num, QDltMsg &msg, QByteArray &buf)
 {
-    if((exportFormat == DltExporter::FormatDlt)||(exportFormat == DltExporter::FormatDltDecoded))
+    int index = getMsgIndex(num);
+
+    if(exportSelection != DltExporter::SelectionAll &&
+       exportSelection != DltExporter::SelectionFiltered &&
+       exportSelection != DltExporter::SelectionSelected)
+        return false;
+
+    QDltExportFormatter formatter(formatterFormat());
+
+    if(exportFormat == DltExporter::FormatClipboard)
     {
-        to->write(buf);
+        formatter.textLine(index,msg,clipboardString);
     }
-    else if(exportFormat == DltExporter::FormatAscii || exportFormat == DltExporter::FormatUTF8 || exportFormat == DltExporter::FormatClipboard)
+    else
     {
-        QString text;
-
-        /* get message ASCII text */
-        if(exportSelection == DltExporter::SelectionAll)
-            text += QString("%1 ").arg(num);
-        else if(exportSelection == DltExporter::SelectionFiltered)
-            text += QString("%1 ").arg(from->getMsgFilterPos(num));
-        else if(exportSelection == DltExporter::SelectionSelected)
-            text += QString("%1 ").arg(from->getMsgFilterPos(selectedRows[num]));
-        else
-            return false;
-        text += msg.toStringHeader();
-        text += " ";
-        text += msg.toStringPayload().simplified();
-        text += "\n";
-        try
-         {
-            if(exportFormat == DltExporter::FormatAscii)
-                /* write to file */
-                to->write(text.toLatin1().constData());
-            else if (exportFormat == DltExporter::FormatUTF8)
-                to->write(text.toUtf8().constData());
-            else if(exportFormat == DltExporter::FormatClipboard)
-                clipboardString += text;
-         }
-        catch (...)
-         {
-         }
+        QByteArray output;
+        formatter.formatMsg(index,msg,buf,output);
+        to->write(output);
     }
-    else if(exportFormat == DltExporter::FormatCsv)
+
+    return true;
+}
+
+DltExporterBatch *DltExporter::takeBatch()
+{
+    QMutexLocker locker(&pipelineMutex);
+
+    while(pendingBatches.isEmpty() && !pipelineStop)
+        batchQueued.wait(&pipelineMutex);
+
+    if(pendingBatches.isEmpty())
+        return NULL;
+
+    return pendingBatches.dequeue();
+}
+
+void DltExporter::renderBatch(DltExporterBatch &batch)
+{
+    const QDltDecodedMsgCache &cache = pluginManager->getDecodedMsgCache();
+    QDltExportFormatter formatter(formatterFormat());
+
+    for(int num=0;num<batch.msgs.size();num++)
     {
-        if(exportSelection == DltExporter::SelectionAll)
-            writeCSVLine(num, to, msg);
-        else if(exportSelection == DltExporter::SelectionFiltered)
-            writeCSVLine(from->getMsgFilterPos(num), to, msg);
-        else if(exportSelection == DltExporter::SelectionSelected)
-            writeCSVLine(from->getMsgFilterPos(selectedRows[num]), to, msg);
-        else
-            return false;
+        QDltMsg &msg = batch.msgs[num];
+
+        /* messages not covered by the cache were already decoded by the reader */
+        if(exportFormat != DltExporter::FormatDlt)
+            cache.lookup(batch.indexes[num],msg);
+
+        formatter.formatMsg(batch.indexes[num],msg,batch.bufs[num],batch.output);
     }
 
-    return true;
+    /* free the messages early, only the output is needed by the writer */
+    batch.msgs.clear();
+    batch.bufs.clear();
+}
+
+void DltExporter::completeBatch(DltExporterBatch *batch)
+{
+    QMutexLocker locker(&pipelineMutex);
+
+    completedBatches.insert(batch->sequence,batch);
+    batchCompleted.wakeAll();
+}
+
+void DltExporter::writeBatches(int maxPending, int &exportCounter)
+{
+    QMutexLocker locker(&pipelineMutex);
+
+    while(nextWriteSequence < nextSequence)
+    {
+        if(!completedBatches.contains(nextWriteSequence))
+        {
+            if(nextSequence - nextWriteSequence <= maxPending)
+                break;
+            batchCompleted.wait(&pipelineMutex);
+            continue;
+        }
+
+        DltExporterBatch *batch = completedBatches.take(nextWriteSequence++);
+
+        /* write without holding the lock, so the workers can continue */
+        locker.unlock();
+        to->write(batch->output);
+        exportCounter += batch->indexes.size();
+        delete batch;
+        locker.relock();
+    }
+}
+
+void DltExporter::exportPipeline(QProgressDialog &fileprogress, int &readErrors, int &exportCounter)
+{
+    QList<DltExporterThread*> threads;
+    int threadCount = qBound(1,QThread::idealThreadCount(),DLT_EXPORTER_MAX_THREADS);
+    int maxPending = threadCount * 4;
+    const QDltDecodedMsgCache &cache = pluginManager->getDecodedMsgCache();
+    DltExporterBatch *batch = NULL;
+
+    nextSequence = 0;
+    nextWriteSequence = 0;
+    pipelineStop = false;
+
+    for(int num=0;num<threadCount;num++)
+    {
+        DltExporterThread *thread = new DltExporterThread(this);
+        threads.append(thread);
+        thread->start();
+    }
+
+    for(int num = 0;num<size;num++)
+    {
+        // Update progress dialog every 1000 lines
+        if( 0 == (num%1000))
+        {
+          if (silentMode == true)
+             {
+              fileprogress.setValue(num);
+             }
+        }
+
+        if(batch == NULL)
+        {
+            batch = new DltExporterBatch();
+            batch->indexes.reserve(DLT_EXPORTER_BATCH_SIZE);
+            batch->msgs.reserve(DLT_EXPORTER_BATCH_SIZE);
+            batch->bufs.reserve(DLT_EXPORTER_BATCH_SIZE);
+        }
+
+        // get message
+        QDltMsg msg;
+        QByteArray buf;
+        if(false == getMsg(num,msg,buf))
+        {
+            qDebug() << "DLT Export getMsg failed on msg index" << num;
+            readErrors++;
+            continue;
+        }
+
+        // decoder plugins are not thread safe, only messages covered by the cache are decoded by the workers
+        int index = getMsgIndex(num);
+        if(exportFormat != DltExporter::FormatDlt && (!cache.isComplete() || index < 0 || index >= cache.size()))
+            pluginManager->decodeMsgCached(msg,index,silentMode);
+
+        batch->indexes.append(index);
+        batch->msgs.append(msg);
+        batch->bufs.append(buf);
+
+        if(batch->indexes.size() >= DLT_EXPORTER_BATCH_SIZE || num == size-1)
+        {
+            pipelineMutex.lock();
+            batch->sequence = nextSequence++;
+            pendingBatches.enqueue(batch);
+            batchQueued.wakeOne();
+            pipelineMutex.unlock();
+            batch = NULL;
+
+            writeBatches(maxPending,exportCounter);
+        }
+    }
+
+    /* last messages could not be read */
+    if(batch != NULL)
+    {
+        pipelineMutex.lock();
+        batch->sequence = nextSequence++;
+        pendingBatches.enqueue(batch);
+        batchQueued.wakeOne();
+        pipelineMutex.unlock();
+    }
+
+    writeBatches(0,exportCounter);
+
+    /* stop the workers */
+    pipelineMutex.lock();
+    pipelineStop = true;
+    batchQueued.wakeAll();
+    pipelineMutex.unlock();
+
+    foreach(DltExporterThread *thread, threads)
+    {
+        thread->wait();
+        delete thread;
+    }
+}
+
+void DltExporter::writeRange(int file, qint64 pos, qint64 length, int count, int &readErrors, int &exportCounter)
+{
+    if(count == 0)
+        return;
+
+    if(from->copyRange(file,pos,length,*to))
+        exportCounter += count;
+    else
+    {
+        qDebug() << "DLT Export copyRange failed on file" << file << "position" << pos;
+        readErrors += count;
+    }
+}
+
+void DltExporter::exportRanges(QProgressDialog &fileprogress, int &readErrors, int &exportCounter)
+{
+    int rangeFile = -1;
+    qint64 rangePos = 0;
+    qint64 rangeLength = 0;
+    int rangeCount = 0;
+
+    for(int num = 0;num<size;num++)
+    {
+        // Update progress dialog every 1000 lines
+        if( 0 == (num%1000))
+        {
+          if (silentMode == true)
+             {
+              fileprogress.setValue(num);
+             }
+        }
+
+        int file;
+        qint64 pos;
+        qint64 length;
+        if(false == from->getMsgRange(getMsgIndex(num),file,pos,length))
+        {
+            qDebug() << "DLT Export getMsgRange failed on msg index" << num;
+            readErrors++;
+            continue;
+        }
+
+        // extend the current range, if the message follows directly in the same file
+        if(file == rangeFile && pos == rangePos + rangeLength && rangeLength + length <= DLT_EXPORTER_MAX_RANGE)
+        {
+            rangeLength += length;
+            rangeCount++;
+            continue;
+        }
+
+        writeRange(rangeFile,rangePos,rangeLength,rangeCount,readErrors,exportCounter);
+        rangeFile = file;
+        rangePos = pos;
+        rangeLength = length;
+        rangeCount = 1;
+    }
+
+    writeRange(rangeFile,rangePos,rangeLength,rangeCount,readErrors,exportCounter);
 }
 
 void DltExporter::exportMessages(QDltFile *from, QFile *to, QDltPluginManager *pluginManager,
@@ -279,7 +464,7 @@ void DltExporter::exportMessages(QDltFile *from, QFile *to, QDltPluginManager *p
     }
 
 
-    bool silentMode = !OptManager::getInstance()->issilentMode();
+    silentMode = !OptManager::getInstance()->issilentMode();
 
     qDebug() << "Start DLT export of" << size << "messages" << "silent mode" << !silentMode;
 
@@ -293,49 +478,52 @@ void DltExporter::exportMessages(QDltFile *from, QFile *to, QDltPluginManager *p
       fileprogress.show();
      }
 
-    for(int num = 0;num<size;num++)
+    if(exportFormat == DltExporter::FormatClipboard)
     {
-        // Update progress dialog every 1000 lines
-        if( 0 == (num%1000))
+        for(int num = 0;num<size;num++)
         {
-          if (silentMode == true)
-             {
-              fileprogress.setValue(num);
-             }
-        }
+            // Update progress dialog every 1000 lines
+            if( 0 == (num%1000))
+            {
+              if (silentMode == true)
+                 {
+                  fileprogress.setValue(num);
+                 }
+            }
 
-        // get message
-        if(false == getMsg(num,msg,buf))
-        {
-	    //  finish();
-        qDebug() << "DLT Export getMsg failed on msg index" << num;
-	    readErrors++;
-	    continue;
-	    //  return;
-        }
+            // get message
+            if(false == getMsg(num,msg,buf))
+            {
+                qDebug() << "DLT Export getMsg failed on msg index" << num;
+                readErrors++;
+                continue;
+            }
 
-        // decode message if needed
-        if(exportFormat != DltExporter::FormatDlt)
-        {
-            pluginManager->decodeMsg(msg,silentMode);
-            if (exportFormat == DltExporter::FormatDltDecoded)
+            // decode message
+            pluginManager->decodeMsgCached(msg,getMsgIndex(num),silentMode);
+
+            // export message
+            if(!exportMsg(num,msg,buf))
             {
-                msg.setNumberOfArguments(msg.sizeArguments());
-                msg.getMsg(buf,true);
+                qDebug() << "DLT Export exportMsg() failed";
+                exportErrors++;
+                continue;
             }
+            else
+                exportCounter++;
         }
+    }
+    else if(exportFormat == DltExporter::FormatDlt)
+    {
+        /* no decoding needed, copy the messages as byte ranges */
+        exportRanges(fileprogress,readErrors,exportCounter);
+    }
+    else
+    {
+        /* decode, format and write in parallel, the output is the same as with the sequential export */
+        exportPipeline(fileprogress,readErrors,exportCounter);
+    }
 
-        // export message
-        if(!exportMsg(num,msg,buf))
-        {
-            // finish();
-          qDebug() << "DLT Export exportMsg() failed";
-          exportErrors++;
-          continue;
-        }
-     else
-	    exportCounter++;
-    } // for loop
     if (silentMode == true)
      fileprogress.close();
 
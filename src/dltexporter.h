@@ -5,9 +5,25 @@
 #include <QFile>
 #include <QModelIndexList>
 #include <QTreeWidget>
+#include <QProgressDialog>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QMap>
 
 #include "qdlt.h"
 
+//! Number of messages decoded and formatted together by one export worker thread.
+#define DLT_EXPORTER_BATCH_SIZE 1000
+
+//! Maximum number of export worker threads.
+#define DLT_EXPORTER_MAX_THREADS 8
+
+//! Maximum size of adjacent messages copied together in the DLT export.
+#define DLT_EXPORTER_MAX_RANGE (64*1024*1024)
+
+class DltExporterBatch;
+
 class DltExporter : public QObject
 {
     Q_OBJECT
@@ -20,31 +36,47 @@ public:
 
 private:
 
-    /* Add double quotes to a value.
-     * Also escape any exiting double quotes with another double quote.
-     * \param arg string to escape
-     * \return QString which is escaped version of arg
-     */
-    QString escapeCSVValue(QString arg);
-
     /* Write the first line of CSV. This is just the names of the fields
      * \param file outputfile to write to
      * \return True if writing was succesfull, false if error occured
      */
     bool writeCSVHeader(QFile *file);
 
-    /* Write the message out to an open file
-     * \param index True index to QDltFile of the message
-     * \param to File to write to
-     * \param msg msg to get the data from
-     */
-    void writeCSVLine(int index, QFile *to, QDltMsg msg);
+    /* Get the format of the shared message formatter for the export format */
+    QDltExportFormatter::Format formatterFormat() const;
 
     bool start();
     bool finish();
     bool getMsg(int num, QDltMsg &msg, QByteArray &buf);
+    int getMsgIndex(int num);
     bool exportMsg(int num, QDltMsg &msg,QByteArray &buf);
 
+    /* Export all messages to the file with a parallel pipeline.
+     * Messages are read in batches by the calling thread, decoded and formatted
+     * by the worker threads and written in the original order by the calling thread.
+     */
+    void exportPipeline(QProgressDialog &fileprogress, int &readErrors, int &exportCounter);
+
+    /* Export all messages in DLT format without decoding.
+     * Messages following each other in the log file are copied together as one byte range.
+     */
+    void exportRanges(QProgressDialog &fileprogress, int &readErrors, int &exportCounter);
+
+    /* Copy a byte range of count messages from the log file to the export file */
+    void writeRange(int file, qint64 pos, qint64 length, int count, int &readErrors, int &exportCounter);
+
+    /* Write completed batches in order to the export file.
+     * \param maxPending Wait until not more than this number of batches is pending
+     * \param exportCounter Incremented by the number of written messages
+     */
+    void writeBatches(int maxPending, int &exportCounter);
+
+    /* Functions called by the DltExporterThread */
+    friend class DltExporterThread;
+    DltExporterBatch *takeBatch();
+    void renderBatch(DltExporterBatch &batch);
+    void completeBatch(DltExporterBatch *batch);
+
 public:
 
     /* Default QT constructor.
@@ -78,6 +110,17 @@ private:
     QList<int> selectedRows;
     DltExporter::DltExportFormat exportFormat;
     DltExporter::DltExportSelection exportSelection;
+    bool silentMode;
+
+    /* state of the export pipeline */
+    QMutex pipelineMutex;
+    QWaitCondition batchQueued;
+    QWaitCondition batchCompleted;
+    QQueue<DltExporterBatch*> pendingBatches;
+    QMap<int,DltExporterBatch*> completedBatches;
+    int nextSequence;
+    int nextWriteSequence;
+    bool pipelineStop;
 };
 
 #endif // DLTEXPORTER_H
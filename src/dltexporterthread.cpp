@@ -0,0 +1,23 @@
+#include "dltexporterthread.h"
+#include "dltexporter.h"
+
+DltExporterThread::DltExporterThread(DltExporter *exporter)
+    :exporter(exporter)
+{
+
+}
+
+DltExporterThread::~DltExporterThread()
+{
+
+}
+
+void DltExporterThread::run()
+{
+    DltExporterBatch *batch;
+    while((batch = exporter->takeBatch()) != NULL)
+    {
+        exporter->renderBatch(*batch);
+        exporter->completeBatch(batch);
+    }
+}
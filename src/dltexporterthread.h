@@ -0,0 +1,44 @@
+#ifndef DLTEXPORTERTHREAD_H
+#define DLTEXPORTERTHREAD_H
+
+#include <QThread>
+#include <QVector>
+#include <QByteArray>
+
+#include "qdlt.h"
+
+class DltExporter;
+
+//! A range of consecutive messages which is decoded and formatted by one DltExporterThread.
+class DltExporterBatch
+{
+public:
+    //! Position of the batch in the export, batches are written in this order.
+    int sequence;
+
+    //! Index of each message in the DLT file.
+    QVector<int> indexes;
+
+    QVector<QDltMsg> msgs;
+    QVector<QByteArray> bufs;
+
+    //! The formatted messages, written with a single write to the export file.
+    QByteArray output;
+};
+
+//! Worker thread of the DltExporter, decodes and formats batches of messages.
+class DltExporterThread : public QThread
+{
+    Q_OBJECT
+public:
+    DltExporterThread(DltExporter *exporter);
+    ~DltExporterThread();
+
+protected:
+    void run();
+
+private:
+    DltExporter *exporter;
+};
+
+#endif // DLTEXPORTERTHREAD_H
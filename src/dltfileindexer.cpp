@@ -2,6 +2,7 @@
 #include "optmanager.h"
 #include "dltfileindexerthread.h"
 #include "dltfileindexerdefaultfilterthread.h"
+#include "qdltmetrics.h"
 
 #include <QDebug>
 #include <QMessageBox>
@@ -9,6 +10,8 @@
 #include <QTime>
 #include <QCryptographicHash>
 #include <QMutexLocker>
+#include <QDir>
+#include <QCoreApplication>
 
 
 extern "C" {
@@ -28,6 +31,7 @@ DltFileIndexer::DltFileIndexer(QObject *parent) :
     mode = modeIndexAndFilter;
     this->dltFile = NULL;
     this->pluginManager = NULL;
+    viewerWorkers = NULL;
     defaultFilter = NULL;
     stopFlag = 0;
 
@@ -50,6 +54,7 @@ DltFileIndexer::DltFileIndexer(QDltFile *dltFile, QDltPluginManager *pluginManag
     this->dltFile = dltFile;
     this->pluginManager = pluginManager;
     this->defaultFilter = defaultFilter;
+    viewerWorkers = NULL;
     stopFlag = 0;
 
     pluginsEnabled = true;
@@ -71,22 +76,25 @@ DltFileIndexer::~DltFileIndexer()
 bool DltFileIndexer::index(int num)
 {
     QTime time;
+    QString filename = dltFile->getFileName(num);
+    bool compressed = dltFile->isCompressed(num);
 
     // start performance counter
     time.start();
 
-    // load filter index if enabled
-    if(!filterCache.isEmpty() && loadIndexCache(dltFile->getFileName(num)))
+    // load index of compressed file if enabled, it needs the seek index too
+    if(compressed && !filterCache.isEmpty() && loadIndexCache(filename) && loadSeekIndexCache(num))
     {
         // loading index from filter is succesful
-        //qDebug() << "Loaded index cache for file" << dltFile->getFileName(num);
+        //qDebug() << "Loaded index cache for file" << filename;
         msecsIndexCounter = time.elapsed();
+        QDltMetrics::instance()->counter("indexcache.hit")->add();
         return true;
     }
 
     // prepare indexing
     //dltFile->clearIndex();
-    QFile f(dltFile->getFileName(num));
+    QFile f(filename);
 
     // open file
     if(!f.open(QIODevice::ReadOnly))
@@ -103,13 +111,50 @@ bool DltFileIndexer::index(int num)
         return true;
     }
 
+    /* reuse the valid part of the index cache of an uncompressed file,
+     * only data appended since the cache was written must be scanned */
+    int cachedEntries = 0;
+    int loadedEntries = 0;
+    qint64 startPos = 0;
+    if(!compressed && !filterCache.isEmpty() && loadIndexCache(filename))
+    {
+        loadedEntries = indexAllList.size();
+        cachedEntries = validIndexPrefix(f,indexAllList);
+        indexAllList.resize(cachedEntries);
+        if(cachedEntries > 0)
+            startPos = indexAllList.last() + 4;
+    }
+    else
+    {
+        indexAllList.clear();
+    }
+    if(!filterCache.isEmpty())
+        QDltMetrics::instance()->counter(cachedEntries > 0 ? "indexcache.hit" : "indexcache.miss")->add();
+
+    // read compressed files through a decompressor, which creates the seek index on the way
+    QDltCompressedFile *compressedFile = 0;
+    QIODevice *device = &f;
+    if(compressed)
+    {
+        compressedFile = new QDltCompressedFile(&f);
+        if(!compressedFile->open(QIODevice::ReadOnly))
+        {
+            qWarning() << "Cannot open compressed file in DltFileIndexer " << f.fileName();
+            delete compressedFile;
+            f.close();
+            return false;
+        }
+        device = compressedFile;
+    }
+    else
+    {
+        device->seek(startPos);
+    }
+
     // Initialise progress bar
     emit(progressText(QString("Indexer %1/%2").arg(currentRun).arg(maxRun)));
     emit(progressMax(f.size()));
 
-    // clear old index
-    indexAllList.clear();
-
     // Go through the segments and create new index
     char lastFound = 0;
     qint64 length;
@@ -118,8 +163,8 @@ bool DltFileIndexer::index(int num)
     do
     {
 
-        pos = f.pos();
-        length = f.read(data,DLT_FILE_INDEXER_SEG_SIZE);
+        pos = device->pos();
+        length = device->read(data,DLT_FILE_INDEXER_SEG_SIZE);
         for(int num=0;num < length;num++)
         {
             if(data[num] == 'D')
@@ -148,30 +193,50 @@ bool DltFileIndexer::index(int num)
             if(stopFlag)
             {
                 delete[] data;
+                delete compressedFile;
                 f.close();
                 return false;
             }
         }
-        emit(progress(pos));
+        // progress is counted in bytes of the file on disk
+        emit(progress(compressedFile ? f.pos() : pos));
     }
     while(length>0);
 
     // delete buffer
     delete[] data;
 
+    // hand over the seek index created while reading the compressed file
+    if(compressedFile)
+    {
+        dltFile->setSeekIndex(num,compressedFile->getSeekIndex());
+        if(false == filterCache.isEmpty())
+            compressedFile->getSeekIndex().save(filterCache + "/" + filenameSeekIndexCache(dltFile->getFileName(num)),f.size());
+        delete compressedFile;
+    }
+
     // close file
     f.close();
 
-    qDebug() << "Created index for file" << dltFile->getFileName(num);
+    qDebug() << "Created index for file" << filename << "reused cached entries" << cachedEntries;
 
     // update performance counter
     msecsIndexCounter = time.elapsed();
+    QDltMetrics::instance()->gauge("indexer.indexMs")->set(msecsIndexCounter);
 
-    // write index if enabled
+    // write index if enabled, a complete valid cache only gets the new entries appended
     if(false == filterCache.isEmpty())
     {
-        saveIndexCache(dltFile->getFileName(num));
-        qDebug() << "Saved index cache for file" << dltFile->getFileName(num) << filterCache;
+        if(cachedEntries > 0 && cachedEntries == loadedEntries)
+        {
+            if(indexAllList.size() > cachedEntries)
+                appendIndexCache(filename,cachedEntries);
+        }
+        else
+        {
+            saveIndexCache(filename);
+        }
+        qDebug() << "Saved index cache for file" << filename << filterCache;
     }
 
     return true;
@@ -189,14 +254,38 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
     // get filter list
     filterList = dltFile->getFilterList();
 
+    // reuse the decoded messages of the same files and decoder plugin configuration
+    QDltDecodedMsgCache &decodedMsgCache = pluginManager->getDecodedMsgCache();
+    QString filenameDecoded = filenameDecodedMsgCache(filenames);
+    bool recordDecodedMsgCache = false;
+    if(!pluginsEnabled || activeDecoderPlugins.isEmpty())
+    {
+        decodedMsgCache.clear();
+    }
+    else if(decodedMsgCache.isOutdated() && decodedMsgCache.getFileName() == filenameDecoded)
+    {
+        // a decoder plugin changed its configuration since the cache file was written
+        recordDecodedMsgCache = true;
+    }
+    else if(!decodedMsgCache.isComplete() || decodedMsgCache.getFileName() != filenameDecoded || decodedMsgCache.size() != dltFile->size())
+    {
+        if(decodedMsgCache.load(filenameDecoded, dltFile->size()))
+            qDebug() << "Loaded decoded message cache" << filenameDecoded;
+        else
+            recordDecodedMsgCache = true;
+    }
+
     // load filter index, if enabled and not an initial loading of file
     if(!filterCache.isEmpty() && mode != modeIndexAndFilter && loadFilterIndexCache(filterList,indexFilterList,filenames))
     {
         // loading filter index from filter is succesful
         qDebug() << "Loaded filter index cache for files" << filenames;
         msecsFilterCounter = time.elapsed();
+        QDltMetrics::instance()->counter("filtercache.hit")->add();
         return true;
     }
+    if(!filterCache.isEmpty() && mode != modeIndexAndFilter)
+        QDltMetrics::instance()->counter("filtercache.miss")->add();
 
     // Initialise progress bar
     emit(progressText(QString("%1/%2").arg(currentRun).arg(maxRun)));
@@ -215,6 +304,10 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
 
     bool useIndexerThread = hasPlugins || hasFilters;
 
+    // decoded messages are stored in the cache by the plugin manager
+    if(recordDecodedMsgCache)
+        decodedMsgCache.create(filenameDecoded, dltFile->size(), filterCache.isEmpty());
+
     DltFileIndexerThread indexerThread
             (
                 this,
@@ -224,6 +317,7 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
                 &indexFilterListSorted,
                 pluginManager,
                 &activeViewerPlugins,
+                viewerWorkers,
                 silentMode
             );
 
@@ -258,6 +352,10 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
                 indexerThread.wait();
             }
 
+            // incomplete cache is discarded
+            if(recordDecodedMsgCache)
+                decodedMsgCache.clear();
+
             return false;
         }
     }
@@ -268,11 +366,20 @@ bool DltFileIndexer::indexFilter(QStringList filenames)
         indexerThread.requestStop();
         indexerThread.wait();
     }
+    else
+    {
+        indexerThread.processBatch();
+    }
+
+    // decoded messages are available for table, search and export
+    if(recordDecodedMsgCache)
+        decodedMsgCache.finish();
 
     //qDebug() << "Created filter index for files" << filenames;
 
     // update performance counter
     msecsFilterCounter = time.elapsed();
+    QDltMetrics::instance()->gauge("indexer.filterMs")->set(msecsFilterCounter);
 
     // use sorted values if sort by time enabled
     if(sortByTimeEnabled)
@@ -377,6 +484,7 @@ bool DltFileIndexer::indexDefaultFilter()
 
     // update performance counter
     msecsDefaultFilterCounter = time.elapsed();
+    QDltMetrics::instance()->gauge("indexer.defaultFilterMs")->set(msecsDefaultFilterCounter);
 
     return true;
 }
@@ -541,6 +649,27 @@ bool DltFileIndexer::saveIndexCache(QString filename)
     return true;
 }
 
+bool DltFileIndexer::appendIndexCache(QString filename, int from)
+{
+    QString filenameCache;
+
+    // check if caching is enabled
+    if(filterCache.isEmpty())
+        return false;
+
+    // get the filename for the cache file
+    filenameCache = filenameIndexCache(filename);
+
+    // append to the cache file
+    if(!appendIndex(filterCache + "/" +filenameCache,indexAllList,from))
+    {
+        // saving cache file failed
+        return false;
+    }
+
+    return true;
+}
+
 QString DltFileIndexer::filenameIndexCache(QString filename)
 {
     QString hashString;
@@ -549,8 +678,9 @@ QString DltFileIndexer::filenameIndexCache(QString filename)
     QString filenameCache;
 
     // create string to be hashed
-    hashString = QFileInfo(filename).fileName();
-    hashString += "_" + QString("%1").arg(dltFile->fileSize());
+    hashString = QFileInfo(filename).absoluteFilePath();
+    if(QDltCompressedFile::isCompressedFile(filename))
+        hashString += "_" + QString("%1").arg(QFileInfo(filename).size());
 
     // create byte array from hash string
     hashByteArray = hashString.toLatin1();
@@ -566,6 +696,34 @@ QString DltFileIndexer::filenameIndexCache(QString filename)
     return filenameCache;
 }
 
+bool DltFileIndexer::loadSeekIndexCache(int num)
+{
+    QDltSeekIndex seekIndex;
+    QString filename = dltFile->getFileName(num);
+
+    // check if caching is enabled
+    if(filterCache.isEmpty())
+        return false;
+
+    // load the seek index, it is only valid for the same size of the compressed file
+    if(!seekIndex.load(filterCache + "/" + filenameSeekIndexCache(filename),QFileInfo(filename).size()) ||
+       seekIndex.uncompressedSize < 0)
+    {
+        // loading cache file failed
+        return false;
+    }
+
+    dltFile->setSeekIndex(num,seekIndex);
+
+    return true;
+}
+
+QString DltFileIndexer::filenameSeekIndexCache(QString filename)
+{
+    // use the same hash as the index cache, so both cache files belong together
+    return QFileInfo(filenameIndexCache(filename)).completeBaseName() + ".six";
+}
+
 // read/write index cache
 bool DltFileIndexer::loadFilterIndexCache(QDltFilterList &filterList, QVector<qint64> &index, QStringList filenames)
 {
@@ -676,6 +834,25 @@ QString DltFileIndexer::filenameFilterIndexCache(QDltFilterList &filterList,QStr
     return filename;
 }
 
+QString DltFileIndexer::filenameDecodedMsgCache(QStringList filenames)
+{
+    QString hashString;
+    QByteArray md5;
+
+    // identify files by name and size, decoder plugins by name, version and configuration
+    hashString = filenames.join(QString("_"));
+    hashString += "_" + QString("%1").arg(dltFile->fileSize());
+    md5 = QCryptographicHash::hash(hashString.toLatin1(), QCryptographicHash::Md5);
+
+    QString filename = QString(md5.toHex()) + "_" + QString(md5ActiveDecoderPlugins().toHex()) + ".ddc";
+
+    // without filter cache the decoded messages are only kept while the file is opened
+    if(filterCache.isEmpty())
+        return QDir::tempPath() + "/dlt-viewer-" + QString::number(QCoreApplication::applicationPid()) + "_" + filename;
+
+    return filterCache + "/" + filename;
+}
+
 bool DltFileIndexer::saveIndex(QString filename, const QVector<qint64> &index)
 {
     quint32 version = DLT_FILE_INDEXER_FILE_VERSION;
@@ -706,6 +883,90 @@ bool DltFileIndexer::saveIndex(QString filename, const QVector<qint64> &index)
     return true;
 }
 
+bool DltFileIndexer::appendIndex(QString filename, const QVector<qint64> &index, int from)
+{
+    qint64 value;
+
+    QFile file(filename);
+
+    // open cache file
+    if(!file.open(QFile::ReadWrite))
+    {
+        // open file failed
+        return false;
+    }
+
+    // cut a partial entry after the loaded entries, so the new entries stay aligned
+    if(!file.resize(sizeof(quint32) + (qint64)from * sizeof(value)) || !file.seek(file.size()))
+    {
+        file.close();
+        return false;
+    }
+
+    // write new part of index
+    for(int num=from;num<index.size();num++)
+    {
+        value = index[num];
+        file.write((char*)&value,sizeof(value));
+    }
+
+    // close cache file
+    file.close();
+
+    return true;
+}
+
+static bool isMessageStart(QFile &file, qint64 pos)
+{
+    char pattern[4];
+
+    return file.seek(pos) && file.read(pattern,sizeof(pattern)) == sizeof(pattern) &&
+           pattern[0] == 'D' && pattern[1] == 'L' && pattern[2] == 'T' && pattern[3] == 0x01;
+}
+
+int DltFileIndexer::validIndexPrefix(QFile &file, const QVector<qint64> &index)
+{
+    qint64 size = file.size();
+    int valid = 0;
+
+    // entries must be increasing and inside the file
+    while(valid < index.size() && index[valid] >= 0 && index[valid] + 4 <= size &&
+          (valid == 0 || index[valid] > index[valid-1]))
+    {
+        valid++;
+    }
+
+    // check a sample of the entries, the prefix ends before the first entry not pointing to a message
+    int step = qMax(1, valid / DLT_FILE_INDEXER_CACHE_SAMPLES);
+    int lastChecked = -1;
+    for(int num=0;num<valid;num+=step)
+    {
+        if(!isMessageStart(file,index[num]))
+            return lastChecked + 1;
+        lastChecked = num;
+    }
+    if(lastChecked < valid - 1 && !isMessageStart(file,index[valid-1]))
+        return lastChecked + 1;
+
+    return valid;
+}
+
+qint64 DltFileIndexer::messageEnd(QFile &file, qint64 pos)
+{
+    DltStorageHeader storageHeader;
+    DltStandardHeader standardHeader;
+
+    if(!file.seek(pos) ||
+       file.read((char*)&storageHeader,sizeof(storageHeader)) != sizeof(storageHeader) ||
+       file.read((char*)&standardHeader,sizeof(standardHeader)) != sizeof(standardHeader) ||
+       dlt_check_storageheader(&storageHeader) != 1)
+    {
+        return -1;
+    }
+
+    return pos + sizeof(storageHeader) + DLT_BETOH_16(standardHeader.len);
+}
+
 bool DltFileIndexer::loadIndex(QString filename, QVector<qint64> &index)
 {
     quint32 version;
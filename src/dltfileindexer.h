@@ -7,12 +7,17 @@
 #include <QMainWindow>
 #include <QPair>
 #include <QMutex>
+#include <QFile>
 
 #include "qdlt.h"
+#include "dltviewerpluginworker.h"
 
 #define DLT_FILE_INDEXER_SEG_SIZE (1024*1024)
 #define DLT_FILE_INDEXER_FILE_VERSION 2
 
+// number of index cache entries checked against the log file before the cache is reused
+#define DLT_FILE_INDEXER_CACHE_SAMPLES 64
+
 class DltFileIndexerKey
 {
 public:
@@ -64,10 +69,31 @@ public:
     // load/save index from/to file
     bool loadIndexCache(QString filename);
     bool saveIndexCache(QString filename);
-    QString filenameIndexCache(QString filename);
+    bool appendIndexCache(QString filename, int from);
+
+    /* The cache of an uncompressed file is identified by the file path only,
+     * so it is found again after data was appended to the file.
+     * The cache of a compressed file is only valid for the same file size. */
+    static QString filenameIndexCache(QString filename);
+
+    /* Number of entries at the start of an index, which still point to messages in the log file.
+     * The entries must be increasing, a sample of them is compared with the log file. */
+    static int validIndexPrefix(QFile &file, const QVector<qint64> &index);
+
+    // position behind the message at pos in the log file, -1 if there is no message
+    static qint64 messageEnd(QFile &file, qint64 pos);
+
+    // file name of the cache of decoded messages
+    QString filenameDecodedMsgCache(QStringList filenames);
+
+    // load seek index of compressed file from file
+    bool loadSeekIndexCache(int num);
+    QString filenameSeekIndexCache(QString filename);
 
     // load/save index from/to file
     bool saveIndex(QString filename, const QVector<qint64> &index);
+    // the file is cut after the version and the first from entries before the new entries are appended
+    bool appendIndex(QString filename, const QVector<qint64> &index, int from);
     bool loadIndex(QString filename, QVector<qint64> &index);
 
     // Accessors to mutex
@@ -95,6 +121,10 @@ public:
     void setMultithreaded(bool enable) { multithreaded = enable; }
     bool getMultithreaded() { return multithreaded; }
 
+    // viewer plugins running in their own worker threads
+    void setViewerWorkers(DltViewerPluginWorkers *workers) { viewerWorkers = workers; }
+    DltViewerPluginWorkers *getViewerWorkers() { return viewerWorkers; }
+
     // get and set filter cache
     void setFilterCache(QString path) { filterCache = path; }
     QString getFilterCache() { return filterCache; }
@@ -126,6 +156,7 @@ private:
 
     // Plugins to be used
     QDltPluginManager *pluginManager;
+    DltViewerPluginWorkers *viewerWorkers;
 
     // DefaultFilter to be used
     QDltDefaultFilter *defaultFilter;
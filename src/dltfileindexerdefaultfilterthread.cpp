@@ -36,7 +36,7 @@ void DltFileIndexerDefaultFilterThread::run()
 void DltFileIndexerDefaultFilterThread::processMessage(QSharedPointer<QDltMsg> &msg, int index)
 {
     /* Process all decoderplugins */
-    pluginManager->decodeMsg(*msg, silentMode);
+    pluginManager->decodeMsgCached(*msg, index, silentMode);
 
     /* run through all default filter */
     for(int num = 0; num < defaultFilter->defaultFilterList.size(); num++)
@@ -12,6 +12,7 @@ DltFileIndexerThread::DltFileIndexerThread
         QMultiMap<DltFileIndexerKey,qint64> *indexFilterListSorted,
         QDltPluginManager *pluginManager,
         QList<QDltPlugin*> *activeViewerPlugins,
+        DltViewerPluginWorkers *viewerWorkers,
         bool silentMode
 )
     :indexer(indexer),
@@ -21,9 +22,22 @@ DltFileIndexerThread::DltFileIndexerThread
       indexFilterListSorted(indexFilterListSorted),
       pluginManager(pluginManager),
       activeViewerPlugins(activeViewerPlugins),
+      viewerWorkers(viewerWorkers),
       silentMode(silentMode), msgQueue(1024)
 {
+    if(viewerWorkers && viewerWorkers->isEmpty())
+        this->viewerWorkers = 0;
 
+    for(int ivp = 0; ivp < activeViewerPlugins->size(); ivp++)
+    {
+        QDltPlugin *item = activeViewerPlugins->at(ivp);
+        if(this->viewerWorkers && this->viewerWorkers->contains(item))
+            continue;
+        if(item->isViewerBatch())
+            batchViewerPlugins.append(item);
+        else
+            singleViewerPlugins.append(item);
+    }
 }
 
 DltFileIndexerThread::~DltFileIndexerThread()
@@ -46,14 +60,14 @@ void DltFileIndexerThread::run()
     QPair<QSharedPointer<QDltMsg>, int> msgPair;
     while(msgQueue.dequeue(msgPair))
         processMessage(msgPair.first, msgPair.second);
+
+    processBatch();
 }
 
 void DltFileIndexerThread::processMessage(QSharedPointer<QDltMsg> &msg, int index)
 {
     DltFileIndexer::IndexingMode mode = indexer->getMode();
     bool pluginsEnabled = indexer->getPluginsEnabled();
-    QDltPlugin *item;
-    bool bool_result = false;
 
     /* check if it is a version messages and
     version string not already parsed */
@@ -104,12 +118,77 @@ void DltFileIndexerThread::processMessage(QSharedPointer<QDltMsg> &msg, int inde
         }
     }
 
+    /* messages are collected for viewer plugins processing batches */
+    if((mode == DltFileIndexer::modeIndexAndFilter) && pluginsEnabled && (!batchViewerPlugins.isEmpty() || viewerWorkers))
+    {
+        batch.append(qMakePair(msg, index));
+        if(batch.size() >= QDLT_VIEWER_BATCH_SIZE)
+            processBatch();
+        return;
+    }
+
+    decodeAndFilterMessage(msg, index);
+}
+
+void DltFileIndexerThread::processBatch()
+{
+    if(batch.isEmpty())
+        return;
+
+    QDltMsgBatch msgBatch;
+    msgBatch.reserve(batch.size());
+    for(int num = 0; num < batch.size(); num++)
+        msgBatch.append(qMakePair(batch[num].second, batch[num].first.data()));
+
+    /* worker threads get a copy of the messages before and after decoding */
+    QSharedPointer<DltViewerPluginBatch> workerBatch;
+    if(viewerWorkers)
+    {
+        workerBatch = QSharedPointer<DltViewerPluginBatch>::create();
+        workerBatch->indexes.reserve(batch.size());
+        workerBatch->msgs.reserve(batch.size());
+        workerBatch->decodedMsgs.reserve(batch.size());
+        for(int num = 0; num < batch.size(); num++)
+        {
+            workerBatch->indexes.append(batch[num].second);
+            workerBatch->msgs.append(*batch[num].first);
+        }
+    }
+
+    /* all messages of the batch are offered undecoded first and decoded afterwards */
+    for(int ivp = 0; ivp < batchViewerPlugins.size(); ivp++)
+        batchViewerPlugins[ivp]->initMsgs(msgBatch);
+
+    for(int num = 0; num < batch.size(); num++)
+        decodeAndFilterMessage(batch[num].first, batch[num].second);
+
+    for(int ivp = 0; ivp < batchViewerPlugins.size(); ivp++)
+        batchViewerPlugins[ivp]->initMsgsDecoded(msgBatch);
+
+    /* the indexer does not wait for the workers */
+    if(viewerWorkers)
+    {
+        for(int num = 0; num < batch.size(); num++)
+            workerBatch->decodedMsgs.append(*batch[num].first);
+        viewerWorkers->broadcast(workerBatch);
+    }
+
+    batch.clear();
+}
+
+void DltFileIndexerThread::decodeAndFilterMessage(QSharedPointer<QDltMsg> &msg, int index)
+{
+    DltFileIndexer::IndexingMode mode = indexer->getMode();
+    bool pluginsEnabled = indexer->getPluginsEnabled();
+    QDltPlugin *item;
+    bool bool_result = false;
+
     /* Process all viewer plugins */
     if((mode == DltFileIndexer::modeIndexAndFilter) && pluginsEnabled)
     {
-        for(int ivp = 0; ivp < activeViewerPlugins->size(); ivp++)
+        for(int ivp = 0; ivp < singleViewerPlugins.size(); ivp++)
         {
-            item = (QDltPlugin *) activeViewerPlugins->at(ivp);
+            item = singleViewerPlugins.at(ivp);
             item->initMsg(index, *msg);
         }
     }
@@ -117,7 +196,7 @@ void DltFileIndexerThread::processMessage(QSharedPointer<QDltMsg> &msg, int inde
     /* Process all decoderplugins */
     if ( pluginsEnabled == true )
      {
-     (void) pluginManager->decodeMsg(*msg, silentMode);
+     (void) pluginManager->decodeMsgCached(*msg, index, silentMode);
      }
 
 
@@ -137,9 +216,9 @@ void DltFileIndexerThread::processMessage(QSharedPointer<QDltMsg> &msg, int inde
     /* Offer messages again to viewer plugins after decode */
     if((mode == DltFileIndexer::modeIndexAndFilter) && pluginsEnabled)
     {
-        for(int ivp = 0; ivp < activeViewerPlugins->size(); ivp++)
+        for(int ivp = 0; ivp < singleViewerPlugins.size(); ivp++)
         {
-            item = (QDltPlugin *) activeViewerPlugins->at(ivp);
+            item = singleViewerPlugins.at(ivp);
             item->initMsgDecoded(index, *msg);
         }
     }
@@ -9,10 +9,11 @@ class DltFileIndexerThread :public QThread
 {
     Q_OBJECT
 public:
-    DltFileIndexerThread(DltFileIndexer *indexer, QDltFilterList *filterList, bool sortByTimeEnabled, QVector<qint64> *indexFilterList, QMultiMap<DltFileIndexerKey,qint64> *indexFilterListSorted, QDltPluginManager *pluginManager, QList<QDltPlugin*> *activeViewerPlugins, bool silentMode);
+    DltFileIndexerThread(DltFileIndexer *indexer, QDltFilterList *filterList, bool sortByTimeEnabled, QVector<qint64> *indexFilterList, QMultiMap<DltFileIndexerKey,qint64> *indexFilterListSorted, QDltPluginManager *pluginManager, QList<QDltPlugin*> *activeViewerPlugins, DltViewerPluginWorkers *viewerWorkers, bool silentMode);
     ~DltFileIndexerThread();
     void enqueueMessage(const QSharedPointer<QDltMsg> &msg, int index);
     void processMessage(QSharedPointer<QDltMsg> &msg, int index);
+    void processBatch();
     void requestStop();
 
 protected:
@@ -28,8 +29,16 @@ private:
 
     QDltPluginManager *pluginManager;
     QList<QDltPlugin*> *activeViewerPlugins;
+    DltViewerPluginWorkers *viewerWorkers;
     bool silentMode;
 
+    /* viewer plugins get the messages in batches, one by one or in their worker thread */
+    QList<QDltPlugin*> batchViewerPlugins;
+    QList<QDltPlugin*> singleViewerPlugins;
+    QVector<QPair<QSharedPointer<QDltMsg>, int> > batch;
+
+    void decodeAndFilterMessage(QSharedPointer<QDltMsg> &msg, int index);
+
     DltMsgQueue msgQueue;
 };
 
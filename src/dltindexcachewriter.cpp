@@ -0,0 +1,88 @@
+#include "dltindexcachewriter.h"
+#include "dltfileindexer.h"
+
+DltIndexCacheWriter::DltIndexCacheWriter()
+{
+    endPos = 0;
+}
+
+DltIndexCacheWriter::~DltIndexCacheWriter()
+{
+    close();
+}
+
+void DltIndexCacheWriter::setCacheDir(const QString &dir)
+{
+    if(dir == cacheDir)
+        return;
+
+    close();
+    cacheDir = dir;
+}
+
+void DltIndexCacheWriter::append(const QString &logFileName, qint64 pos, qint64 size)
+{
+    if(cacheDir.isEmpty())
+        return;
+
+    // new log file, log file written from the beginning again or messages missing in the cache
+    if(logFileName != this->logFileName || pos == 0 || (file.isOpen() && pos != endPos))
+    {
+        close();
+        this->logFileName = logFileName;
+        if(!open(pos))
+            file.close();
+    }
+
+    if(!file.isOpen())
+        return;
+
+    file.write((char*)&pos,sizeof(pos));
+    endPos = pos + size;
+}
+
+void DltIndexCacheWriter::close()
+{
+    if(file.isOpen())
+        file.close();
+    logFileName.clear();
+    endPos = 0;
+}
+
+bool DltIndexCacheWriter::open(qint64 pos)
+{
+    quint32 version = DLT_FILE_INDEXER_FILE_VERSION;
+    qint64 last;
+
+    file.setFileName(cacheDir + "/" + DltFileIndexer::filenameIndexCache(logFileName));
+
+    // start a new cache with the first message
+    if(pos == 0)
+    {
+        if(!file.open(QFile::WriteOnly|QFile::Truncate))
+            return false;
+        file.write((char*)&version,sizeof(version));
+        endPos = 0;
+        return true;
+    }
+
+    // continue an existing cache, only if it ends with the last message written
+    if(!file.open(QFile::ReadWrite))
+        return false;
+
+    qint64 size = file.size();
+    if(size < (qint64)(sizeof(version) + sizeof(last)) || (size - sizeof(version)) % sizeof(last) != 0 ||
+       file.read((char*)&version,sizeof(version)) != sizeof(version) || version != DLT_FILE_INDEXER_FILE_VERSION ||
+       !file.seek(size - sizeof(last)) || file.read((char*)&last,sizeof(last)) != sizeof(last))
+    {
+        return false;
+    }
+
+    QFile logFile(logFileName);
+    if(!logFile.open(QFile::ReadOnly) || DltFileIndexer::messageEnd(logFile,last) != pos)
+        return false;
+    logFile.close();
+
+    endPos = pos;
+    return file.seek(size);
+}
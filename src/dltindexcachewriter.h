@@ -0,0 +1,57 @@
+#ifndef DLTINDEXCACHEWRITER_H
+#define DLTINDEXCACHEWRITER_H
+
+#include <QString>
+#include <QFile>
+
+/* Write the index cache of a log file while recording, so the log file
+ * can be opened again without scanning it.
+ * The cache has the same format and name as the index cache written by
+ * DltFileIndexer, it must not be written while the indexer is running.
+ */
+class DltIndexCacheWriter
+{
+public:
+
+    // constructor
+    DltIndexCacheWriter();
+
+    // destructor, closes the cache file
+    ~DltIndexCacheWriter();
+
+    // directory of the index cache files, empty if caching is disabled
+    void setCacheDir(const QString &dir);
+
+    /* A message was written to an uncompressed log file.
+     * The cache is started again with the first message of a log file,
+     * an existing cache is only continued, if its last entry is the last message
+     * written before. Otherwise no cache is written until close() is called.
+     * \param logFileName The log file
+     * \param pos Position of the message in the log file
+     * \param size Size of the message including the storage header
+     */
+    void append(const QString &logFileName, qint64 pos, qint64 size);
+
+    // write and close the cache file, the next message checks the cache again
+    void close();
+
+    // the cache file is written
+    bool isOpen() const { return file.isOpen(); }
+
+private:
+
+    // open the cache of the log file for a message at pos
+    bool open(qint64 pos);
+
+    QString cacheDir;
+
+    // log file of the cache, empty if not checked since the last close()
+    QString logFileName;
+
+    QFile file;
+
+    // position behind the last message in the cache
+    qint64 endPos;
+};
+
+#endif // DLTINDEXCACHEWRITER_H
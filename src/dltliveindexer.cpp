@@ -0,0 +1,261 @@
+#include "dltliveindexer.h"
+#include "optmanager.h"
+#include "qdltmetrics.h"
+
+extern "C" {
+    #include "dlt_common.h"
+}
+
+DltLiveIndexer::DltLiveIndexer(QDltPluginManager *pluginManager, QObject *parent) :
+    QThread(parent)
+{
+    this->pluginManager = pluginManager;
+    filtersEnabled = false;
+    pluginsEnabled = false;
+    triggeredByUser = false;
+    active = false;
+    scanPos = 0;
+    lastFound = 0;
+    nextIndex = 0;
+    dataPending = false;
+    collectMsgs = false;
+    stopFlag = false;
+    signalPending = false;
+}
+
+DltLiveIndexer::~DltLiveIndexer()
+{
+    stopIndexing();
+}
+
+void DltLiveIndexer::startIndexing(const QString &fileName, qint64 startPos, int nextIndex, const QDltFilterList &filterList, bool filtersEnabled, bool pluginsEnabled)
+{
+    stopIndexing();
+
+    this->fileName = fileName;
+    this->filterList = filterList;
+    this->filtersEnabled = filtersEnabled;
+    this->pluginsEnabled = pluginsEnabled;
+    this->nextIndex = nextIndex;
+    triggeredByUser = !OptManager::getInstance()->issilentMode();
+    scanPos = startPos;
+    lastFound = 0;
+
+    dataPending = false;
+    stopFlag = false;
+    signalPending = false;
+
+    active = true;
+    start();
+}
+
+void DltLiveIndexer::stopIndexing()
+{
+    if(!active)
+        return;
+
+    mutex.lock();
+    stopFlag = true;
+    condition.wakeOne();
+    mutex.unlock();
+
+    wait();
+    active = false;
+
+    /* the increments are covered by the complete index, which is created next */
+    mutex.lock();
+    pendingPositions.clear();
+    pendingFilterIndexes.clear();
+    pendingMsgs.clear();
+    pendingDecodedMsgs.clear();
+    mutex.unlock();
+}
+
+void DltLiveIndexer::dataWritten(bool collectMsgs)
+{
+    QMutexLocker locker(&mutex);
+
+    this->collectMsgs = collectMsgs;
+    dataPending = true;
+    condition.wakeOne();
+}
+
+bool DltLiveIndexer::takeIncrement(QVector<qint64> &positions, QVector<int> &filterIndexes, QVector<QDltMsg> &msgs, QVector<QDltMsg> &decodedMsgs)
+{
+    QMutexLocker locker(&mutex);
+
+    signalPending = false;
+    QDltMetrics::instance()->gauge("liveindexer.pending")->set(0);
+
+    if(pendingPositions.isEmpty())
+        return false;
+
+    positions.swap(pendingPositions);
+    filterIndexes.swap(pendingFilterIndexes);
+    msgs.swap(pendingMsgs);
+    decodedMsgs.swap(pendingDecodedMsgs);
+    pendingPositions.clear();
+    pendingFilterIndexes.clear();
+    pendingMsgs.clear();
+    pendingDecodedMsgs.clear();
+
+    return true;
+}
+
+void DltLiveIndexer::run()
+{
+    QFile file(fileName);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "DltLiveIndexer: cannot open" << fileName;
+        return;
+    }
+
+    while(true)
+    {
+        mutex.lock();
+        while(!dataPending && !stopFlag)
+            condition.wait(&mutex);
+        bool stop = stopFlag;
+        bool collect = collectMsgs;
+        dataPending = false;
+        mutex.unlock();
+
+        if(stop)
+            break;
+
+        indexNewData(file,collect);
+    }
+}
+
+void DltLiveIndexer::indexNewData(QFile &file, bool collectMsgs)
+{
+    static QDltMetricCounter *metricMsgs = QDltMetrics::instance()->counter("liveindexer.msgs");
+    static QDltMetricGauge *metricPending = QDltMetrics::instance()->gauge("liveindexer.pending");
+    QDltMetricTimer timer(QDltMetrics::instance()->histogram("liveindexer.batch"));
+
+    /* rescan the start of a marker found at the end of the last data */
+    int carry = (lastFound == 'D') ? 1 : ((lastFound == 'L') ? 2 : ((lastFound == 'T') ? 3 : 0));
+    qint64 pos = scanPos - carry;
+    lastFound = 0;
+
+    if(!file.seek(pos))
+        return;
+
+    QByteArray data = file.readAll();
+    if(data.size() <= carry)
+        return;
+
+    /* find all DLT0x01 markers in the new data */
+    QVector<qint64> positions;
+    const char *cbuf = data.constData();
+    int cbuf_sz = data.size();
+    for(int num=0;num<cbuf_sz;num++)
+    {
+        if(cbuf[num] == 'D')
+        {
+            lastFound = 'D';
+        }
+        else if(lastFound == 'D' && cbuf[num] == 'L')
+        {
+            lastFound = 'L';
+        }
+        else if(lastFound == 'L' && cbuf[num] == 'T')
+        {
+            lastFound = 'T';
+        }
+        else if(lastFound == 'T' && cbuf[num] == 0x01)
+        {
+            positions.append(pos+num-3);
+            lastFound = 0;
+        }
+        else
+        {
+            lastFound = 0;
+        }
+    }
+
+    /* a message reaches to the next marker, the last message must be complete according to its
+     * standard header, as the receiver writes storage header, header and payload separately */
+    const int headerSize = sizeof(DltStorageHeader) + sizeof(DltStandardHeader);
+    int complete = positions.size();
+    if(complete > 0)
+    {
+        int start = positions[complete-1] - pos;
+        if(cbuf_sz - start < headerSize)
+        {
+            complete--;
+        }
+        else
+        {
+            const DltStandardHeader *standardheader = (const DltStandardHeader *)(cbuf + start + sizeof(DltStorageHeader));
+            if(cbuf_sz - start < (int) sizeof(DltStorageHeader) + DLT_BETOH_16(standardheader->len))
+                complete--;
+        }
+    }
+
+    /* the incomplete message is read again with the next data */
+    if(complete < positions.size())
+    {
+        scanPos = positions[complete];
+        lastFound = 0;
+        positions.resize(complete);
+    }
+    else
+    {
+        scanPos = pos + cbuf_sz;
+    }
+
+    QVector<int> filterIndexes;
+    QVector<QDltMsg> msgs;
+    QVector<QDltMsg> decodedMsgs;
+    for(int num=0;num<positions.size();num++)
+    {
+        int start = positions[num] - pos;
+        int end = (num+1 < positions.size()) ? positions[num+1] - pos : (int) (scanPos - pos);
+        int index = nextIndex + num;
+        QDltMsg msg;
+
+        /* broken messages are kept in the index, but not decoded and filtered */
+        if(!msg.setMsg(QByteArray::fromRawData(cbuf + start, end - start)))
+        {
+            if(collectMsgs)
+            {
+                msgs.append(msg);
+                decodedMsgs.append(msg);
+            }
+            continue;
+        }
+
+        if(collectMsgs)
+            msgs.append(msg);
+
+        if(pluginsEnabled)
+            pluginManager->decodeMsgCached(msg,index,triggeredByUser);
+
+        if(!filtersEnabled || filterList.checkFilter(msg))
+            filterIndexes.append(index);
+
+        if(collectMsgs)
+            decodedMsgs.append(msg);
+    }
+    nextIndex += positions.size();
+    metricMsgs->add(positions.size());
+
+    if(positions.isEmpty())
+        return;
+
+    /* publish the increment at once, so index and filter index stay consistent */
+    mutex.lock();
+    pendingPositions += positions;
+    pendingFilterIndexes += filterIndexes;
+    pendingMsgs += msgs;
+    pendingDecodedMsgs += decodedMsgs;
+    metricPending->set(pendingPositions.size());
+    bool notify = !signalPending;
+    signalPending = true;
+    mutex.unlock();
+
+    if(notify)
+        emit indexUpdated();
+}
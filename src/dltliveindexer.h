@@ -0,0 +1,97 @@
+#ifndef DLTLIVEINDEXER_H
+#define DLTLIVEINDEXER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QVector>
+#include <QFile>
+
+#include "qdlt.h"
+
+class DltLiveIndexer : public QThread
+{
+    Q_OBJECT
+public:
+
+    // constructor
+    DltLiveIndexer(QDltPluginManager *pluginManager, QObject *parent = 0);
+
+    // destructor
+    ~DltLiveIndexer();
+
+    /* Start indexing the data appended to a log file.
+     * \param fileName The log file, which is written while receiving
+     * \param startPos Position in the file behind the already indexed data
+     * \param nextIndex Index of the next new message
+     * \param filterList Filters to be applied to the new messages
+     * \param filtersEnabled Filters are enabled
+     * \param pluginsEnabled Decoder plugins are enabled
+     */
+    void startIndexing(const QString &fileName, qint64 startPos, int nextIndex, const QDltFilterList &filterList, bool filtersEnabled, bool pluginsEnabled);
+
+    // stop the thread and discard all increments not taken yet
+    void stopIndexing();
+
+    // the live indexer is running
+    bool isActive() { return active; }
+
+    /* New data was written to the log file.
+     * \param collectMsgs Keep the new messages for the viewer plugins
+     */
+    void dataWritten(bool collectMsgs);
+
+    /* Take all index increments created since the last call.
+     * \param positions Positions of the new messages in the log file
+     * \param filterIndexes Indexes of the new messages matching the filters
+     * \param msgs The new messages before decoding, if collected
+     * \param decodedMsgs The new messages after decoding, if collected
+     * \return True if there are new messages
+     */
+    bool takeIncrement(QVector<qint64> &positions, QVector<int> &filterIndexes, QVector<QDltMsg> &msgs, QVector<QDltMsg> &decodedMsgs);
+
+signals:
+
+    // new increments are ready, signaled again after takeIncrement() was called
+    void indexUpdated();
+
+protected:
+
+    void run();
+
+private:
+
+    // index, decode and filter the data appended since the last call
+    void indexNewData(QFile &file, bool collectMsgs);
+
+    QDltPluginManager *pluginManager;
+
+    // configuration, only changed while the thread is not running
+    QString fileName;
+    QDltFilterList filterList;
+    bool filtersEnabled;
+    bool pluginsEnabled;
+    bool triggeredByUser;
+    bool active;
+
+    // state of the thread
+    qint64 scanPos;
+    char lastFound;
+    int nextIndex;
+
+    // synchronisation with the GUI thread
+    QMutex mutex;
+    QWaitCondition condition;
+    bool dataPending;
+    bool collectMsgs;
+    bool stopFlag;
+    bool signalPending;
+
+    // increments not taken yet
+    QVector<qint64> pendingPositions;
+    QVector<int> pendingFilterIndexes;
+    QVector<QDltMsg> pendingMsgs;
+    QVector<QDltMsg> pendingDecodedMsgs;
+};
+
+#endif // DLTLIVEINDEXER_H
@@ -24,8 +24,20 @@
 #include <QDir>
 #include <QMessageBox>
 
+#include "settingsdialog.h"
+
 DltSettingsManager *DltSettingsManager::m_instance = NULL;
 
+DltSettingsSnapshot::DltSettingsSnapshot()
+    : version(0),
+      pluginsEnabled(true),
+      filtersEnabled(true),
+      sortByTimeEnabled(false),
+      refreshRate(DEFAULT_REFRESH_RATE),
+      searchResultColor(QString("#00AAFF"))
+{
+}
+
 DltSettingsManager* DltSettingsManager::getInstance()
 {
     if(!m_instance)
@@ -58,16 +70,61 @@ DltSettingsManager::DltSettingsManager()
     }
 
     settings = new QSettings(dir.absolutePath()+"/config.ini", QSettings::IniFormat);
+
+    updateSnapshot();
 }
 
 DltSettingsManager::~DltSettingsManager()
 {
+    delete currentSnapshot.loadAcquire();
+    qDeleteAll(retiredSnapshots);
     delete settings;
 }
 
+void DltSettingsManager::updateSnapshot()
+{
+    const DltSettingsSnapshot *oldSnapshot = currentSnapshot.loadAcquire();
+
+    DltSettingsSnapshot *newSnapshot = new DltSettingsSnapshot();
+    newSnapshot->pluginsEnabled = settings->value("startup/pluginsEnabled", true).toBool();
+    newSnapshot->filtersEnabled = settings->value("startup/filtersEnabled", true).toBool();
+    newSnapshot->sortByTimeEnabled = settings->value("startup/sortByTimeEnabled", false).toBool();
+    newSnapshot->refreshRate = settings->value("RefreshRate", DEFAULT_REFRESH_RATE).toInt();
+    newSnapshot->searchResultColor = QColor(settings->value("other/searchResultColor", QString("#00AAFF")).toString());
+
+    if(oldSnapshot)
+    {
+        if(oldSnapshot->pluginsEnabled == newSnapshot->pluginsEnabled &&
+           oldSnapshot->filtersEnabled == newSnapshot->filtersEnabled &&
+           oldSnapshot->sortByTimeEnabled == newSnapshot->sortByTimeEnabled &&
+           oldSnapshot->refreshRate == newSnapshot->refreshRate &&
+           oldSnapshot->searchResultColor == newSnapshot->searchResultColor)
+        {
+            /* nothing changed, keep the current snapshot */
+            delete newSnapshot;
+            return;
+        }
+        newSnapshot->version = oldSnapshot->version + 1;
+
+        /* readers may still use the old snapshot, delete it when closing */
+        retiredSnapshots.append(oldSnapshot);
+    }
+
+    currentSnapshot.storeRelease(newSnapshot);
+
+    emit snapshotChanged(newSnapshot);
+}
+
 void DltSettingsManager::setValue(const QString &key, const QVariant &value)
 {
     settings->setValue(key, value);
+
+    if(key == "startup/pluginsEnabled" || key == "startup/filtersEnabled" ||
+       key == "startup/sortByTimeEnabled" || key == "RefreshRate" ||
+       key == "other/searchResultColor")
+    {
+        updateSnapshot();
+    }
 }
 
 QVariant DltSettingsManager::value(const QString &key, const QVariant &defaultValue) const
@@ -78,6 +135,7 @@ QVariant DltSettingsManager::value(const QString &key, const QVariant &defaultVa
 void DltSettingsManager::clear()
 {
     settings->clear();
+    updateSnapshot();
 }
 
 QString DltSettingsManager::fileName() const
@@ -23,9 +23,34 @@
 #define DLTSETTINGSMANAGER_H
 
 #include <qsettings.h>
+#include <QObject>
+#include <QColor>
+#include <QAtomicPointer>
+#include <QList>
 
-class DltSettingsManager
+/* Immutable copy of the settings read in per row and per message loops.
+ * A new snapshot with an incremented version is published, whenever
+ * one of these settings is changed. Published snapshots are never modified
+ * or deleted before the settings manager is closed, so a pointer
+ * to a snapshot can be kept and used without locking.
+ */
+class DltSettingsSnapshot
+{
+public:
+    DltSettingsSnapshot();
+
+    unsigned int version;
+    bool pluginsEnabled;
+    bool filtersEnabled;
+    bool sortByTimeEnabled;
+    int refreshRate;
+    QColor searchResultColor;
+};
+
+class DltSettingsManager : public QObject
 {
+    Q_OBJECT
+
 // Singleton pattern
 public:
     static DltSettingsManager* getInstance();
@@ -37,6 +62,11 @@ private:
     static DltSettingsManager *m_instance;
     QSettings *settings;
 
+    void updateSnapshot();
+
+    QAtomicPointer<const DltSettingsSnapshot> currentSnapshot;
+    QList<const DltSettingsSnapshot*> retiredSnapshots;
+
 // QSettings delegates
 public:
     void setValue(const QString &key, const QVariant &value);
@@ -44,6 +74,14 @@ public:
     void clear();
     QString fileName() const;
 
+// Settings snapshot
+public:
+    const DltSettingsSnapshot *snapshot() const { return currentSnapshot.loadAcquire(); }
+
+signals:
+    /* A new snapshot was published, dependent caches must be invalidated */
+    void snapshotChanged(const DltSettingsSnapshot *snapshot);
+
 };
 
 #endif // DLTSETTINGSMANAGER_H
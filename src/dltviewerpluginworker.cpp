@@ -0,0 +1,179 @@
+#include "dltviewerpluginworker.h"
+
+DltViewerPluginWorker::DltViewerPluginWorker(QDltPlugin *plugin, QObject *parent) :
+    QThread(parent)
+{
+    this->plugin = plugin;
+    busy = false;
+    stopFlag = false;
+
+    start();
+}
+
+DltViewerPluginWorker::~DltViewerPluginWorker()
+{
+    stop();
+}
+
+void DltViewerPluginWorker::enqueue(const QSharedPointer<const DltViewerPluginBatch> &batch)
+{
+    QMutexLocker locker(&mutex);
+
+    /* limit the memory, if the plugin is much slower than indexing */
+    while(queue.size() >= DLT_VIEWER_PLUGIN_WORKER_QUEUE_SIZE && !stopFlag)
+        condition.wait(&mutex);
+
+    queue.enqueue(batch);
+    condition.wakeAll();
+}
+
+void DltViewerPluginWorker::clear()
+{
+    QMutexLocker locker(&mutex);
+
+    queue.clear();
+    condition.wakeAll();
+}
+
+void DltViewerPluginWorker::waitForIdle()
+{
+    QMutexLocker locker(&mutex);
+
+    while((busy || !queue.isEmpty()) && !stopFlag)
+        condition.wait(&mutex);
+}
+
+void DltViewerPluginWorker::stop()
+{
+    mutex.lock();
+    stopFlag = true;
+    queue.clear();
+    condition.wakeAll();
+    mutex.unlock();
+
+    wait();
+}
+
+void DltViewerPluginWorker::run()
+{
+    forever
+    {
+        QSharedPointer<const DltViewerPluginBatch> batch;
+
+        mutex.lock();
+        busy = false;
+        condition.wakeAll();
+        while(queue.isEmpty() && !stopFlag)
+            condition.wait(&mutex);
+        if(stopFlag)
+        {
+            mutex.unlock();
+            return;
+        }
+        batch = queue.dequeue();
+        busy = true;
+        condition.wakeAll();
+        mutex.unlock();
+
+        processBatch(*batch);
+    }
+}
+
+void DltViewerPluginWorker::processBatch(const DltViewerPluginBatch &batch)
+{
+    /* the plugin could have been disabled since the worker was started */
+    if(plugin->getMode() < QDltPlugin::ModeEnable)
+        return;
+
+    /* each worker gets its own copy of the messages, so the plugin can modify them */
+    QVector<QDltMsg> msgs = batch.msgs;
+    QVector<QDltMsg> decodedMsgs = batch.decodedMsgs;
+
+    for(int start = 0; start < batch.indexes.size(); start += QDLT_VIEWER_BATCH_SIZE)
+    {
+        int end = qMin(start + QDLT_VIEWER_BATCH_SIZE, batch.indexes.size());
+        QDltMsgBatch msgBatch;
+        QDltMsgBatch decodedBatch;
+        msgBatch.reserve(end - start);
+        decodedBatch.reserve(end - start);
+        for(int num = start; num < end; num++)
+        {
+            msgBatch.append(qMakePair(batch.indexes[num], &msgs[num]));
+            decodedBatch.append(qMakePair(batch.indexes[num], &decodedMsgs[num]));
+        }
+
+        if(batch.update)
+        {
+            plugin->updateMsgs(msgBatch);
+            plugin->updateMsgsDecoded(decodedBatch);
+        }
+        else
+        {
+            plugin->initMsgs(msgBatch);
+            plugin->initMsgsDecoded(decodedBatch);
+        }
+    }
+}
+
+DltViewerPluginWorkers::~DltViewerPluginWorkers()
+{
+    qDeleteAll(workers);
+}
+
+void DltViewerPluginWorkers::setPlugins(const QList<QDltPlugin*> &viewerPlugins)
+{
+    QList<DltViewerPluginWorker*> oldWorkers = workers;
+    workers.clear();
+
+    for(int num = 0; num < viewerPlugins.size(); num++)
+    {
+        QDltPlugin *plugin = viewerPlugins[num];
+        if(!plugin->isViewerWorker())
+            continue;
+
+        /* keep the running worker of a plugin */
+        DltViewerPluginWorker *worker = 0;
+        for(int old = 0; old < oldWorkers.size(); old++)
+        {
+            if(oldWorkers[old]->getPlugin() == plugin)
+            {
+                worker = oldWorkers.takeAt(old);
+                break;
+            }
+        }
+        if(!worker)
+            worker = new DltViewerPluginWorker(plugin);
+
+        workers.append(worker);
+    }
+
+    qDeleteAll(oldWorkers);
+}
+
+bool DltViewerPluginWorkers::contains(QDltPlugin *plugin) const
+{
+    for(int num = 0; num < workers.size(); num++)
+    {
+        if(workers[num]->getPlugin() == plugin)
+            return true;
+    }
+    return false;
+}
+
+void DltViewerPluginWorkers::broadcast(const QSharedPointer<const DltViewerPluginBatch> &batch)
+{
+    for(int num = 0; num < workers.size(); num++)
+        workers[num]->enqueue(batch);
+}
+
+void DltViewerPluginWorkers::clear()
+{
+    for(int num = 0; num < workers.size(); num++)
+        workers[num]->clear();
+}
+
+void DltViewerPluginWorkers::waitForIdle()
+{
+    for(int num = 0; num < workers.size(); num++)
+        workers[num]->waitForIdle();
+}
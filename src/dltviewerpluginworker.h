@@ -0,0 +1,101 @@
+#ifndef DLTVIEWERPLUGINWORKER_H
+#define DLTVIEWERPLUGINWORKER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QQueue>
+#include <QVector>
+#include <QSharedPointer>
+
+#include "qdlt.h"
+
+/* Maximum number of batches queued for a worker, the producer waits when the worker falls further behind */
+#define DLT_VIEWER_PLUGIN_WORKER_QUEUE_SIZE 256
+
+/* Messages passed at once to the viewer plugin workers, shared by all workers */
+class DltViewerPluginBatch
+{
+public:
+    DltViewerPluginBatch() { update = false; }
+
+    /* messages are added to a loaded log file or received */
+    bool update;
+
+    QVector<int> indexes;
+    QVector<QDltMsg> msgs;
+    QVector<QDltMsg> decodedMsgs;
+};
+
+/* Runs the batch callbacks of one viewer plugin in its own thread */
+class DltViewerPluginWorker : public QThread
+{
+    Q_OBJECT
+public:
+
+    // constructor, the thread is started
+    DltViewerPluginWorker(QDltPlugin *plugin, QObject *parent = 0);
+
+    // destructor, queued batches are discarded
+    ~DltViewerPluginWorker();
+
+    QDltPlugin *getPlugin() const { return plugin; }
+
+    // add a batch to the queue, waits only if the queue is full
+    void enqueue(const QSharedPointer<const DltViewerPluginBatch> &batch);
+
+    // discard all queued batches
+    void clear();
+
+    // wait until all queued batches are processed
+    void waitForIdle();
+
+    // stop the thread
+    void stop();
+
+protected:
+
+    void run();
+
+private:
+
+    void processBatch(const DltViewerPluginBatch &batch);
+
+    QDltPlugin *plugin;
+
+    QMutex mutex;
+    QWaitCondition condition;
+    QQueue<QSharedPointer<const DltViewerPluginBatch> > queue;
+    bool busy;
+    bool stopFlag;
+};
+
+/* The workers of all viewer plugins running in a worker thread.
+ * The set of workers is only changed in the GUI thread while no indexing is running. */
+class DltViewerPluginWorkers
+{
+public:
+    ~DltViewerPluginWorkers();
+
+    // start workers for the plugins requesting a worker thread and stop the others
+    void setPlugins(const QList<QDltPlugin*> &viewerPlugins);
+
+    bool isEmpty() const { return workers.isEmpty(); }
+
+    // check if the plugin is run by a worker
+    bool contains(QDltPlugin *plugin) const;
+
+    // pass a batch to all workers
+    void broadcast(const QSharedPointer<const DltViewerPluginBatch> &batch);
+
+    // discard all queued batches of all workers
+    void clear();
+
+    // wait until all workers processed their queued batches
+    void waitForIdle();
+
+private:
+    QList<DltViewerPluginWorker*> workers;
+};
+
+#endif // DLTVIEWERPLUGINWORKER_H
@@ -138,6 +138,9 @@ MainWindow::MainWindow(QWidget *parent) :
     draw_timer.setSingleShot (true);
     connect(&draw_timer, SIGNAL(timeout()), this, SLOT(draw_timeout()));
 
+    /* compressed recording becomes visible when a block was written */
+    connect(&recordingWriter, SIGNAL(blockWritten(qint64)), this, SLOT(recordingBlockWritten(qint64)));
+
     if ( true == DltSettingsManager::getInstance()->value("StartUpMinimized",false).toBool() )
     {
         qDebug() << "Start minimzed as defined in the settings";
@@ -149,7 +152,9 @@ MainWindow::MainWindow(QWidget *parent) :
 MainWindow::~MainWindow()
 {
     //qDebug() << "Clean up";
+    liveIndexer->stopIndexing();
     dltIndexer->stop(); // in case a thread is running we want to stop it
+    viewerWorkers.setPlugins(QList<QDltPlugin*>()); // stop worker threads before the plugins are unloaded
     DltSettingsManager::close();
     /**
      * All plugin dockwidgets must be removed from the layout manually and
@@ -170,6 +175,10 @@ MainWindow::~MainWindow()
         }
     }
 
+    // write pending compressed data and block index
+    recordingWriter.close();
+    indexCacheWriter.close();
+
     // rename output filename if flag set in settings
     if(settings->appendDateTime)
     {
@@ -178,7 +187,7 @@ MainWindow::~MainWindow()
         QString newFilename = info.baseName()+
                 (startLoggingDateTime.toString("__yyyyMMdd_hhmmss"))+
                 (QDateTime::currentDateTime().toString("__yyyyMMdd_hhmmss"))+
-                QString(".dlt");
+                QString(QDltCompressedFile::isCompressedFile(outputfile.fileName())?".dlt.gz":".dlt");
         QFileInfo infoNew(info.absolutePath(),newFilename);
 
         // rename old file
@@ -326,6 +335,7 @@ void MainWindow::initView()
     totalBytesRcvd = 0;
     totalByteErrorsRcvd = 0;
     totalSyncFoundRcvd = 0;
+    totalDropsRcvd = 0;
 
     /* filename string */
     statusFilename = new QLabel("No log file loaded");
@@ -346,11 +356,14 @@ void MainWindow::initView()
     statusBytesReceived = new QLabel("Recv: 0");
     statusByteErrorsReceived = new QLabel("Recv Errors: 0");
     statusSyncFoundReceived = new QLabel("Sync found: 0");
+    statusDropsReceived = new QLabel("Recv Drops: 0");
+    statusDropsReceived->setToolTip("UDP datagrams dropped by the operating system");
     statusProgressBar = new QProgressBar();
     statusBar()->addWidget(statusFilename, 1);
     statusBar()->addWidget(statusFileVersion, 1);
     statusBar()->addWidget(statusBytesReceived);
     statusBar()->addWidget(statusByteErrorsReceived);
+    statusBar()->addWidget(statusDropsReceived);
     statusBar()->addWidget(statusSyncFoundReceived);
     statusBar()->addWidget(statusProgressBar);
 
@@ -493,6 +506,7 @@ void MainWindow::initFileHandling()
 {
     /* Initialize dlt-file indexer  */
     dltIndexer = new DltFileIndexer(&qfile,&pluginManager,&defaultFilter, this);
+    dltIndexer->setViewerWorkers(&viewerWorkers);
 
     /* connect signals */
     connect(dltIndexer, SIGNAL(progressMax(quint64)), this, SLOT(reloadLogFileProgressMax(quint64)));
@@ -505,6 +519,15 @@ void MainWindow::initFileHandling()
     connect(dltIndexer, SIGNAL(timezone(int,unsigned char)), this, SLOT(controlMessage_Timezone(int,unsigned char)));
     connect(dltIndexer, SIGNAL(unregisterContext(QString,QString,QString)), this, SLOT(controlMessage_UnregisterContext(QString,QString,QString)));
 
+    /* Initialize indexer of received messages */
+    liveIndexer = new DltLiveIndexer(&pluginManager, this);
+    connect(liveIndexer, SIGNAL(indexUpdated()), this, SLOT(liveIndexUpdated()));
+
+    /* Initialize performance diagnostics, the JSON dump runs also while the dialog is hidden */
+    diagnosticsDialog = new DiagnosticsDialog(this);
+    profileDialog = new ProfileDialog(this);
+    ui->action_menuHelp_Profile->setChecked(DltSettingsManager::getInstance()->value("startup/profileIndexing", false).toBool());
+
     /* Plugins/Filters enabled checkboxes */
     pluginsEnabled = DltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool();
     dltIndexer->setPluginsEnabled(pluginsEnabled);
@@ -614,6 +637,13 @@ void MainWindow::initFileHandling()
         }
     }
 
+    /* in tail mode the table shows only the last received messages kept in memory,
+       it is entered after the startup files are loaded, as opening a file leaves tail mode */
+    tailRing.setMaxMessages(settings->tailMaxMessages);
+    tailRing.setMaxAge(settings->tailMaxSeconds);
+    if(settings->tailMode && false == OptManager::getInstance()->isConvert())
+        enterTailMode();
+
     if(true == OptManager::getInstance()->isConvert())
     {
         switch ( OptManager::getInstance()->get_convertionmode() )
@@ -789,7 +819,9 @@ void MainWindow::deleteactualFile()
     if(outputfileIsTemporary && !outputfileIsFromCLI)
     {
         // Delete created temp file
+        liveIndexer->stopIndexing();
         qfile.close();
+        recordingWriter.close();
         outputfile.close();
         if(outputfile.exists() && !outputfile.remove())
         {
@@ -866,6 +898,7 @@ void MainWindow::onNewTriggered(QString fileName)
     workingDirectory.setDltDirectory(QFileInfo(fileName).absolutePath());
 
     // close existing file
+    recordingWriter.close();
     if(outputfile.isOpen())
     {
         if (outputfile.size() == 0)
@@ -902,7 +935,7 @@ void MainWindow::onNewTriggered(QString fileName)
 void MainWindow::on_action_menuFile_Open_triggered()
 {
     QStringList fileNames = QFileDialog::getOpenFileNames(this,
-        tr("Open one or more DLT Log files"), workingDirectory.getDltDirectory(), tr("DLT Files (*.dlt);;All files (*.*)"));
+        tr("Open one or more DLT Log files"), workingDirectory.getDltDirectory(), tr("DLT Files (*.dlt *.dlt.gz *.dlt.zst);;All files (*.*)"));
 
     if(fileNames.isEmpty())
         return;
@@ -962,6 +995,9 @@ bool MainWindow::openDltFile(QStringList fileNames)
     if(fileNames.size()==0)
         return false;
 
+    /* the opened file is shown by its index */
+    leaveTailMode();
+
     //qDebug() << "Open" << fileNames;
     //clear search history list
     //searchHistory.clear();
@@ -974,6 +1010,7 @@ bool MainWindow::openDltFile(QStringList fileNames)
     // clear the cache stored for the history
     searchDlg->clearCacheHistory();
 
+    recordingWriter.close();
     if(outputfile.isOpen())
     {
         if (outputfile.size() == 0)
@@ -986,10 +1023,11 @@ bool MainWindow::openDltFile(QStringList fileNames)
         }
     }
 
-    /* open existing file and append new data */
+    /* open existing file and append new data, compressed files can only be read */
     outputfile.setFileName(fileNames.last());
     setCurrentFile(fileNames.last());
-    if(true == outputfile.open(QIODevice::WriteOnly|QIODevice::Append))
+    if(false == QDltCompressedFile::isCompressedFile(fileNames.last()) &&
+       true == outputfile.open(QIODevice::WriteOnly|QIODevice::Append))
     {
         openFileNames = fileNames;
         isDltFileReadOnly = false;
@@ -1068,10 +1106,7 @@ void MainWindow::on_action_menuFile_Import_DLT_Stream_triggered()
     /* parse and build index of complete log file and show progress */
     while (dlt_file_read_raw(&importfile,false,0)>=0)
     {
-        // https://bugreports.qt-project.org/browse/QTBUG-26069
-        outputfile.seek(outputfile.size());
-        outputfile.write((char*)importfile.msg.headerbuffer,importfile.msg.headersize);
-        outputfile.write((char*)importfile.msg.databuffer,importfile.msg.datasize);
+        writeOutputMessage((const char*)importfile.msg.headerbuffer,importfile.msg.headersize,(const char*)importfile.msg.databuffer,importfile.msg.datasize);
         outputfile.flush();
 
     }
@@ -1112,10 +1147,7 @@ void MainWindow::on_action_menuFile_Import_DLT_Stream_with_Serial_Header_trigger
     /* parse and build index of complete log file and show progress */
     while (dlt_file_read_raw(&importfile,true,0)>=0)
     {
-        // https://bugreports.qt-project.org/browse/QTBUG-26069
-        outputfile.seek(outputfile.size());
-        outputfile.write((char*)importfile.msg.headerbuffer,importfile.msg.headersize);
-        outputfile.write((char*)importfile.msg.databuffer,importfile.msg.datasize);
+        writeOutputMessage((const char*)importfile.msg.headerbuffer,importfile.msg.headersize,(const char*)importfile.msg.databuffer,importfile.msg.datasize);
         outputfile.flush();
 
     }
@@ -1190,8 +1222,7 @@ void MainWindow::on_action_menuFile_Append_DLT_File_triggered()
             return;
         }
         dlt_file_message(&importfile,pos,0);
-        outputfile.write((char*)importfile.msg.headerbuffer,importfile.msg.headersize);
-        outputfile.write((char*)importfile.msg.databuffer,importfile.msg.datasize);
+        writeOutputMessage((const char*)importfile.msg.headerbuffer,importfile.msg.headersize,(const char*)importfile.msg.databuffer,importfile.msg.datasize);
     }
     outputfile.flush();
 
@@ -1209,6 +1240,12 @@ void MainWindow::exportSelection(bool ascii = true,bool file = false)
 
     QModelIndexList list = ui->tableView->selectionModel()->selection().indexes();
 
+    if(tableModel->isTailMode())
+    {
+        copyTailSelection(list);
+        return;
+    }
+
     DltExporter exporter;
     exporter.exportMessages(&qfile,0,&pluginManager,DltExporter::FormatClipboard,DltExporter::SelectionSelected,&list);
 }
@@ -1217,6 +1254,10 @@ void MainWindow::exportSelection_searchTable()
 {
     const QModelIndexList list = ui->tableView_SearchIndex->selectionModel()->selectedRows();
 
+    // The search results are positions in the log file, which is not shown in tail mode
+    if(tableModel->isTailMode())
+        return;
+
     // Clear the selection from main table.
     ui->tableView->selectionModel()->clear();
 
@@ -1249,6 +1290,10 @@ void MainWindow::exportSelection_searchTable()
 
 void MainWindow::on_actionExport_triggered()
 {
+    /* the log file is not indexed in tail mode */
+    if(tableModel->isTailMode())
+        return;
+
     /* export dialog */
     exporterDialog.exec();
     if(exporterDialog.result() != QDialog::Accepted)
@@ -1400,6 +1445,7 @@ void MainWindow::onSaveAsTriggered(QString fileName)
     /* change DLT file working directory */
     workingDirectory.setDltDirectory(QFileInfo(fileName).absolutePath());
 
+    liveIndexer->stopIndexing();
     qfile.close();
     outputfile.close();
 
@@ -1418,7 +1464,13 @@ void MainWindow::onSaveAsTriggered(QString fileName)
     }
 
 
-    if(!sourceFile.copy(destFile.fileName()))
+    /* copy in the kernel if possible, QFile::copy() copies in small blocks */
+    bool copied = sourceFile.open(QIODevice::ReadOnly) && destFile.open(QIODevice::WriteOnly) &&
+                  QDltFile::copyFileRange(sourceFile,0,sourceFile.size(),destFile);
+    sourceFile.close();
+    destFile.close();
+
+    if(!copied)
     {
         QMessageBox::critical(0, QString("DLT Viewer"),
                               QString("Save as failed! Could not move to new destination."));
@@ -1446,7 +1498,9 @@ void MainWindow::onSaveAsTriggered(QString fileName)
 void MainWindow::on_action_menuFile_Clear_triggered()
 {
     //qDebug() << "MainWindow::on_action_menuFile_Clear_triggered()" << outputfile.fileName() << __FILE__ <<  __LINE__;
+    liveIndexer->stopIndexing();
     dltIndexer->stop(); // in case an indexer thread is running right now we need to stop it
+    tailRing.clear();
 
     QString fn = DltFileUtils::createTempFile(DltFileUtils::getTempPath(settings, OptManager::getInstance()->issilentMode()), OptManager::getInstance()->issilentMode());
     if(!fn.length())
@@ -1488,6 +1542,7 @@ void MainWindow::on_action_menuFile_Clear_triggered()
 
     totalBytesRcvd = 0; // reset receive counter too
     totalSyncFoundRcvd = 0; // reset sync counter too
+    totalDropsRcvd = 0; // reset drop counter too
 
     if(true == outputfile.open(QIODevice::WriteOnly|QIODevice::Truncate))
     {
@@ -1627,6 +1682,9 @@ void MainWindow::reloadLogFileFinishFilter()
    // if((dltIndexer->getMode() == DltFileIndexer::modeIndexAndFilter) && dltIndexer->getPluginsEnabled())
     if((dltIndexer->getMode() == DltFileIndexer::modeIndexAndFilter) && ( pluginsEnabled == true ))
     {
+        // the viewer plugins in worker threads must have processed all messages
+        viewerWorkers.waitForIdle();
+
         QList<QDltPlugin*> activeViewerPlugins;
         activeViewerPlugins = pluginManager.getViewerPlugins();
         for(int i = 0; i < activeViewerPlugins.size(); i++){
@@ -1635,6 +1693,9 @@ void MainWindow::reloadLogFileFinishFilter()
         }
     }
 
+    // show the cost of plugins and filters of this run, if profiling is enabled
+    profileDialog->finishRun();
+
     // enable filter if requested
     qfile.enableFilter(DltSettingsManager::getInstance()->value("startup/filtersEnabled", true).toBool());
     qfile.enableSortByTime(DltSettingsManager::getInstance()->value("startup/sortByTimeEnabled", false).toBool());
@@ -1642,6 +1703,9 @@ void MainWindow::reloadLogFileFinishFilter()
     // updateIndex, if messages are received in between
     updateIndex();
 
+    // index further received messages in the background
+    startLiveIndexer();
+
     // update table
     tableModel->setForceEmpty(false);
     tableModel->modelChanged();
@@ -1739,11 +1803,18 @@ void MainWindow::reloadLogFile(bool update, bool multithreaded)
     tableModel->modelChanged();
 
     // stop last indexing process, if any
+    liveIndexer->stopIndexing();
     dltIndexer->stop();
 
+    // no decoding is running now, the dispatch tables replaced meanwhile are not used anymore
+    pluginManager.releaseRetiredDispatchTables();
+
     // open qfile
     if( false == update)
     {
+        // decoded messages of the last file are not valid anymore
+        pluginManager.getDecodedMsgCache().clear();
+
         for(int num=0;num<openFileNames.size();num++)
         {
             bool back = qfile.open(openFileNames[num],num!=0);
@@ -1751,6 +1822,10 @@ void MainWindow::reloadLogFile(bool update, bool multithreaded)
             {
               qDebug() << "ERROR opening file (s)" << openFileNames[num] << __FILE__ << __LINE__;
             }
+            else if(!qfile.isRandomAccess(num))
+            {
+                statusBar()->showMessage(QString("%1 has no zstd seek points, scrolling backwards will be slow").arg(QFileInfo(openFileNames[num]).fileName()), 10000);
+            }
         }
     }
     //qfile.enableFilter(DltSettingsManager::getInstance()->value("startup/filtersEnabled", true).toBool());
@@ -1783,9 +1858,27 @@ void MainWindow::reloadLogFile(bool update, bool multithreaded)
     dltIndexer->setSortByTimeEnabled(DltSettingsManager::getInstance()->value("startup/sortByTimeEnabled", false).toBool());
     dltIndexer->setMultithreaded(multithreaded);
     if(settings->filterCache)
+    {
         dltIndexer->setFilterCache(settings->filterCacheName);
+        indexCacheWriter.setCacheDir(settings->filterCacheName);
+    }
     else
+    {
         dltIndexer->setFilterCache(QString(""));
+        indexCacheWriter.setCacheDir(QString(""));
+    }
+
+    // measure the cost of plugins and filters of this run, if profiling is enabled
+    profileDialog->startRun();
+
+    // start a worker thread for each viewer plugin running in its own thread
+    // the workers must not process messages of the last file anymore, when the new file is started
+    if(dltIndexer->getMode() == DltFileIndexer::modeIndexAndFilter)
+    {
+        viewerWorkers.clear();
+        viewerWorkers.waitForIdle();
+        viewerWorkers.setPlugins(pluginsEnabled ? pluginManager.getViewerPlugins() : QList<QDltPlugin*>());
+    }
 
     // run through all viewer plugins
     // must be run in the UI thread, if some gui actions are performed
@@ -1816,7 +1909,9 @@ void MainWindow::reloadLogFileDefaultFilter()
 {
     // stop last indexing process, if any
     on_actionDefault_Filter_Reload_triggered();
+    liveIndexer->stopIndexing();
     dltIndexer->stop();
+    pluginManager.releaseRetiredDispatchTables();
 
     // set indexing mode
     dltIndexer->setMode(DltFileIndexer::modeDefaultFilter);
@@ -1859,7 +1954,7 @@ void MainWindow::applySettings()
     settings->showNoar?ui->tableView->showColumn(11):ui->tableView->hideColumn(11);
     settings->showPayload?ui->tableView->showColumn(12):ui->tableView->hideColumn(12);
 
-    int refreshRate = DltSettingsManager::getInstance()->value("RefreshRate",DEFAULT_REFRESH_RATE).toInt();
+    int refreshRate = DltSettingsManager::getInstance()->snapshot()->refreshRate;
     if ( refreshRate > 0 )
     {
         draw_interval = 1000 / refreshRate;
@@ -1889,6 +1984,7 @@ void MainWindow::on_action_menuFile_Settings_triggered()
 
         // Apply settings to table
         applySettings();
+        applyTailMode();
 
         // reload multifilter list if changed
         if((defaultFilterPath != settings->defaultFilterPath)||(settings->defaultFilterPath && defaultFilterPathName != settings->defaultFilterPathName))
@@ -1973,7 +2069,7 @@ void MainWindow::on_action_menuProject_Open_triggered()
 
 bool MainWindow::anyFiltersEnabled()
 {
-    if(!(DltSettingsManager::getInstance()->value("startup/filtersEnabled", true).toBool()))
+    if(!(DltSettingsManager::getInstance()->snapshot()->filtersEnabled))
     {
         return false;
     }
@@ -2890,6 +2986,7 @@ void MainWindow::disconnectECU(EcuItem *ecuitem)
         if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP)
         {
             /* TCP or UDP */
+            ecuitem->udpReceiver.close();
             if (ecuitem->socket->state()!=QAbstractSocket::UnconnectedState)
                 ecuitem->socket->disconnectFromHost();
         }
@@ -3054,6 +3151,15 @@ void MainWindow::connected()
             ecuitem->ipcon.clear();
             ecuitem->serialcon.clear();
             qDebug()<<"Connected to" << ecuitem->getHostname() << "at" << QDateTime::currentDateTime().toString("hh:mm:ss");
+
+            /* receive UDP datagrams in batches in a thread, so the kernel does not drop them while the GUI is busy */
+            if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP && QDltUDPReceiver::isSupported())
+            {
+                disconnect(&ecuitem->udpReceiver,0,0,0);
+                connect(&ecuitem->udpReceiver,SIGNAL(dataReceived()),this,SLOT(readyRead()));
+                if(!ecuitem->udpReceiver.open(ecuitem->socket->socketDescriptor()))
+                    qDebug() << "UDP receiver thread not started for" << ecuitem->getHostname();
+            }
         }
     }
 checkConnectionState();
@@ -3120,6 +3226,7 @@ void MainWindow::disconnected()
 
             /* disconnect socket signals from window slots */
             disconnect(ecuitem->socket,0,0,0);
+            ecuitem->udpReceiver.close();
         }
     }
       checkConnectionState();
@@ -3202,7 +3309,7 @@ void MainWindow::readyRead()
         for(int num = 0; num < project.ecu->topLevelItemCount (); num++)
         {
             EcuItem *ecuitem = (EcuItem*)project.ecu->topLevelItem(num);
-            if( ecuitem && (ecuitem->socket == sender() || ecuitem->m_serialport == sender()))
+            if( ecuitem && (ecuitem->socket == sender() || ecuitem->m_serialport == sender() || &ecuitem->udpReceiver == sender()))
             {
                 read(ecuitem);
             }
@@ -3219,14 +3326,23 @@ void MainWindow::read(EcuItem* ecuitem)
        return;
     }
 
+    static QDltMetricCounter *metricBytes = QDltMetrics::instance()->counter("receive.bytes");
+    static QDltMetricCounter *metricMsgs = QDltMetrics::instance()->counter("receive.msgs");
+    static QDltMetricCounter *metricErrors = QDltMetrics::instance()->counter("receive.errors");
+    static QDltMetricCounter *metricDrops = QDltMetrics::instance()->counter("receive.drops");
+    static QDltMetricHistogram *metricFlush = QDltMetrics::instance()->histogram("writer.flush");
+
     int32_t bytesRcvd = 0;
     QDltMsg qmsg;
     QByteArray data;
     
     if(ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP || ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP)
     {
-        /* TCP or UDP */
-        data = ecuitem->socket->readAll();
+        /* TCP or UDP, datagrams are collected by the UDP receiver thread if it is running */
+        if(ecuitem->udpReceiver.isOpen())
+            data = ecuitem->udpReceiver.takeData();
+        else
+            data = ecuitem->socket->readAll();
         bytesRcvd = data.size();
 
         ecuitem->ipcon.add(data);
@@ -3246,13 +3362,14 @@ void MainWindow::read(EcuItem* ecuitem)
     if (bytesRcvd>0)
     {
         ecuitem->totalBytesRcvd += bytesRcvd;
+        metricBytes->add(bytesRcvd);
 
         while(((ecuitem->interfacetype == EcuItem::INTERFACETYPE_TCP ||
                 ecuitem->interfacetype == EcuItem::INTERFACETYPE_UDP) &&
                 ecuitem->ipcon.parse(qmsg)) ||
                (ecuitem->interfacetype == EcuItem::INTERFACETYPE_SERIAL && ecuitem->serialcon.parse(qmsg)))
         {
-
+            metricMsgs->add();
 
             DltStorageHeader str;
             str.pattern[0]='D';
@@ -3314,17 +3431,24 @@ void MainWindow::read(EcuItem* ecuitem)
                     // check if files size limit reached
                     if(settings->maxFileSizeMB && ((outputfile.size()+sizeof(DltStorageHeader)+bufferHeader.size()+bufferPayload.size())>(((size_t)settings->maxFileSizeMB)*1000*1000)))
                     {
+                        // write pending compressed data and block index before copy
+                        bool compressed = recordingWriter.isOpen();
+                        recordingWriter.close();
+
                         // get new filename
                         QFileInfo info(outputfile.fileName());
                         QString newFilename = info.baseName()+
                                 (startLoggingDateTime.toString("__yyyyMMdd_hhmmss"))+
                                 (QDateTime::currentDateTime().toString("__yyyyMMdd_hhmmss"))+
-                                QString(".dlt");
+                                QString(compressed?".dlt.gz":".dlt");
                         QFileInfo infoNew(info.absolutePath(),newFilename);
 
                         // rename old file
                        outputfile.copy(outputfile.fileName(),infoNew.absoluteFilePath());
 
+                        // the index cache belongs to the renamed file now
+                        copyIndexCache(outputfile.fileName(),infoNew.absoluteFilePath());
+
                         // set new start time
                         startLoggingDateTime = QDateTime::currentDateTime();
 
@@ -3332,11 +3456,39 @@ void MainWindow::read(EcuItem* ecuitem)
                         onNewTriggered(info.absoluteFilePath());
                     }
 
+                    // start compressed recording into a new file
+                    if(settings->compressRecording && !recordingWriter.isOpen() && outputfile.size() == 0)
+                    {
+                        if(!recordingWriter.open(outputfile.fileName()))
+                            qDebug() << "Compressed recording not possible, writing uncompressed" << outputfile.fileName();
+                    }
+
                     // write data into file
-                    outputfile.write((char*)&str,sizeof(DltStorageHeader));
-                    outputfile.write(bufferHeader);
-                    outputfile.write(bufferPayload);
-                    outputfile.flush();
+                    if(recordingWriter.isOpen())
+                    {
+                        // the whole message is written at once, so blocks always end at a message boundary
+                        QByteArray bufferMessage;
+                        bufferMessage.reserve(sizeof(DltStorageHeader)+bufferHeader.size()+bufferPayload.size());
+                        bufferMessage.append((const char*)&str,sizeof(DltStorageHeader));
+                        bufferMessage.append(bufferHeader);
+                        bufferMessage.append(bufferPayload);
+                        recordingWriter.write(bufferMessage.constData(),bufferMessage.size());
+                    }
+                    else
+                    {
+                        appendIndexCache(outputfile.size(),sizeof(DltStorageHeader)+bufferHeader.size()+bufferPayload.size());
+                        outputfile.write((char*)&str,sizeof(DltStorageHeader));
+                        outputfile.write(bufferHeader);
+                        outputfile.write(bufferPayload);
+                        QDltMetricTimer timer(metricFlush);
+                        outputfile.flush();
+                    }
+
+                    /* in tail mode the message is kept in memory for the table instead of indexing the log file */
+                    if(tableModel->isTailMode())
+                    {
+                        appendTailMsg(qmsg,str);
+                    }
 
                     /* in Logging only mode send all messages to the plugins */
                     /* GW, 8.5.18 indeed: in logging only mode we explicitely do not want to run through any plugins !!!
@@ -3368,17 +3520,22 @@ void MainWindow::read(EcuItem* ecuitem)
         {
             /* TCP or UDP */
             totalByteErrorsRcvd+=ecuitem->ipcon.bytesError;
+            metricErrors->add(ecuitem->ipcon.bytesError);
             ecuitem->ipcon.bytesError = 0;
             totalBytesRcvd+=ecuitem->ipcon.bytesReceived;
             //qDebug() << "totalBytesRcvd" << totalBytesRcvd;
             ecuitem->ipcon.bytesReceived = 0;
             totalSyncFoundRcvd+=ecuitem->ipcon.syncFound;
             ecuitem->ipcon.syncFound = 0;
+            quint64 drops = ecuitem->udpReceiver.takeDrops();
+            totalDropsRcvd+=drops;
+            metricDrops->add(drops);
          }
         else if(ecuitem->m_serialport)
         {
             /* serial */
             totalByteErrorsRcvd+=ecuitem->serialcon.bytesError;
+            metricErrors->add(ecuitem->serialcon.bytesError);
             ecuitem->serialcon.bytesError = 0;
             totalBytesRcvd+=ecuitem->serialcon.bytesReceived;
             ecuitem->serialcon.bytesReceived = 0;
@@ -3401,6 +3558,16 @@ void MainWindow::read(EcuItem* ecuitem)
 
 }
 
+void MainWindow::recordingBlockWritten(qint64 uncompressedSize)
+{
+    Q_UNUSED(uncompressedSize);
+
+    if(false == dltIndexer->isRunning())
+    {
+        updateIndex();
+    }
+}
+
 void MainWindow::updateIndex()
 {
     QList<QDltPlugin*> activeViewerPlugins;
@@ -3408,8 +3575,24 @@ void MainWindow::updateIndex()
     QDltPlugin *item = 0;
     QDltMsg qmsg;
 
+    /* in tail mode received messages are added to the tail ring in read() */
+    if(tableModel->isTailMode())
+    {
+        if (!draw_timer.isActive())
+            draw_timer.start(draw_interval);
+        return;
+    }
+
     activeDecoderPlugins = pluginManager.getDecoderPlugins();
     activeViewerPlugins = pluginManager.getViewerPlugins();
+
+    /* received messages are indexed, decoded and filtered by the live indexer thread */
+    if(liveIndexer->isActive())
+    {
+        liveIndexer->dataWritten(!activeViewerPlugins.isEmpty() || !viewerWorkers.isEmpty());
+        return;
+    }
+
     pluginsEnabled = dltIndexer->getPluginsEnabled();
 
     /* read received messages in DLT file parser and update DLT message list view */
@@ -3429,18 +3612,36 @@ void MainWindow::updateIndex()
         }
     }
 
+    /* viewer plugins processing batches get the messages after all were decoded */
+    QList<QDltPlugin*> singleViewerPlugins;
+    QList<QDltPlugin*> batchViewerPlugins;
+    for(int i = 0; i < activeViewerPlugins.size(); i++)
+    {
+        if(viewerWorkers.contains(activeViewerPlugins[i]))
+            continue;
+        if(activeViewerPlugins[i]->isViewerBatch())
+            batchViewerPlugins.append(activeViewerPlugins[i]);
+        else
+            singleViewerPlugins.append(activeViewerPlugins[i]);
+    }
+    bool collectMsgs = !batchViewerPlugins.isEmpty() || !viewerWorkers.isEmpty();
+    QVector<QDltMsg> batchMsgs;
+    QVector<QDltMsg> batchDecodedMsgs;
+
     for(int num=oldsize;num<qfile.size();num++)
     {
         qmsg.setMsg(qfile.getMsg(num));
 
-        for(int i = 0; i < activeViewerPlugins.size(); i++){
-            item = activeViewerPlugins.at(i);
+        for(int i = 0; i < singleViewerPlugins.size(); i++){
+            item = singleViewerPlugins.at(i);
             item->updateMsg(num,qmsg);
         }
+        if(collectMsgs)
+            batchMsgs.append(qmsg);
 
      if ( pluginsEnabled == true )
       {
-        pluginManager.decodeMsg(qmsg,silentMode);
+        pluginManager.decodeMsgCached(qmsg,num,silentMode);
       }
 
       if(qfile.checkFilter(qmsg))
@@ -3448,13 +3649,17 @@ void MainWindow::updateIndex()
             qfile.addFilterIndex(num);
        }
 
-        for(int i = 0; i < activeViewerPlugins.size(); i++)
+        for(int i = 0; i < singleViewerPlugins.size(); i++)
         {
-            item = activeViewerPlugins[i];
+            item = singleViewerPlugins[i];
             item->updateMsgDecoded(num,qmsg);
         }
+        if(collectMsgs)
+            batchDecodedMsgs.append(qmsg);
     }
 
+    updateViewerBatches(batchViewerPlugins, oldsize, batchMsgs, batchDecodedMsgs);
+
     if (!draw_timer.isActive())
         draw_timer.start(draw_interval);
 
@@ -3469,8 +3674,262 @@ void MainWindow::updateIndex()
 
 }
 
+void MainWindow::writeOutputMessage(const char *header, qint64 headerSize, const char *data, qint64 dataSize)
+{
+    /* during a compressed recording the file must only be written by the recording writer,
+       the whole message is written at once, so blocks always end at a message boundary */
+    if(recordingWriter.isOpen())
+    {
+        QByteArray bufferMessage;
+        bufferMessage.reserve(headerSize+dataSize);
+        bufferMessage.append(header,headerSize);
+        bufferMessage.append(data,dataSize);
+        recordingWriter.write(bufferMessage.constData(),bufferMessage.size());
+        return;
+    }
+
+    // https://bugreports.qt-project.org/browse/QTBUG-26069
+    outputfile.seek(outputfile.size());
+    appendIndexCache(outputfile.size(),headerSize+dataSize);
+    outputfile.write(header,headerSize);
+    outputfile.write(data,dataSize);
+}
+
+void MainWindow::appendIndexCache(qint64 pos, qint64 size)
+{
+    /* compressed recordings have no index cache, while the indexer is running it writes the cache itself */
+    if(recordingWriter.isOpen() || dltIndexer->isRunning())
+    {
+        indexCacheWriter.close();
+        return;
+    }
+
+    indexCacheWriter.append(outputfile.fileName(),pos,size);
+}
+
+void MainWindow::copyIndexCache(const QString &fromFileName, const QString &toFileName)
+{
+    if(!settings->filterCache)
+        return;
+
+    indexCacheWriter.close();
+    QFile::copy(settings->filterCacheName + "/" + DltFileIndexer::filenameIndexCache(fromFileName),
+                settings->filterCacheName + "/" + DltFileIndexer::filenameIndexCache(toFileName));
+}
+
+void MainWindow::startLiveIndexer()
+{
+    /* only a single uncompressed log file written while receiving can be indexed in the background */
+    if(tableModel->isTailMode() || !outputfile.isOpen() || qfile.getNumberOfFiles() != 1 || qfile.isCompressed(0) || qfile.getFileName(0) != outputfile.fileName())
+        return;
+
+    liveIndexer->startIndexing(outputfile.fileName(), qfile.fileSize(), qfile.size(), qfile.getFilterList(), qfile.isFilter(), dltIndexer->getPluginsEnabled());
+}
+
+void MainWindow::applyTailMode()
+{
+    tailRing.setMaxMessages(settings->tailMaxMessages);
+    tailRing.setMaxAge(settings->tailMaxSeconds);
+
+    if((settings->tailMode != 0) == tableModel->isTailMode())
+    {
+        tableModel->modelChanged();
+        return;
+    }
+
+    if(settings->tailMode)
+    {
+        enterTailMode();
+    }
+    else
+    {
+        /* index the messages recorded while in tail mode */
+        leaveTailMode();
+        reloadLogFile();
+    }
+}
+
+void MainWindow::enterTailMode()
+{
+    /* received messages are not indexed anymore */
+    liveIndexer->stopIndexing();
+    clearSelection();
+    tailRing.clear();
+    tableModel->setTailRing(&tailRing);
+    tableModel->modelChanged();
+    updateTailModeActions();
+}
+
+void MainWindow::leaveTailMode()
+{
+    if(!tableModel->isTailMode())
+        return;
+
+    /* the caller reloads the log file, until then the table shows the last index of the log file */
+    clearSelection();
+    tableModel->setTailRing(NULL);
+    tableModel->modelChanged();
+    tailRing.clear();
+    updateTailModeActions();
+
+    if(settings->tailMode)
+        statusBar()->showMessage("Tail mode left, enable it again in the settings", 10000);
+}
+
+void MainWindow::updateTailModeActions()
+{
+    /* search, jump to and export work on the index of the log file, which is not updated in tail mode */
+    bool enabled = !tableModel->isTailMode();
+
+    ui->searchToolbar->setEnabled(enabled);
+    ui->action_menuSearch_Find->setEnabled(enabled);
+    ui->actionJump_To->setEnabled(enabled);
+    ui->actionExport->setEnabled(enabled);
+    m_shortcut_searchnext->setEnabled(enabled);
+    m_shortcut_searchprev->setEnabled(enabled);
+}
+
+void MainWindow::copyTailSelection(const QModelIndexList &list)
+{
+    /* in tail mode the rows are messages of the ring, the sequence number is shown as index */
+    QList<int> rows;
+    for(int num=0;num<list.size();num++)
+    {
+        if(!rows.contains(list[num].row()))
+            rows.append(list[num].row());
+    }
+    qSort(rows);
+
+    QDltExportFormatter formatter(QDltExportFormatter::FormatAscii);
+    QString text;
+    for(int num=0;num<rows.size();num++)
+    {
+        qint64 sequence = tableModel->getTailSequence(rows[num]);
+        const QDltMsg *msg = tailRing.getMsg(sequence);
+        if(msg)
+        {
+            QDltMsg copy = *msg;
+            formatter.textLine((int)sequence,copy,text);
+        }
+    }
+
+    QApplication::clipboard()->setText(text);
+}
+
+void MainWindow::appendTailMsg(QDltMsg msg, const DltStorageHeader &str)
+{
+    /* set the storage header information, as if the message was read from the log file */
+    msg.setTime(str.seconds);
+    msg.setMicroseconds(str.microseconds);
+    if(msg.getEcuid().isEmpty())
+        msg.setEcuid(QString::fromLatin1(str.ecu,qstrnlen(str.ecu,sizeof(str.ecu))));
+
+    if(pluginsEnabled)
+        pluginManager.decodeMsg(msg,!OptManager::getInstance()->issilentMode());
+
+    if(qfile.checkFilter(msg))
+        tailRing.append(msg);
+}
+
+void MainWindow::liveIndexUpdated()
+{
+    if (!draw_timer.isActive())
+        draw_timer.start(draw_interval);
+}
+
+void MainWindow::applyLiveIndex()
+{
+    QVector<qint64> positions;
+    QVector<int> filterIndexes;
+    QVector<QDltMsg> msgs;
+    QVector<QDltMsg> decodedMsgs;
+
+    if(!liveIndexer->takeIncrement(positions, filterIndexes, msgs, decodedMsgs))
+        return;
+
+    int oldsize = qfile.size();
+    qfile.appendDltIndex(positions);
+    for(int num=0;num<filterIndexes.size();num++)
+        qfile.addFilterIndex(filterIndexes[num]);
+
+    /* messages are only collected while viewer plugins are active */
+    QList<QDltPlugin*> activeViewerPlugins = pluginManager.getViewerPlugins();
+    if(msgs.isEmpty() || (activeViewerPlugins.isEmpty() && viewerWorkers.isEmpty()))
+        return;
+
+    for(int i = 0; i < activeViewerPlugins.size(); i++)
+        activeViewerPlugins[i]->updateFileStart();
+
+    QList<QDltPlugin*> singleViewerPlugins;
+    QList<QDltPlugin*> batchViewerPlugins;
+    for(int i = 0; i < activeViewerPlugins.size(); i++)
+    {
+        if(viewerWorkers.contains(activeViewerPlugins[i]))
+            continue;
+        if(activeViewerPlugins[i]->isViewerBatch())
+            batchViewerPlugins.append(activeViewerPlugins[i]);
+        else
+            singleViewerPlugins.append(activeViewerPlugins[i]);
+    }
+
+    for(int num=0;num<msgs.size();num++)
+    {
+        for(int i = 0; i < singleViewerPlugins.size(); i++)
+            singleViewerPlugins[i]->updateMsg(oldsize+num,msgs[num]);
+        for(int i = 0; i < singleViewerPlugins.size(); i++)
+            singleViewerPlugins[i]->updateMsgDecoded(oldsize+num,decodedMsgs[num]);
+    }
+
+    updateViewerBatches(batchViewerPlugins, oldsize, msgs, decodedMsgs);
+
+    for(int i = 0; i < activeViewerPlugins.size(); i++)
+        activeViewerPlugins[i]->updateFileFinish();
+}
+
+void MainWindow::updateViewerBatches(const QList<QDltPlugin*> &plugins, int firstIndex, QVector<QDltMsg> &msgs, QVector<QDltMsg> &decodedMsgs)
+{
+    if(msgs.isEmpty())
+        return;
+
+    /* the worker threads get the messages without waiting for them */
+    if(!viewerWorkers.isEmpty())
+    {
+        QSharedPointer<DltViewerPluginBatch> workerBatch = QSharedPointer<DltViewerPluginBatch>::create();
+        workerBatch->update = true;
+        workerBatch->indexes.reserve(msgs.size());
+        for(int num = 0; num < msgs.size(); num++)
+            workerBatch->indexes.append(firstIndex + num);
+        workerBatch->msgs = msgs;
+        workerBatch->decodedMsgs = decodedMsgs;
+        viewerWorkers.broadcast(workerBatch);
+    }
+
+    if(plugins.isEmpty())
+        return;
+
+    for(int start = 0; start < msgs.size(); start += QDLT_VIEWER_BATCH_SIZE)
+    {
+        int end = qMin(start + QDLT_VIEWER_BATCH_SIZE, msgs.size());
+        QDltMsgBatch batch;
+        QDltMsgBatch decodedBatch;
+        batch.reserve(end - start);
+        decodedBatch.reserve(end - start);
+        for(int num = start; num < end; num++)
+        {
+            batch.append(qMakePair(firstIndex + num, &msgs[num]));
+            decodedBatch.append(qMakePair(firstIndex + num, &decodedMsgs[num]));
+        }
+
+        for(int i = 0; i < plugins.size(); i++)
+            plugins[i]->updateMsgs(batch);
+        for(int i = 0; i < plugins.size(); i++)
+            plugins[i]->updateMsgsDecoded(decodedBatch);
+    }
+}
+
 void MainWindow::draw_timeout()
 {
+    applyLiveIndex();
     drawUpdatedView();
 }
 
@@ -3479,14 +3938,16 @@ void MainWindow::drawUpdatedView()
 {
 
     statusByteErrorsReceived->setText(QString("Recv Errors: %L1").arg(totalByteErrorsRcvd));
+    statusDropsReceived->setText(QString("Recv Drops: %L1").arg(totalDropsRcvd));
     statusBytesReceived->setText(QString("Recv: %L1").arg(totalBytesRcvd));
     statusSyncFoundReceived->setText(QString("Sync found: %L1").arg(totalSyncFoundRcvd));
 
-    tableModel->modelChanged();
+    /* only new rows are inserted, a complete layout change is done on filter reload */
+    bool rowsAdded = tableModel->modelRowsAppended();
 
     //Line below would resize the payload column automatically so that the whole content is readable
     //ui->tableView->resizeColumnToContents(11); //Column 11 is the payload column
-    if(settings->autoScroll) {
+    if(settings->autoScroll && rowsAdded) {
         ui->tableView->scrollToBottom();
     }
 
@@ -3505,6 +3966,11 @@ void MainWindow::onTableViewSelectionChanged(const QItemSelection & selected, co
             scrollButton->setChecked(false);
             ui->tableView->setAutoScroll(false);
         }
+
+        /* viewer plugins get the index of the message in the log file, which is not known in tail mode */
+        if(tableModel->isTailMode())
+            return;
+
         pluginsEnabled = dltIndexer->getPluginsEnabled();
         QModelIndex index =  selected[0].topLeft();
         QDltPlugin *item = 0;
@@ -3539,7 +4005,7 @@ void MainWindow::onTableViewSelectionChanged(const QItemSelection & selected, co
 
         if ( pluginsEnabled == true )
         {
-        pluginManager.decodeMsg(msg,!OptManager::getInstance()->issilentMode());
+        pluginManager.decodeMsgCached(msg,msgIndex,!OptManager::getInstance()->issilentMode());
         }
 
         for(int i = 0; i < activeViewerPlugins.size(); i++){
@@ -3843,11 +4309,17 @@ void MainWindow::controlMessage_SendControlMessage(EcuItem* ecuitem,DltMessage &
         {
             if (settings->writeControl)
             {
-                // https://bugreports.qt-project.org/browse/QTBUG-26069
-                outputfile.seek(outputfile.size());
-                outputfile.write((const char*)msg.headerbuffer,msg.headersize);
-                outputfile.write((const char*)msg.databuffer,msg.datasize);
+                writeOutputMessage((const char*)msg.headerbuffer,msg.headersize,(const char*)msg.databuffer,msg.datasize);
                 outputfile.flush();
+
+                /* in tail mode the written message is shown from the ring, as the log file is not indexed */
+                if(tableModel->isTailMode())
+                {
+                    data.append((const char*)msg.headerbuffer,msg.headersize);
+                    data.append((const char*)msg.databuffer,msg.datasize);
+                    if(qmsg.setMsg(data))
+                        appendTailMsg(qmsg,*msg.storageheader);
+                }
             }
         }
 
@@ -3919,11 +4391,17 @@ void MainWindow::controlMessage_WriteControlMessage(DltMessage &msg, QString app
         {
             if (settings->writeControl)
             {
-                // https://bugreports.qt-project.org/browse/QTBUG-26069
-                outputfile.seek(outputfile.size());
-                outputfile.write((const char*)msg.headerbuffer,msg.headersize);
-                outputfile.write((const char*)msg.databuffer,msg.datasize);
+                writeOutputMessage((const char*)msg.headerbuffer,msg.headersize,(const char*)msg.databuffer,msg.datasize);
                 outputfile.flush();
+
+                /* in tail mode the written message is shown from the ring, as the log file is not indexed */
+                if(tableModel->isTailMode())
+                {
+                    data.append((const char*)msg.headerbuffer,msg.headersize);
+                    data.append((const char*)msg.databuffer,msg.datasize);
+                    if(qmsg.setMsg(data))
+                        appendTailMsg(qmsg,*msg.storageheader);
+                }
             }
         }
 
@@ -4766,6 +5244,19 @@ void MainWindow::on_action_menuHelp_Info_triggered()
 }
 
 
+void MainWindow::on_action_menuHelp_Diagnostics_triggered()
+{
+    diagnosticsDialog->show();
+    diagnosticsDialog->raise();
+    diagnosticsDialog->activateWindow();
+}
+
+void MainWindow::on_action_menuHelp_Profile_toggled(bool checked)
+{
+    profileDialog->setProfiling(checked);
+    DltSettingsManager::getInstance()->setValue("startup/profileIndexing", checked);
+}
+
 void MainWindow::on_action_menuHelp_Command_Line_triggered()
 {
     // Please copy changes to OptManager::getInstance().cpp - printUsage()
@@ -5162,6 +5653,9 @@ void MainWindow::stateChangedTCP(QAbstractSocket::SocketState socketState)
 
 void MainWindow::on_action_menuSearch_Find_triggered()
 {
+    if(tableModel->isTailMode())
+        return;
+
     //qDebug() << "on_action_menuSearch_Find_triggered" << __LINE__;
     searchDlg->open();
     searchDlg->selectText();
@@ -5196,24 +5690,13 @@ void MainWindow::loadPlugins()
 
       PluginItem* item = new PluginItem(0,plugin);
 
+      /* only enabled plugins are loaded, the others are loaded on first use */
       plugin->setMode((QDltPlugin::Mode) DltSettingsManager::getInstance()->value("plugin/pluginmodefor"+plugin->getName(),QVariant(QDltPlugin::ModeDisable)).toInt());
+      QString loadError = plugin->takeLoadError();
+      if(!loadError.isEmpty())
+          QMessageBox::warning(0, QString("DLT Viewer"), loadError);
       qDebug() << "Loading plugin" << plugin->getName() << plugin->getPluginVersion();
-      if(plugin->isViewer())
-      {
-        item->widget = plugin->initViewer();
-        item->dockWidget = new MyPluginDockWidget(item,this);
-        item->dockWidget->setAllowedAreas(Qt::AllDockWidgetAreas);
-        item->dockWidget->setFeatures(QDockWidget::DockWidgetClosable | QDockWidget::DockWidgetMovable | QDockWidget::DockWidgetFloatable);
-        item->dockWidget->setWidget(item->widget);
-        item->dockWidget->setObjectName(plugin->getName());
-
-        addDockWidget(Qt::LeftDockWidgetArea, item->dockWidget);
-
-        if(plugin->getMode() != QDltPlugin::ModeShow)
-        {
-            item->dockWidget->hide();
-        }
-      }
+      initPluginViewer(item);
 
       item->update();
       project.plugin->addTopLevelItem(item);
@@ -5226,6 +5709,29 @@ void MainWindow::loadPlugins()
     pluginManager.initControl(&qcontrol);
 }
 
+void MainWindow::initPluginViewer(PluginItem *item)
+{
+    QDltPlugin *plugin = item->getPlugin();
+
+    /* the widget is created when the plugin is loaded */
+    if(item->dockWidget || !plugin->isLoaded() || !plugin->isViewer())
+        return;
+
+    item->widget = plugin->initViewer();
+    item->dockWidget = new MyPluginDockWidget(item,this);
+    item->dockWidget->setAllowedAreas(Qt::AllDockWidgetAreas);
+    item->dockWidget->setFeatures(QDockWidget::DockWidgetClosable | QDockWidget::DockWidgetMovable | QDockWidget::DockWidgetFloatable);
+    item->dockWidget->setWidget(item->widget);
+    item->dockWidget->setObjectName(plugin->getName());
+
+    addDockWidget(Qt::LeftDockWidgetArea, item->dockWidget);
+
+    if(plugin->getMode() != QDltPlugin::ModeShow)
+    {
+        item->dockWidget->hide();
+    }
+}
+
 void MainWindow::updatePluginsECUList()
 {
     QStringList list;
@@ -5254,6 +5760,14 @@ void MainWindow::updatePlugin(PluginItem *item)
     item->takeChildren();
     bool ret = true;
 
+    /* the plugin was loaded on first use or failed to load */
+    QString loadError = item->getPlugin()->takeLoadError();
+    if(!loadError.isEmpty())
+    {
+        ErrorMessage(QMessageBox::Critical,"Plugin Error: "+item->getName(),loadError);
+    }
+    initPluginViewer(item);
+
     QString err_text = item->getPlugin()->error();
     QString conffilename = item->getFilename();
 
@@ -5583,11 +6097,22 @@ void MainWindow::filterAddTable() {
         }
     }
 
-    data = qfile.getMsgFilter(index.row());
-    msg.setMsg(data);
+    if(tableModel->isTailMode())
+    {
+        /* messages of the tail ring are decoded already */
+        const QDltMsg *tailMsg = tailRing.getMsg(tableModel->getTailSequence(index.row()));
+        if(!tailMsg)
+            return;
+        msg = *tailMsg;
+    }
+    else
+    {
+        data = qfile.getMsgFilter(index.row());
+        msg.setMsg(data);
 
-    /* decode message if necessary */
-    iterateDecodersForMsg(msg,!OptManager::getInstance()->issilentMode());
+        /* decode message if necessary */
+        iterateDecodersForMsg(msg,!OptManager::getInstance()->issilentMode());
+    }
 
     /* show filter dialog */
     FilterDialog dlg;
@@ -6270,6 +6795,7 @@ void MainWindow::markerSignal()
 void MainWindow::reopenFileSignal()
 {
     applyConfigEnabled(false);
+    leaveTailMode();
     filterUpdate();
 
     // force always reparsing of log file
@@ -6278,6 +6804,9 @@ void MainWindow::reopenFileSignal()
 
 bool MainWindow::jump_to_line(int line)
 {
+    /* the line is an index of the log file, which is not shown in tail mode */
+    if(tableModel->isTailMode())
+        return false;
 
     int row = nearest_line(line);
     int column = -1;
@@ -6318,6 +6847,9 @@ bool MainWindow::jump_to_line(int line)
 
 void MainWindow::on_actionJump_To_triggered()
 {
+    if(tableModel->isTailMode())
+        return;
+
     JumpToDialog dlg(this);
     int min = 0;
     int max = qfile.size()-1;
@@ -6451,6 +6983,10 @@ void MainWindow::on_applyConfig_clicked()
 {
     syncCheckBoxesAndMenu();
     applyConfigEnabled(false);
+
+    /* the tail ring holds only messages matching the old filters */
+    leaveTailMode();
+
     filterUpdate();
     reloadLogFile(true);
 }
@@ -6464,6 +7000,11 @@ void MainWindow::clearSelection()
 void MainWindow::saveSelection()
 {
     previousSelection.clear();
+
+    /* rows of the tail ring have no position in the log file */
+    if(tableModel->isTailMode())
+        return;
+
     /* Store old selections */
     QModelIndexList rows = ui->tableView->selectionModel()->selectedRows();
 
@@ -6577,8 +7118,10 @@ void MainWindow::on_comboBoxFilterSelection_activated(const QString &arg1)
         /* if filter index already stored default filter cache, use index from cache */
         QDltFilterIndex *index = defaultFilter.defaultFilterIndex[ui->comboBoxFilterSelection->currentIndex()-1];
 
-        /* check if filename and qfile size is matching cache entry */
-        if(index->allIndexSize == qfile.size() &&
+        /* check if filename and qfile size is matching cache entry,
+           in tail mode the index of the log file is not up to date */
+        if(!tableModel->isTailMode() &&
+           index->allIndexSize == qfile.size() &&
            index->dltFileName == qfile.getFileName())
         {
             /* save selection */
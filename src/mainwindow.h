@@ -38,6 +38,10 @@
 #include "dltsettingsmanager.h"
 #include "filterdialog.h"
 #include "dltfileindexer.h"
+#include "dltliveindexer.h"
+#include "dltindexcachewriter.h"
+#include "diagnosticsdialog.h"
+#include "profiledialog.h"
 #include "workingdirectory.h"
 #include "exporterdialog.h"
 #include <QCompleter>
@@ -129,6 +133,8 @@ private:
 
     QDltControl qcontrol;
     QFile outputfile;
+    QDltCompressedWriter recordingWriter;
+    DltIndexCacheWriter indexCacheWriter;
     bool outputfileIsTemporary;
     bool outputfileIsFromCLI;
     TableModel *tableModel;
@@ -141,11 +147,13 @@ private:
     QLabel *statusBytesReceived;
     QLabel *statusByteErrorsReceived;
     QLabel *statusSyncFoundReceived;
+    QLabel *statusDropsReceived;
     QProgressBar *statusProgressBar;
 
     unsigned long totalBytesRcvd;
     unsigned long totalByteErrorsRcvd;
     unsigned long totalSyncFoundRcvd;
+    unsigned long totalDropsRcvd;
 
     /* Search */
     SearchDialog *searchDlg;
@@ -207,6 +215,16 @@ private:
 
     /* dlt-file Indexer with cancel cabability */
     DltFileIndexer *dltIndexer;
+    DltLiveIndexer *liveIndexer;
+
+    /* Viewer plugins running in their own worker threads */
+    DltViewerPluginWorkers viewerWorkers;
+
+    /* Performance metrics view and periodic JSON dump */
+    DiagnosticsDialog *diagnosticsDialog;
+
+    /* Cost of plugins and filters of the last indexing run */
+    ProfileDialog *profileDialog;
 
     /* Color for blinking 'Apply changes'-button */
     QColor pulseButtonColor;
@@ -271,6 +289,7 @@ private:
     void loadPlugins();
     void updatePluginsECUList();
     void updatePlugins();
+    void initPluginViewer(PluginItem *item);
     void updatePlugin(PluginItem *item);
     void contextLoadingFile(QDltMsg &msg);
     void versionString(QDltMsg &msg);
@@ -281,6 +300,20 @@ private:
     void checkConnectionState();
     void read(EcuItem *ecuitem);
     void updateIndex();
+    void startLiveIndexer();
+
+    /* add a message written to the uncompressed log file to the index cache */
+    void writeOutputMessage(const char *header, qint64 headerSize, const char *data, qint64 dataSize);
+    void appendIndexCache(qint64 pos, qint64 size);
+    void copyIndexCache(const QString &fromFileName, const QString &toFileName);
+    void applyTailMode();
+    void enterTailMode();
+    void leaveTailMode();
+    void updateTailModeActions();
+    void copyTailSelection(const QModelIndexList &list);
+    void appendTailMsg(QDltMsg msg, const DltStorageHeader &str);
+    void applyLiveIndex();
+    void updateViewerBatches(const QList<QDltPlugin*> &plugins, int firstIndex, QVector<QDltMsg> &msgs, QVector<QDltMsg> &decodedMsgs);
     void drawUpdatedView();
 
      void syncCheckBoxesAndMenu();
@@ -418,6 +451,8 @@ private slots:
     void on_action_menuHelp_Support_triggered();
     void on_action_menuHelp_Info_triggered();
     void on_action_menuHelp_Command_Line_triggered();
+    void on_action_menuHelp_Diagnostics_triggered();
+    void on_action_menuHelp_Profile_toggled(bool checked);
 
     // Config methods
     void on_action_menuConfig_Context_Delete_triggered();
@@ -476,6 +511,8 @@ private slots:
     void readyRead();
     void timeout();
     void draw_timeout();
+    void liveIndexUpdated();
+    void recordingBlockWritten(qint64 uncompressedSize);
     void connectAll();
     void disconnectAll();
     void applySettings();
@@ -540,6 +577,9 @@ public:
     /* DLT file handling */
     QDltFile qfile;
 
+    /* last received messages shown in tail mode */
+    QDltMsgRing tailRing;
+
     /* Loading and handling all plugins */
     QDltPluginManager pluginManager;
 
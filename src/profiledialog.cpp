@@ -0,0 +1,162 @@
+#include <QTableWidget>
+#include <QHeaderView>
+#include <QLabel>
+#include <QPushButton>
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+
+#include "profiledialog.h"
+#include "qdltmetrics.h"
+
+/* Histogram name prefixes of the profiled calls and their type shown in the table */
+static const char *profilePrefixes[][2] = {
+    { "decode.", "Decoder" },
+    { "viewer.", "Viewer" },
+    { "filter.", "Filter" }
+};
+
+ProfileDialog::ProfileDialog(QWidget *parent) :
+    QDialog(parent)
+{
+    setWindowTitle("Plugin and Filter Profile");
+    resize(750, 400);
+
+    table = new QTableWidget(this);
+    table->setColumnCount(7);
+    table->setHorizontalHeaderLabels(QStringList() << "Type" << "Name" << "Calls" << "Total ms" << "Per call us" << "Share %" << "Hit ratio %");
+    table->horizontalHeader()->setSectionResizeMode(1, QHeaderView::Stretch);
+    table->verticalHeader()->hide();
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+
+    labelSummary = new QLabel(this);
+    QPushButton *buttonClose = new QPushButton("Close", this);
+
+    QHBoxLayout *buttonLayout = new QHBoxLayout();
+    buttonLayout->addWidget(labelSummary, 1);
+    buttonLayout->addWidget(buttonClose);
+
+    QVBoxLayout *layout = new QVBoxLayout(this);
+    layout->addWidget(table);
+    layout->addLayout(buttonLayout);
+
+    connect(buttonClose, SIGNAL(clicked()), this, SLOT(close()));
+
+    profiling = false;
+    running = false;
+}
+
+ProfileDialog::~ProfileDialog()
+{
+    setProfiling(false);
+}
+
+void ProfileDialog::setProfiling(bool enable)
+{
+    if(enable == profiling)
+        return;
+
+    QDltMetrics::requestTiming(enable);
+    profiling = enable;
+    running = false;
+}
+
+void ProfileDialog::startRun()
+{
+    if(!profiling)
+        return;
+
+    baseline = QDltMetrics::instance()->snapshot()["histograms"].toObject();
+    runTimer.start();
+    running = true;
+}
+
+void ProfileDialog::finishRun()
+{
+    if(!profiling || !running)
+        return;
+    running = false;
+
+    /* costs of this run are the difference to the totals at the start of the run */
+    QJsonObject histograms = QDltMetrics::instance()->snapshot()["histograms"].toObject();
+    QList<QStringList> names;
+    QList<qint64> calls;
+    QList<double> totals;
+    QList<double> hitRatios;
+    double sumMs = 0;
+    qint64 sumCalls = 0;
+
+    for(QJsonObject::const_iterator it = histograms.constBegin(); it != histograms.constEnd(); ++it)
+    {
+        for(unsigned int num = 0; num < sizeof(profilePrefixes) / sizeof(profilePrefixes[0]); num++)
+        {
+            QString prefix = profilePrefixes[num][0];
+            if(!it.key().startsWith(prefix))
+                continue;
+
+            QJsonObject current = it.value().toObject();
+            QJsonObject before = baseline[it.key()].toObject();
+            qint64 count = (qint64) (current["count"].toDouble() - before["count"].toDouble());
+            if(count <= 0)
+                break;
+            qint64 hits = (qint64) (current["hits"].toDouble() - before["hits"].toDouble());
+            double totalMs = current["totalMs"].toDouble() - before["totalMs"].toDouble();
+
+            names.append(QStringList() << profilePrefixes[num][1] << it.key().mid(prefix.size()));
+            calls.append(count);
+            totals.append(totalMs);
+            /* viewer callbacks have no result */
+            hitRatios.append(prefix == "viewer." ? -1.0 : 100.0 * hits / count);
+            sumMs += totalMs;
+            sumCalls += count;
+            break;
+        }
+    }
+
+    table->setSortingEnabled(false);
+    table->setRowCount(names.size());
+    for(int row = 0; row < names.size(); row++)
+    {
+        addRow(row, names[row][0], names[row][1], calls[row], totals[row],
+               sumMs > 0 ? 100.0 * totals[row] / sumMs : 0.0, hitRatios[row]);
+    }
+    table->setSortingEnabled(true);
+    table->sortByColumn(3, Qt::DescendingOrder);
+    table->resizeColumnsToContents();
+
+    labelSummary->setText(QString("Indexing run %L1 ms, profiled %L2 ms in %L3 calls")
+                          .arg(runTimer.elapsed()).arg(sumMs, 0, 'f', 1).arg(sumCalls));
+
+    show();
+    raise();
+}
+
+void ProfileDialog::addRow(int row, const QString &type, const QString &name, qint64 calls, double totalMs, double share, double hitRatio)
+{
+    /* numbers are stored as numbers, so the columns are sorted numerically */
+    QTableWidgetItem *item;
+
+    table->setItem(row, 0, new QTableWidgetItem(type));
+    table->setItem(row, 1, new QTableWidgetItem(name));
+
+    item = new QTableWidgetItem();
+    item->setData(Qt::DisplayRole, calls);
+    table->setItem(row, 2, item);
+
+    item = new QTableWidgetItem();
+    item->setData(Qt::DisplayRole, qRound(totalMs * 10) / 10.0);
+    table->setItem(row, 3, item);
+
+    item = new QTableWidgetItem();
+    item->setData(Qt::DisplayRole, qRound(totalMs * 1000 * 100 / calls) / 100.0);
+    table->setItem(row, 4, item);
+
+    item = new QTableWidgetItem();
+    item->setData(Qt::DisplayRole, qRound(share * 10) / 10.0);
+    table->setItem(row, 5, item);
+
+    item = new QTableWidgetItem();
+    if(hitRatio >= 0)
+        item->setData(Qt::DisplayRole, qRound(hitRatio * 10) / 10.0);
+    table->setItem(row, 6, item);
+}
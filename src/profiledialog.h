@@ -0,0 +1,44 @@
+#ifndef PROFILEDIALOG_H
+#define PROFILEDIALOG_H
+
+#include <QDialog>
+#include <QElapsedTimer>
+#include <QJsonObject>
+
+class QTableWidget;
+class QLabel;
+
+/* Shows the time spent in each decoder plugin, viewer plugin callback and filter
+ * during the last indexing run, based on the histograms of QDltMetrics.
+ * The dialog is shown after each indexing run while profiling is enabled. */
+class ProfileDialog : public QDialog
+{
+    Q_OBJECT
+
+public:
+    explicit ProfileDialog(QWidget *parent = 0);
+    ~ProfileDialog();
+
+    /* Enable profiling, durations are measured as long as profiling is enabled */
+    void setProfiling(bool enable);
+    bool isProfiling() const { return profiling; }
+
+    /* Remember the current totals at the start of an indexing run */
+    void startRun();
+
+    /* Show the costs since the start of the indexing run */
+    void finishRun();
+
+private:
+    void addRow(int row, const QString &type, const QString &name, qint64 calls, double totalMs, double share, double hitRatio);
+
+    QTableWidget *table;
+    QLabel *labelSummary;
+
+    bool profiling;
+    bool running;
+    QElapsedTimer runTimer;
+    QJsonObject baseline;
+};
+
+#endif // PROFILEDIALOG_H
@@ -91,6 +91,9 @@ public:
     QUdpSocket udpsocket;
     QAbstractSocket * socket;
 
+    /* receiver thread for UDP, if supported on this system */
+    QDltUDPReceiver udpReceiver;
+
     QSerialPort *m_serialport;
 
     /* connection status */
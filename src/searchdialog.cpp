@@ -285,8 +285,8 @@ void SearchDialog::findProcess(int searchLine, int searchBorder, QRegExp &search
         /* get the message with the selected item id */
         buf = file->getMsgFilter(searchLine);
         msg.setMsg(buf);
-        if(DltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool())
-            pluginManager->decodeMsg(msg,silentMode);
+        if(DltSettingsManager::getInstance()->snapshot()->pluginsEnabled)
+            pluginManager->decodeMsgCached(msg,file->getMsgFilterPos(searchLine),silentMode);
 
         bool pluginFound = false;
         headerText.clear();
@@ -774,8 +774,7 @@ void SearchDialog::textEditedFromToolbar(QString newText){
 
 void SearchDialog::on_pushButtonColor_clicked()
 {
-    QString color = DltSettingsManager::getInstance()->value("other/searchResultColor", QString("#00AAFF")).toString();
-    QColor oldColor(color);
+    QColor oldColor = DltSettingsManager::getInstance()->snapshot()->searchResultColor;
     QColor newColor = QColorDialog::getColor(oldColor, this, "Pick color for Search Highlight");
     if(!newColor.isValid())
     {
@@ -789,8 +788,7 @@ void SearchDialog::on_pushButtonColor_clicked()
 
 void SearchDialog::updateColorbutton()
 {
-    QString color = DltSettingsManager::getInstance()->value("other/searchResultColor", QString("#00AAFF")).toString();
-    QColor hlColor(color);
+    QColor hlColor = DltSettingsManager::getInstance()->snapshot()->searchResultColor;
     QPixmap px(12, 12);
     px.fill(hlColor);
     ui->pushButtonColor->setIcon(px);
@@ -66,8 +66,8 @@ QVariant SearchTableModel::data(const QModelIndex &index, int role) const
             return QVariant();
         }
 
-        if(DltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool())
-            pluginManager->decodeMsg(msg,!OptManager::getInstance()->issilentMode());
+        if(DltSettingsManager::getInstance()->snapshot()->pluginsEnabled)
+            pluginManager->decodeMsgCached(msg,m_searchResultList.at(index.row()),!OptManager::getInstance()->issilentMode());
 
         switch(index.column())
         {
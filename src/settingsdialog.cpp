@@ -112,6 +112,10 @@ SettingsDialog::SettingsDialog(QDltFile *_qFile, QWidget *parent):
 
     maxFileSizeMB = 0;
     appendDateTime = 0;
+    compressRecording = 0;
+    tailMode = 0;
+    tailMaxMessages = QDLT_MSG_RING_DEFAULT_SIZE;
+    tailMaxSeconds = 0;
 }
 
 SettingsDialog::SettingsDialog(QWidget *parent) :
@@ -232,6 +236,10 @@ void SettingsDialog::writeDlg()
     ui->groupBoxMaxFileSizeMB->setChecked(maxFileSizeMB);
     ui->lineEditMaxFileSizeMB->setText(QString("%1").arg(maxFileSizeMB));
     ui->checkBoxAppendDateTime->setCheckState(appendDateTime?Qt::Checked:Qt::Unchecked);
+    ui->checkBoxCompressRecording->setCheckState(compressRecording?Qt::Checked:Qt::Unchecked);
+    ui->groupBoxTailMode->setChecked(tailMode);
+    ui->spinBoxTailMaxMessages->setValue(tailMaxMessages);
+    ui->spinBoxTailMaxSeconds->setValue(tailMaxSeconds);
 
     /* table */
     ui->spinBoxFontSize->setValue(fontSize);
@@ -403,6 +411,10 @@ void SettingsDialog::readDlg()
     else
         maxFileSizeMB = 0;
     appendDateTime = (ui->checkBoxAppendDateTime->checkState() == Qt::Checked);
+    compressRecording = (ui->checkBoxCompressRecording->checkState() == Qt::Checked);
+    tailMode = ui->groupBoxTailMode->isChecked();
+    tailMaxMessages = ui->spinBoxTailMaxMessages->value();
+    tailMaxSeconds = ui->spinBoxTailMaxSeconds->value();
 
     /* table */
     fontSize = ui->spinBoxFontSize->value();
@@ -485,6 +497,10 @@ void SettingsDialog::writeSettings(QMainWindow *mainwindow)
     settings->setValue("startup/loggingOnlyMode",loggingOnlyMode);
     settings->setValue("startup/maxFileSizeMB",maxFileSizeMB);
     settings->setValue("startup/appendDateTime",appendDateTime);
+    settings->setValue("startup/compressRecording",compressRecording);
+    settings->setValue("startup/tailMode",tailMode);
+    settings->setValue("startup/tailMaxMessages",tailMaxMessages);
+    settings->setValue("startup/tailMaxSeconds",tailMaxSeconds);
 
     /* table */
     settings->setValue("startup/fontSize",fontSize);
@@ -557,6 +573,10 @@ void SettingsDialog::readSettings()
     loggingOnlyMode = settings->value("startup/loggingOnlyMode",0).toInt();
     maxFileSizeMB = settings->value("startup/maxFileSizeMB",0).toInt();
     appendDateTime = settings->value("startup/appendDateTime",0).toInt();
+    compressRecording = settings->value("startup/compressRecording",0).toInt();
+    tailMode = settings->value("startup/tailMode",0).toInt();
+    tailMaxMessages = settings->value("startup/tailMaxMessages",QDLT_MSG_RING_DEFAULT_SIZE).toInt();
+    tailMaxSeconds = settings->value("startup/tailMaxSeconds",0).toInt();
 
     /* project table */
     fontSize = settings->value("startup/fontSize",8).toInt();
@@ -71,6 +71,10 @@ public:
     int loggingOnlyMode;
     int maxFileSizeMB;
     int appendDateTime;
+    int compressRecording;
+    int tailMode;
+    int tailMaxMessages;
+    int tailMaxSeconds;
 
     int fontSize;
     int showIndex;
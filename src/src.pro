@@ -111,6 +111,7 @@ SOURCES += main.cpp \
     dltfileindexer.cpp \
     dlttableview.cpp \
     dltexporter.cpp \
+    dltexporterthread.cpp \
     fieldnames.cpp \
     dltuiutils.cpp \
     workingdirectory.cpp \
@@ -121,7 +122,12 @@ SOURCES += main.cpp \
     exporterdialog.cpp \
     dltmsgqueue.cpp \
     dltfileindexerthread.cpp \
-    dltfileindexerdefaultfilterthread.cpp
+    dltfileindexerdefaultfilterthread.cpp \
+    dltliveindexer.cpp \
+    dltindexcachewriter.cpp \
+    diagnosticsdialog.cpp \
+    profiledialog.cpp \
+    dltviewerpluginworker.cpp
 
 # Show these headers in the project
 HEADERS += mainwindow.h \
@@ -144,6 +150,7 @@ HEADERS += mainwindow.h \
     dltfileindexer.h \
     dlttableview.h \
     dltexporter.h \
+    dltexporterthread.h \
     fieldnames.h \
     workingdirectory.h \
     dltuiutils.h \
@@ -154,7 +161,12 @@ HEADERS += mainwindow.h \
     exporterdialog.h \
     dltmsgqueue.h \
     dltfileindexerthread.h \
-    dltfileindexerdefaultfilterthread.h
+    dltfileindexerdefaultfilterthread.h \
+    dltliveindexer.h \
+    dltindexcachewriter.h \
+    diagnosticsdialog.h \
+    profiledialog.h \
+    dltviewerpluginworker.h
 
 # Compile these UI files
 FORMS += mainwindow.ui \
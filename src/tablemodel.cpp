@@ -66,7 +66,13 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
      lastSearchIndex = -1;
      emptyForceFlag = false;
      loggingOnlyMode = false;
+     publishedRows = 0;
+     tailRing = NULL;
+     publishedFirst = 0;
      lastrow = -1;
+
+     connect(DltSettingsManager::getInstance(), SIGNAL(snapshotChanged(const DltSettingsSnapshot*)),
+             this, SLOT(settingsSnapshotChanged()));
  }
 
  TableModel::~TableModel()
@@ -101,7 +107,22 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
          return QVariant();
      }
 
-     filterposindex = qfile->getMsgFilterPos(index.row());
+     if(NULL != tailRing)
+     {
+         /* in tail mode the index is the sequence number of the received message */
+         filterposindex = publishedFirst + index.row();
+         const QDltMsg *tailMsg = tailRing->getMsg(filterposindex);
+         if(NULL == tailMsg)
+         {
+             return QVariant();
+         }
+         msg = *tailMsg;
+         lastrow = -1;
+     }
+     else
+     {
+         filterposindex = qfile->getMsgFilterPos(index.row());
+     }
 
      if (role == Qt::DisplayRole)
      {
@@ -110,7 +131,7 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
          {
              msg = QDltMsg();
          }
-         else
+         else if(NULL == tailRing)
          {
            getmessage( index.row(), filterposindex, &decodeflag, &msg, &lastmsg, qfile, &success);
 
@@ -128,13 +149,14 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
           }
          }
 
-         if((DltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool()))
+         /* messages of the ring are decoded already */
+         if((NULL == tailRing) && (DltSettingsManager::getInstance()->snapshot()->pluginsEnabled))
          {
              if ( decodeflag == 1 )
               {
                decodeflag = 0;
                last_decoded_msg = msg;
-               pluginManager->decodeMsg(msg,!OptManager::getInstance()->issilentMode());
+               pluginManager->decodeMsgCached(msg,filterposindex,!OptManager::getInstance()->issilentMode());
                last_decoded_msg = msg;
               }
               else
@@ -148,7 +170,7 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
          {
          case FieldNames::Index:
              /* display index */
-             return QString("%L1").arg(qfile->getMsgFilterPos(index.row()));
+             return QString("%L1").arg(filterposindex);
          case FieldNames::Time:
              if( project->settings->automaticTimeSettings == 0 )
                 return QString("%1.%2").arg(msg.getGmTimeWithOffsetString(project->settings->utcOffset,project->settings->dst)).arg(msg.getMicroseconds(),6,10,QLatin1Char('0'));
@@ -267,10 +289,11 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
 
      if ( role == Qt::ForegroundRole )
      {
-         getmessage( index.row(), filterposindex, &decodeflag, &msg, &lastmsg, qfile, &success); // version2
+         if(NULL == tailRing)
+             getmessage( index.row(), filterposindex, &decodeflag, &msg, &lastmsg, qfile, &success); // version2
 
          // Color the last search row
-         if(lastSearchIndex != -1 && filterposindex == qfile->getMsgFilterPos(lastSearchIndex))
+         if(NULL == tailRing && lastSearchIndex != -1 && filterposindex == qfile->getMsgFilterPos(lastSearchIndex))
          {
              return QVariant(QBrush(DltUiUtils::optimalTextColor(searchBackgroundColor())));
          }
@@ -291,15 +314,16 @@ TableModel::TableModel(const QString & /*data*/, QObject *parent)
 
      if ( role == Qt::BackgroundRole )
      {
-         getmessage( index.row(), filterposindex, &decodeflag, &msg, &lastmsg, qfile, &success); // version2
+         if(NULL == tailRing)
+             getmessage( index.row(), filterposindex, &decodeflag, &msg, &lastmsg, qfile, &success); // version2
 
-         if((DltSettingsManager::getInstance()->value("startup/pluginsEnabled", true).toBool()))
+         if((NULL == tailRing) && (DltSettingsManager::getInstance()->snapshot()->pluginsEnabled))
          {
              if ( decodeflag == 1 )
               {
                decodeflag = 0;
                last_decoded_msg = msg;
-               pluginManager->decodeMsg(msg,!OptManager::getInstance()->issilentMode());
+               pluginManager->decodeMsgCached(msg,filterposindex,!OptManager::getInstance()->issilentMode());
                last_decoded_msg = msg;
               }
               else
@@ -415,7 +439,7 @@ QVariant TableModel::headerData(int section, Qt::Orientation orientation,
      else if(true == loggingOnlyMode)
          return 1;
      else
-         return qfile->sizeFilter();
+         return publishedRows;
  }
 
  void TableModel::modelChanged()
@@ -433,15 +457,91 @@ QVariant TableModel::headerData(int section, Qt::Orientation orientation,
          index(0, columnCount() - 1);
      }
      lastrow = -1;
+     if(NULL != tailRing)
+     {
+         publishedFirst = tailRing->firstSequence();
+         publishedRows = tailRing->size();
+     }
+     else
+     {
+         publishedRows = qfile->sizeFilter();
+     }
      emit(layoutChanged());
  }
 
+ bool TableModel::modelRowsAppended()
+ {
+     if(true == emptyForceFlag || true == loggingOnlyMode)
+         return false;
+
+     if(NULL != tailRing)
+         return tailRowsChanged();
+
+     int rows = qfile->sizeFilter();
+
+     if(rows < publishedRows)
+     {
+         /* filter index was rebuilt */
+         modelChanged();
+         return true;
+     }
+
+     if(rows == publishedRows)
+         return false;
+
+     beginInsertRows(QModelIndex(), publishedRows, rows - 1);
+     publishedRows = rows;
+     endInsertRows();
+
+     return true;
+ }
+
+ bool TableModel::tailRowsChanged()
+ {
+     qint64 first = tailRing->firstSequence();
+     qint64 end = tailRing->endSequence();
+     bool changed = false;
+
+     if(first > publishedFirst)
+     {
+         int removed = (int)qMin(first - publishedFirst, (qint64)publishedRows);
+         if(removed > 0)
+         {
+             beginRemoveRows(QModelIndex(), 0, removed - 1);
+             publishedRows -= removed;
+             publishedFirst = first;
+             endRemoveRows();
+             changed = true;
+         }
+         publishedFirst = first;
+     }
+
+     if(end > publishedFirst + publishedRows)
+     {
+         beginInsertRows(QModelIndex(), publishedRows, (int)(end - publishedFirst) - 1);
+         publishedRows = (int)(end - publishedFirst);
+         endInsertRows();
+         changed = true;
+     }
+
+     return changed;
+ }
+
+
+void TableModel::settingsSnapshotChanged()
+{
+    /* the cached decoded message and the shown rows depend on the settings */
+    lastrow = -1;
+
+    if(publishedRows > 0)
+    {
+        emit dataChanged(index(0, 0), index(publishedRows - 1, columnCount() - 1));
+    }
+}
 
 QColor TableModel::searchBackgroundColor() const
 {
-    QString color = DltSettingsManager::getInstance()->value("other/searchResultColor", QString("#00AAFF")).toString();
-    QColor hlColor(color);
-    return hlColor;
+    return DltSettingsManager::getInstance()->snapshot()->searchResultColor;
 }
 
 void HtmlDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
@@ -56,15 +56,41 @@ public:
     QDltPluginManager *pluginManager;
     void modelChanged();
 
+    /* publish only the rows appended to the filter index since the last update,
+     * falls back to modelChanged() if rows were removed, returns true if rows were added */
+    bool modelRowsAppended();
+
     void setForceEmpty(bool emptyForceFlag) { this->emptyForceFlag = emptyForceFlag; }
     void setLoggingOnlyMode(bool loggingOnlyMode) { this->loggingOnlyMode = loggingOnlyMode; }
 
+    /* in tail mode the rows are the messages of the ring instead of the log file, zero disables tail mode */
+    void setTailRing(QDltMsgRing *tailRing) { this->tailRing = tailRing; }
+    bool isTailMode() const { return tailRing != NULL; }
+
+    /* sequence number of the message of the ring shown in a row in tail mode */
+    qint64 getTailSequence(int row) const { return publishedFirst + row; }
+
     void setLastSearchIndex(int idx) {this->lastSearchIndex = idx;}
+
+private slots:
+    /* invalidate the decoded message cache and redraw the rows after a settings change */
+    void settingsSnapshotChanged();
+
 private:
     int lastSearchIndex;
     bool emptyForceFlag;
     bool loggingOnlyMode;
 
+    /* number of rows the views were informed about */
+    int publishedRows;
+
+    /* ring shown in tail mode and sequence number of the message in the first published row */
+    QDltMsgRing *tailRing;
+    qint64 publishedFirst;
+
+    /* update the published rows of the ring, messages removed from the ring are removed from the view */
+    bool tailRowsChanged();
+
     QColor searchBackgroundColor() const;
 };
 